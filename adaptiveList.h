@@ -0,0 +1,533 @@
+/***********************************************************************
+ * Header:
+ *    ADAPTIVE LIST
+ * Summary:
+ *    A list that is a vector until it needs to be a list.  Most lists
+ *    are appended to and read front to back for most of their lives,
+ *    and a contiguous buffer does both faster than nodes do.  So the
+ *    items start out in a std::vector, and only the first change that
+ *    a vector does badly (anything but adding or removing at the back)
+ *    moves them into a custom::list.  compact() moves them back.
+ *
+ *    While contiguous, data() is the buffer and for_each() is a plain
+ *    loop over it.
+ *
+ *    Iterators are not as stable as custom::list's.  Moving between
+ *    the two representations invalidates every iterator.  While
+ *    contiguous, the rules are std::vector's: push_back() and insert()
+ *    at the end can reallocate the buffer, which invalidates every
+ *    iterator, pointer and reference into it, and erasing the last
+ *    item invalidates iterators to it and to end().  Once linked, the
+ *    rules are custom::list's.
+ *
+ *    This will contain the class definition of:
+ *        adaptive_list           : The list
+ *        adaptive_list::iterator : Walks either representation
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for assert
+#include <initializer_list>
+#include <utility>     // for std::move
+#include <vector>      // for std::vector
+#include "list.h"      // for custom::list
+
+class TestAdaptiveList; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * ADAPTIVE LIST
+     * custom::list's interface, contiguous while it can
+     * be.  Iterators follow std::vector's rules while it is
+     **************************************************/
+    template <typename T>
+    class adaptive_list
+    {
+        friend class ::TestAdaptiveList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        adaptive_list() : linked(false) {}
+        adaptive_list(adaptive_list& rhs);
+        adaptive_list(adaptive_list&& rhs);
+        adaptive_list(size_t num, const T& t) : buffer(num, t), linked(false) {}
+        adaptive_list(size_t num) : buffer(num), linked(false) {}
+        adaptive_list(const std::initializer_list<T>& il) : buffer(il), linked(false) {}
+        template <class Iterator>
+        adaptive_list(Iterator first, Iterator last) : buffer(first, last), linked(false) {}
+
+        //
+        // Assign
+        //
+
+        adaptive_list& operator = (adaptive_list& rhs);
+        adaptive_list& operator = (adaptive_list&& rhs);
+        adaptive_list& operator = (const std::initializer_list<T>& il);
+        void swap(adaptive_list& rhs);
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin();
+        iterator rbegin();
+        iterator end();
+
+        //
+        // Access
+        //
+
+        T& front();
+        T& back();
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_front(T&& data);
+        void push_back(const T& data);
+        void push_back(T&& data);
+        iterator insert(iterator it, const T& data);
+        iterator insert(iterator it, T&& data);
+
+        //
+        // Remove
+        //
+
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator erase(const iterator& it);
+
+        //
+        // Traverse
+        //
+
+        template <class Function>
+        void for_each(Function f);
+
+        //
+        // Layout
+        //
+
+        void compact();
+        bool is_contiguous() const { return !linked; }
+        T* data() { return linked ? nullptr : buffer.data(); }
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return linked ? nodes.size() : buffer.size(); }
+
+    private:
+        typename list <T> ::iterator toLinked(size_t index);
+
+        // member variables
+        std::vector<T> buffer;   // the items, while contiguous
+        list <T> nodes;          // the items, once linked
+        bool linked;             // which of the two holds them
+    };
+
+    /*************************************************
+     * ADAPTIVE LIST ITERATOR
+     * A pointer into the buffer while contiguous, else
+     * a list iterator and a null pointer
+     ************************************************/
+    template <typename T>
+    class adaptive_list <T> ::iterator
+    {
+        friend class ::TestAdaptiveList; // give unit tests access to the privates
+        friend class adaptive_list <T>;
+    public:
+        iterator() : p(nullptr) {}
+
+        bool operator == (const iterator& rhs) const { return p == rhs.p && it == rhs.it; }
+        bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+        T& operator * ()
+        {
+            return p ? *p : *it;
+        }
+
+        iterator& operator ++ ()
+        {
+            if (p)
+                ++p;
+            else
+                ++it;
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        iterator& operator -- ()
+        {
+            if (p)
+                --p;
+            else
+                --it;
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        iterator(T* p) : p(p) {}
+        iterator(typename list <T> ::iterator it) : p(nullptr), it(it) {}
+
+        T* p;
+        typename list <T> ::iterator it;
+    };
+
+    /*****************************************
+     * ADAPTIVE LIST :: COPY and MOVE constructors
+     * A copy is always contiguous
+     ****************************************/
+    template <typename T>
+    adaptive_list <T> ::adaptive_list(adaptive_list& rhs) : linked(false)
+    {
+        buffer.reserve(rhs.size());
+        for (iterator it = rhs.begin(); it != rhs.end(); ++it)
+            buffer.push_back(*it);
+    }
+
+    template <typename T>
+    adaptive_list <T> ::adaptive_list(adaptive_list&& rhs) :
+        buffer(std::move(rhs.buffer)), nodes(std::move(rhs.nodes)), linked(rhs.linked)
+    {
+        rhs.buffer.clear();
+        rhs.linked = false;
+    }
+
+    /**********************************************
+     * ADAPTIVE LIST :: assignment operators
+     *     INPUT  : a list to be copied or moved, or the items
+     *     OUTPUT :
+     *     COST   : O(n)
+     *********************************************/
+    template <typename T>
+    adaptive_list <T>& adaptive_list <T> ::operator = (adaptive_list& rhs)
+    {
+        if (this != &rhs)
+        {
+            adaptive_list copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    adaptive_list <T>& adaptive_list <T> ::operator = (adaptive_list&& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    adaptive_list <T>& adaptive_list <T> ::operator = (const std::initializer_list<T>& il)
+    {
+        adaptive_list copy(il);
+        swap(copy);
+        return *this;
+    }
+
+    /**********************************************
+     * ADAPTIVE LIST :: SWAP
+     *     INPUT  : the list to swap with
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::swap(adaptive_list& rhs)
+    {
+        buffer.swap(rhs.buffer);
+        nodes.swap(rhs.nodes);
+        std::swap(linked, rhs.linked);
+    }
+
+    template <typename T>
+    void swap(adaptive_list <T>& lhs, adaptive_list <T>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /**********************************************
+     * ADAPTIVE LIST :: BEGIN, RBEGIN, END
+     *     INPUT  :
+     *     OUTPUT : the first item, the last, or past the last
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::begin()
+    {
+        return linked ? iterator(nodes.begin()) : iterator(buffer.data());
+    }
+
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::rbegin()
+    {
+        if (linked)
+            return iterator(nodes.rbegin());
+        return buffer.empty() ? end() : iterator(buffer.data() + buffer.size() - 1);
+    }
+
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::end()
+    {
+        return linked ? iterator(nodes.end()) : iterator(buffer.data() + buffer.size());
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: FRONT and BACK
+     *     INPUT  :
+     *     OUTPUT : the first or last item
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    T& adaptive_list <T> ::front()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return linked ? nodes.front() : buffer.front();
+    }
+
+    template <typename T>
+    T& adaptive_list <T> ::back()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return linked ? nodes.back() : buffer.back();
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: TO LINKED
+     * Move every item out of the buffer into nodes
+     *    INPUT  : the position of interest
+     *    OUTPUT : the node now at that position, or end()
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    typename list <T> ::iterator adaptive_list <T> ::toLinked(size_t index)
+    {
+        assert(!linked);
+        typename list <T> ::iterator itAt = nodes.end();
+        for (size_t i = 0; i < buffer.size(); i++)
+        {
+            nodes.push_back(std::move(buffer[i]));
+            if (i == index)
+                itAt = nodes.rbegin();
+        }
+        std::vector<T>().swap(buffer);
+        linked = true;
+        return itAt;
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: COMPACT
+     * Move every item back into one buffer, in order
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::compact()
+    {
+        if (!linked)
+            return;
+        buffer.reserve(nodes.size());
+        for (typename list <T> ::iterator it = nodes.begin(); it != nodes.end(); ++it)
+            buffer.push_back(std::move(*it));
+        nodes.clear();
+        linked = false;
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: PUSH BACK
+     * Add an item to the end, which a buffer does well.
+     * While contiguous this may reallocate the buffer and
+     * invalidate every iterator, as std::vector would
+     *    INPUT  : the item
+     *    OUTPUT :
+     *    COST   : O(1), amortized while contiguous
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::push_back(const T& data)
+    {
+        if (linked)
+            nodes.push_back(data);
+        else
+            buffer.push_back(data);
+    }
+
+    template <typename T>
+    void adaptive_list <T> ::push_back(T&& data)
+    {
+        if (linked)
+            nodes.push_back(std::move(data));
+        else
+            buffer.push_back(std::move(data));
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: PUSH FRONT
+     * Add an item to the front.  Unless the list is
+     * empty, that makes it linked
+     *    INPUT  : the item
+     *    OUTPUT :
+     *    COST   : O(1), O(n) the first time
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::push_front(const T& data)
+    {
+        insert(begin(), data);
+    }
+
+    template <typename T>
+    void adaptive_list <T> ::push_front(T&& data)
+    {
+        insert(begin(), std::move(data));
+    }
+
+    /******************************************
+     * ADAPTIVE LIST :: INSERT
+     * Add an item before it.  At the end, the buffer
+     * takes it; anywhere else the list becomes linked.
+     * Either way every iterator into the buffer may be
+     * invalidated, as with std::vector; only the one
+     * returned is good
+     *     INPUT  : where, and the item
+     *     OUTPUT : an iterator to the new item
+     *     COST   : O(1), O(n) the first time
+     ******************************************/
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::insert(iterator it, const T& data)
+    {
+        T copy(data);
+        return insert(it, std::move(copy));
+    }
+
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::insert(iterator it, T&& data)
+    {
+        if (!linked)
+        {
+            size_t index = it.p - buffer.data();
+            if (index == buffer.size())
+            {
+                buffer.push_back(std::move(data));
+                return iterator(buffer.data() + index);
+            }
+            it = iterator(toLinked(index));
+        }
+        return iterator(nodes.insert(it.it, std::move(data)));
+    }
+
+    /******************************************
+     * ADAPTIVE LIST :: ERASE
+     * Remove an item.  The last item comes off the
+     * buffer; any other makes the list linked
+     *     INPUT  : the item to remove
+     *     OUTPUT : an iterator to the item after it
+     *     COST   : O(1), O(n) the first time
+     ******************************************/
+    template <typename T>
+    typename adaptive_list <T> ::iterator adaptive_list <T> ::erase(const iterator& it)
+    {
+        if (it == end())
+            return end();
+        if (!linked)
+        {
+            size_t index = it.p - buffer.data();
+            if (index + 1 == buffer.size())
+            {
+                buffer.pop_back();
+                return end();
+            }
+            return iterator(nodes.erase(toLinked(index)));
+        }
+        return iterator(nodes.erase(it.it));
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: POP BACK and POP FRONT
+     * Remove the last or first item, if there is one
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1), pop_front() is O(n) the first time
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::pop_back()
+    {
+        if (linked)
+            nodes.pop_back();
+        else if (!buffer.empty())
+            buffer.pop_back();
+    }
+
+    template <typename T>
+    void adaptive_list <T> ::pop_front()
+    {
+        if (!empty())
+            erase(begin());
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: CLEAR
+     * Remove every item.  An empty list is contiguous
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void adaptive_list <T> ::clear()
+    {
+        buffer.clear();
+        nodes.clear();
+        linked = false;
+    }
+
+    /*********************************************
+     * ADAPTIVE LIST :: FOR EACH
+     * Call f on every item, front to back.  While
+     * contiguous this is a loop over an array
+     *    INPUT  : what to call on each item
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Function>
+    void adaptive_list <T> ::for_each(Function f)
+    {
+        if (linked)
+        {
+            nodes.for_each(f);
+            return;
+        }
+        T* p = buffer.data();
+        for (size_t i = 0, num = buffer.size(); i < num; i++)
+            f(p[i]);
+    }
+
+}; // namespace custom
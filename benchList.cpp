@@ -0,0 +1,561 @@
+/***********************************************************************
+ * Header:
+ *    Bench
+ * Summary:
+ *    Timing harness for the containers built on list.h.  This is its
+ *    own program, apart from the unit tests: build it with optimization
+ *    on, and run it on an otherwise idle machine.  The numbers are wall
+ *    clock time and vary from run to run, so nothing here passes or
+ *    fails.
+ *
+ *        benchList            run everything
+ *        benchList <name>     run one: mpsc, concurrent, sorted,
+ *                             sharded, channel, prefetch, arena
+ *
+ *    Where Linux lets us open a perf counter, the arena benchmark also
+ *    reports dTLB load misses.  Elsewhere it says so and reports time
+ *    alone.
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#include "list.h"
+#include "mpscQueue.h"
+#include "concurrentList.h"
+#include "concurrentSortedList.h"
+#include "shardedList.h"
+#include "parallelList.h"
+#include "channel.h"
+
+#include <algorithm>   // for std::shuffle
+#include <atomic>      // for std::atomic
+#include <chrono>      // for std::chrono::steady_clock
+#include <cstdint>     // for uint32_t
+#include <cstdio>      // for printf
+#include <cstring>     // for strcmp
+#include <mutex>       // for std::mutex
+#include <numeric>     // for std::iota
+#include <random>      // for std::mt19937
+#include <thread>      // for std::thread
+#include <vector>      // for std::vector
+#if defined(__linux__)
+#include <linux/perf_event.h>  // for perf_event_attr
+#include <sys/ioctl.h>         // for ioctl
+#include <sys/syscall.h>       // for SYS_perf_event_open
+#include <unistd.h>            // for syscall, read, close
+#endif
+
+/**********************************************************************
+ * TIMING
+ * Milliseconds taken by f(), and the same for f() run on
+ * numThreads threads at once.  The threads are all started
+ * before the clock is, so their creation is not counted
+ ***********************************************************************/
+template <class Function>
+double timeMs(Function f)
+{
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   f();
+   std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+   return elapsed.count();
+}
+
+template <class Function>
+double timeThreads(size_t numThreads, Function f)
+{
+   std::atomic<bool> go(false);
+   std::vector<std::thread> threads;
+   for (size_t t = 0; t < numThreads; t++)
+      threads.push_back(std::thread([&go, &f, t]()
+      {
+         while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+         f(t);
+      }));
+   return timeMs([&go, &threads]()
+   {
+      go.store(true, std::memory_order_release);
+      for (size_t t = 0; t < threads.size(); t++)
+         threads[t].join();
+   });
+}
+
+// millions of operations a second
+static double mops(size_t numOps, double ms)
+{
+   return ms > 0.0 ? numOps / ms / 1000.0 : 0.0;
+}
+
+// a cheap random number, one stream per thread
+static uint32_t xorshift(uint32_t& state)
+{
+   state ^= state << 13;
+   state ^= state >> 17;
+   state ^= state << 5;
+   return state;
+}
+
+/**********************************************************************
+ * DTLB COUNTER
+ * Counts dTLB load misses in this thread, where the kernel
+ * lets us.  stop() returns -1 when it does not
+ ***********************************************************************/
+class DtlbCounter
+{
+public:
+   DtlbCounter() : fd(-1)
+   {
+#if defined(__linux__)
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+   }
+   ~DtlbCounter()
+   {
+#if defined(__linux__)
+      if (fd >= 0)
+         close(fd);
+#endif
+   }
+
+   bool available() const { return fd >= 0; }
+
+   void start()
+   {
+#if defined(__linux__)
+      if (fd >= 0)
+      {
+         ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   long long stop()
+   {
+      long long num = -1;
+#if defined(__linux__)
+      if (fd >= 0)
+      {
+         ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+         if (read(fd, &num, sizeof(num)) != (ssize_t)sizeof(num))
+            num = -1;
+      }
+#endif
+      return num;
+   }
+
+private:
+   int fd;
+};
+
+/**********************************************************************
+ * SHUFFLED
+ * A list of 0..num-1 whose nodes were made in one order and
+ * linked in another, so every step of a walk lands somewhere
+ * unexpected.  Each node starts in a list of its own and is
+ * spliced onto the end, so nothing is copied
+ ***********************************************************************/
+static void shuffled(custom::list<long>& l, size_t num)
+{
+   std::vector<size_t> order(num);
+   std::iota(order.begin(), order.end(), 0);
+   std::shuffle(order.begin(), order.end(), std::mt19937(26));
+
+   std::vector<custom::list<long>> singles(num);
+   for (size_t i = 0; i < num; i++)
+      singles[i].push_back((long)i);
+   for (size_t i = 0; i < num; i++)
+      l.splice(l.end(), singles[order[i]]);
+}
+
+/**********************************************************************
+ * MPSC
+ * Many producers, one consumer: the lock-free queue with
+ * drain_into() against a mutex around push_back and pop_front
+ ***********************************************************************/
+static void benchMpsc()
+{
+   const size_t numItems = 1 << 21;
+   printf("mpsc: %zu items, one consumer (Mitems/s)\n", numItems);
+   printf("   %-10s %12s %12s\n", "producers", "mpsc_queue", "mutex+list");
+   for (size_t numProducers = 1; numProducers <= 16; numProducers *= 2)
+   {
+      size_t perProducer = numItems / numProducers;
+      size_t total = perProducer * numProducers;
+
+      custom::mpsc_queue<int> q;
+      double msQueue = timeThreads(numProducers + 1, [&](size_t t)
+      {
+         if (t == numProducers)
+         {
+            custom::list<int> l;
+            size_t num = 0;
+            while (num < total)
+            {
+               num += q.drain_into(l);
+               l.clear();
+            }
+         }
+         else
+            for (size_t i = 0; i < perProducer; i++)
+               q.push((int)i);
+      });
+
+      std::mutex m;
+      custom::list<int> shared;
+      double msMutex = timeThreads(numProducers + 1, [&](size_t t)
+      {
+         if (t == numProducers)
+         {
+            size_t num = 0;
+            while (num < total)
+            {
+               std::lock_guard<std::mutex> lock(m);
+               while (!shared.empty())
+               {
+                  shared.pop_front();
+                  num++;
+               }
+            }
+         }
+         else
+            for (size_t i = 0; i < perProducer; i++)
+            {
+               std::lock_guard<std::mutex> lock(m);
+               shared.push_back((int)i);
+            }
+      });
+
+      printf("   %-10zu %12.1f %12.1f\n", numProducers, mops(total, msQueue), mops(total, msMutex));
+   }
+}
+
+/**********************************************************************
+ * CONCURRENT
+ * Threads inserting and erasing in regions of their own: a
+ * lock per node against one lock for the whole list.  Each
+ * thread walks from the front to its region, so the walk
+ * through the regions before it is shared traffic
+ ***********************************************************************/
+static void benchConcurrent()
+{
+   const size_t regionSize = 16;
+   const size_t maxThreads = 32;
+   const size_t numRounds = 2000;
+   printf("concurrent: insert then erase %zu times per thread, %zu-item regions (Mops/s)\n",
+          numRounds, regionSize);
+   printf("   %-10s %16s %12s\n", "threads", "concurrent_list", "mutex+list");
+   for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+   {
+      custom::concurrent_list<int> cl;
+      for (size_t i = 0; i < maxThreads * regionSize; i++)
+         cl.push_back((int)i);
+      double msFine = timeThreads(numThreads, [&cl, regionSize, numRounds](size_t t)
+      {
+         for (size_t r = 0; r < numRounds; r++)
+         {
+            custom::concurrent_list<int>::iterator it = cl.begin();
+            for (size_t i = 0; i < t * regionSize + r % regionSize; i++)
+               ++it;
+            cl.insert(it, -1);
+            cl.erase(it);
+         }
+      });
+
+      std::mutex m;
+      custom::list<int> l;
+      for (size_t i = 0; i < maxThreads * regionSize; i++)
+         l.push_back((int)i);
+      double msMutex = timeThreads(numThreads, [&m, &l, regionSize, numRounds](size_t t)
+      {
+         for (size_t r = 0; r < numRounds; r++)
+         {
+            std::lock_guard<std::mutex> lock(m);
+            custom::list<int>::iterator it = l.begin();
+            for (size_t i = 0; i < t * regionSize + r % regionSize; i++)
+               ++it;
+            l.erase(l.insert(it, -1));
+         }
+      });
+
+      size_t numOps = 2 * numRounds * numThreads;
+      printf("   %-10zu %16.2f %12.2f\n", numThreads, mops(numOps, msFine), mops(numOps, msMutex));
+   }
+}
+
+/**********************************************************************
+ * SORTED
+ * A set of small keys under a mix of 90% contains, 5% insert
+ * and 5% erase: the lock-free list against a mutex around a
+ * sorted custom::list
+ ***********************************************************************/
+static void benchSorted()
+{
+   const uint32_t numKeys = 512;
+   const size_t numOps = 200000;
+   printf("sorted: %u keys, %zu ops per thread, 90/5/5 contains/insert/erase (Mops/s)\n",
+          numKeys, numOps);
+   printf("   %-10s %22s %12s\n", "threads", "concurrent_sorted_list", "mutex+list");
+   for (size_t numThreads = 1; numThreads <= 8; numThreads *= 2)
+   {
+      custom::epoch_domain domain;
+      double msLockFree;
+      {
+         custom::concurrent_sorted_list<uint32_t> set(domain);
+         for (uint32_t k = 0; k < numKeys; k += 2)
+            set.insert(k);
+         msLockFree = timeThreads(numThreads, [&set, numKeys, numOps](size_t t)
+         {
+            uint32_t state = 2463534242u + (uint32_t)t;
+            for (size_t i = 0; i < numOps; i++)
+            {
+               uint32_t r = xorshift(state);
+               uint32_t key = r % numKeys;
+               uint32_t op = (r >> 16) % 20;
+               if (op == 0)
+                  set.insert(key);
+               else if (op == 1)
+                  set.erase(key);
+               else
+                  set.contains(key);
+            }
+         });
+      }
+
+      std::mutex m;
+      custom::list<uint32_t> l;
+      for (uint32_t k = 0; k < numKeys; k += 2)
+         l.push_back(k);
+      double msMutex = timeThreads(numThreads, [&m, &l, numKeys, numOps](size_t t)
+      {
+         uint32_t state = 2463534242u + (uint32_t)t;
+         for (size_t i = 0; i < numOps; i++)
+         {
+            uint32_t r = xorshift(state);
+            uint32_t key = r % numKeys;
+            uint32_t op = (r >> 16) % 20;
+            std::lock_guard<std::mutex> lock(m);
+            custom::list<uint32_t>::iterator it = l.begin();
+            while (it != l.end() && *it < key)
+               ++it;
+            bool found = it != l.end() && *it == key;
+            if (op == 0 && !found)
+               l.insert(it, key);
+            else if (op == 1 && found)
+               l.erase(it);
+         }
+      });
+
+      size_t total = numOps * numThreads;
+      printf("   %-10zu %22.2f %12.2f\n", numThreads, mops(total, msLockFree), mops(total, msMutex));
+   }
+}
+
+/**********************************************************************
+ * SHARDED
+ * Every thread appending: a shard per thread against one
+ * mutex and one tail.  Then the cost of collect()
+ ***********************************************************************/
+static void benchSharded()
+{
+   const size_t perThread = 200000;
+   printf("sharded: %zu push_backs per thread (Mitems/s)\n", perThread);
+   printf("   %-10s %12s %12s %14s\n", "threads", "sharded_list", "mutex+list", "collect (us)");
+   for (size_t numThreads = 1; numThreads <= 32; numThreads *= 2)
+   {
+      custom::sharded_list<int> sl(numThreads);
+      double msSharded = timeThreads(numThreads, [&sl, perThread](size_t t)
+      {
+         for (size_t i = 0; i < perThread; i++)
+            sl.push_back_to(t, (int)i);
+      });
+      custom::list<int> all;
+      double msCollect = timeMs([&sl, &all]() { all = sl.collect(); });
+
+      std::mutex m;
+      custom::list<int> l;
+      double msMutex = timeThreads(numThreads, [&m, &l, perThread](size_t)
+      {
+         for (size_t i = 0; i < perThread; i++)
+         {
+            std::lock_guard<std::mutex> lock(m);
+            l.push_back((int)i);
+         }
+      });
+
+      size_t total = perThread * numThreads;
+      printf("   %-10zu %12.1f %12.1f %14.1f\n", numThreads,
+             mops(total, msSharded), mops(total, msMutex), msCollect * 1000.0);
+   }
+}
+
+/**********************************************************************
+ * CHANNEL
+ * Handing items between two coroutines on one thread.  With
+ * no capacity every item is a handoff from a parked pusher to
+ * a popper; with some, items wait in the channel's list
+ ***********************************************************************/
+#ifdef __cpp_impl_coroutine
+static custom::detached_task producer(custom::executor& ex, custom::channel<int>& ch, int num)
+{
+   co_await ex.schedule();
+   for (int i = 0; i < num; i++)
+      co_await ch.push(i);
+   ch.close();
+}
+
+static custom::detached_task consumer(custom::executor& ex, custom::channel<int>& ch, long long& sum)
+{
+   co_await ex.schedule();
+   while (std::optional<int> value = co_await ch.pop())
+      sum += *value;
+}
+
+static void benchChannel()
+{
+   const int numItems = 1000000;
+   printf("channel: %d items between two coroutines, single_thread_executor (ns/item)\n",
+          numItems);
+   printf("   %-10s %12s\n", "capacity", "ns/item");
+   const size_t capacities[] = { 0, 1, 64, 1024 };
+   for (size_t capacity : capacities)
+   {
+      custom::single_thread_executor ex;
+      custom::channel<int> ch(ex, capacity);
+      long long sum = 0;
+      double ms = timeMs([&]()
+      {
+         consumer(ex, ch, sum);
+         producer(ex, ch, numItems);
+         ex.run();
+      });
+      printf("   %-10zu %12.1f\n", capacity, ms * 1000000.0 / numItems);
+   }
+}
+#else
+static void benchChannel()
+{
+   printf("channel: needs C++20 coroutines, skipped\n");
+}
+#endif // __cpp_impl_coroutine
+
+/**********************************************************************
+ * PREFETCH
+ * Walking a shuffled list: list::for_each against scouts
+ * started from checkpoints
+ ***********************************************************************/
+static void benchPrefetch()
+{
+   const size_t numNodes = 1 << 22;
+   printf("prefetch: %zu nodes linked in shuffled order (ms)\n", numNodes);
+   custom::list<long> l;
+   shuffled(l, numNodes);
+
+   long sum = 0;
+   double msPlain = timeMs([&]() { l.for_each([&sum](long& x) { sum += x; }); });
+   printf("   %-28s %10.1f\n", "list::for_each", msPlain);
+
+   const size_t strides[] = { 256, 1024 };
+   const size_t scouts[] = { 4, 8 };
+   for (size_t stride : strides)
+   {
+      double msBuild = timeMs([&]() { custom::list_checkpoints<long> once(l, stride); });
+      custom::list_checkpoints<long> checkpoints(l, stride);
+      for (size_t numScouts : scouts)
+      {
+         double ms = timeMs([&]()
+         {
+            checkpoints.for_each_prefetch([&sum](long& x) { sum += x; }, numScouts);
+         });
+         char name[64];
+         snprintf(name, sizeof(name), "stride %zu, %zu scouts", stride, numScouts);
+         printf("   %-28s %10.1f   (checkpoints built in %.1f)\n", name, ms, msBuild);
+      }
+   }
+   if (sum != (long)(numNodes * (numNodes - 1) / 2) * 5)
+      printf("   (wrong sum)\n");
+}
+
+/**********************************************************************
+ * ARENA
+ * Walking the same shuffled list with its nodes from new,
+ * and with them carved from the huge-page arena
+ ***********************************************************************/
+static void benchArena()
+{
+   const size_t numNodes = 1 << 22;
+   printf("arena: %zu nodes linked in shuffled order (huge pages %savailable)\n",
+          numNodes, custom::huge_pages::available() ? "" : "not ");
+   printf("   %-10s %10s %16s\n", "nodes", "walk (ms)", "dTLB misses");
+   for (int arena = 0; arena < 2; arena++)
+   {
+      custom::node_blocks::use_arena(arena == 1);
+      custom::list<long> l;
+      shuffled(l, numNodes);
+      custom::node_blocks::use_arena(false);
+
+      DtlbCounter counter;
+      long sum = 0;
+      counter.start();
+      double ms = timeMs([&]() { l.for_each([&sum](long& x) { sum += x; }); });
+      long long misses = counter.stop();
+      if (misses >= 0)
+         printf("   %-10s %10.1f %16lld\n", arena ? "arena" : "new", ms, misses);
+      else
+         printf("   %-10s %10.1f %16s\n", arena ? "arena" : "new", ms, "n/a");
+      if (sum != (long)(numNodes * (numNodes - 1) / 2))
+         printf("   (wrong sum)\n");
+   }
+}
+
+/**********************************************************************
+ * MAIN
+ * Run every benchmark, or the one named
+ ***********************************************************************/
+int main(int argc, char** argv)
+{
+   struct Bench
+   {
+      const char* name;
+      void (*run)();
+   };
+   const Bench benches[] =
+   {
+      { "mpsc",       benchMpsc },
+      { "concurrent", benchConcurrent },
+      { "sorted",     benchSorted },
+      { "sharded",    benchSharded },
+      { "channel",    benchChannel },
+      { "prefetch",   benchPrefetch },
+      { "arena",      benchArena },
+   };
+
+   bool found = false;
+   for (const Bench& bench : benches)
+      if (argc < 2 || std::strcmp(argv[1], bench.name) == 0)
+      {
+         bench.run();
+         printf("\n");
+         found = true;
+      }
+
+   if (!found)
+   {
+      printf("usage: %s [name]\n   names:", argv[0]);
+      for (const Bench& bench : benches)
+         printf(" %s", bench.name);
+      printf("\n");
+      return 1;
+   }
+   return 0;
+}
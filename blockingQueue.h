@@ -0,0 +1,460 @@
+/***********************************************************************
+ * Header:
+ *    BLOCKING QUEUE
+ * Summary:
+ *    A bounded, blocking queue for many producers and many consumers,
+ *    using the Michael-Scott two-lock design over custom::list nodes.
+ *    There is always a dummy node at the head, so the head and the tail
+ *    are never the same node while anything is queued.  That lets
+ *    producers hold only the tail lock and consumers only the head lock:
+ *    a push_back and a pop_front never wait on each other.
+ *
+ *    This will contain the class definition of:
+ *        blocking_queue : A thread-safe FIFO with backpressure
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <atomic>              // for std::atomic
+#include <chrono>              // for std::chrono::duration
+#include <condition_variable>  // for std::condition_variable
+#include <limits>              // for std::numeric_limits
+#include <mutex>               // for std::mutex
+#include <utility>
+
+class TestBlockingQueue;       // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * BLOCKING QUEUE
+     * A FIFO that makes producers wait when it is full
+     * and consumers wait when it is empty
+     **************************************************/
+    template <typename T>
+    class blocking_queue
+    {
+        friend class ::TestBlockingQueue; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        blocking_queue(size_t capacity = std::numeric_limits<size_t>::max());
+        blocking_queue(const blocking_queue& rhs) = delete;
+        blocking_queue& operator = (const blocking_queue& rhs) = delete;
+        ~blocking_queue();
+
+        //
+        // Producers
+        //
+
+        void push_back(const T& data);
+        void push_back(T&& data);
+        bool try_push(const T& data);
+        bool try_push(T&& data);
+        template <class Rep, class Period>
+        bool try_push(const T& data, const std::chrono::duration<Rep, Period>& timeout);
+        template <class Rep, class Period>
+        bool try_push(T&& data, const std::chrono::duration<Rep, Period>& timeout);
+
+        //
+        // Consumers
+        //
+
+        T pop_front();
+        bool try_pop(T& data);
+        template <class Rep, class Period>
+        bool try_pop(T& data, const std::chrono::duration<Rep, Period>& timeout);
+        size_t pop_n(list <T>& rhs, size_t num);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return numElements.load(std::memory_order_acquire); }
+        size_t capacity() const { return maxElements; }
+
+    private:
+        typedef typename list <T> ::Node Node;
+
+        // link a node at the tail: caller holds tailLock and there is room
+        void enqueue(Node* pNew);
+        // unlink the first node's data: caller holds headLock and it is not empty
+        T dequeue();
+
+        // a push that timed out hands a moved item back to the caller
+        static void giveBack(const T&, T&) {}
+        static void giveBack(T& data, T& from) { data = std::move(from); }
+
+        // the far side's condition variable needs the far side's lock
+        void signalNotEmpty();
+        void signalNotFull();
+
+        // the shared part of every push and pop.  Return false on a timeout
+        template <class U, class Wait>
+        bool push(U&& data, Wait wait);
+        template <class Wait>
+        bool pop(T& data, Wait wait);
+
+        // member variables
+        const size_t maxElements;             // backpressure threshold
+        std::atomic<size_t> numElements;      // the only thing both sides touch
+
+        alignas(64) std::mutex headLock;      // consumers
+        std::condition_variable notEmpty;     // waited on under headLock
+        Node* pHead;                          // dummy in front of the first item
+
+        alignas(64) std::mutex tailLock;      // producers
+        std::condition_variable notFull;      // waited on under tailLock
+        Node* pTail;                          // last item, or the dummy
+    };
+
+    /*****************************************
+     * BLOCKING QUEUE :: CONSTRUCTOR
+     * Start with the dummy node
+     ****************************************/
+    template <typename T>
+    blocking_queue <T> ::blocking_queue(size_t capacity)
+        : maxElements(capacity ? capacity : 1), numElements(0)
+    {
+        pHead = pTail = new Node();
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: DESTRUCTOR
+     * Nobody may still be waiting
+     ****************************************/
+    template <typename T>
+    blocking_queue <T> ::~blocking_queue()
+    {
+        while (pHead)
+        {
+            Node* pNext = pHead->pNext;
+            delete pHead;
+            pHead = pNext;
+        }
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: SIGNAL
+     * Wake a waiter on the other side.  Taking the other
+     * side's lock first is what keeps the wakeup from
+     * slipping in between its check and its wait
+     ****************************************/
+    template <typename T>
+    void blocking_queue <T> ::signalNotEmpty()
+    {
+        std::lock_guard<std::mutex> lock(headLock);
+        notEmpty.notify_one();
+    }
+
+    template <typename T>
+    void blocking_queue <T> ::signalNotFull()
+    {
+        std::lock_guard<std::mutex> lock(tailLock);
+        notFull.notify_one();
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: ENQUEUE
+     * The count is bumped after the link is made, so a
+     * consumer that sees the count also sees the link
+     ****************************************/
+    template <typename T>
+    void blocking_queue <T> ::enqueue(Node* pNew)
+    {
+        pTail->pNext = pNew;
+        pTail = pNew;
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: DEQUEUE
+     * The first real node becomes the new dummy and the
+     * old dummy goes away
+     ****************************************/
+    template <typename T>
+    T blocking_queue <T> ::dequeue()
+    {
+        Node* pFirst = pHead->pNext;
+        T data(std::move(pFirst->data));
+        delete pHead;
+        pHead = pFirst;
+        return data;
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: PUSH
+     * Wait (as told) for room, link, and wake whoever
+     * needs waking
+     ****************************************/
+    template <typename T>
+    template <class U, class Wait>
+    bool blocking_queue <T> ::push(U&& data, Wait wait)
+    {
+        // allocate before taking the lock to keep the critical section short
+        Node* pNew = new Node(std::forward<U>(data));
+
+        size_t numBefore;
+        {
+            std::unique_lock<std::mutex> lock(tailLock);
+            auto hasRoom = [this]() { return numElements.load(std::memory_order_acquire) < maxElements; };
+            if (!wait(lock, hasRoom))
+            {
+                lock.unlock();
+                giveBack(data, pNew->data);
+                delete pNew;
+                return false;
+            }
+
+            enqueue(pNew);
+            numBefore = numElements.fetch_add(1, std::memory_order_acq_rel);
+            if (numBefore + 1 < maxElements)
+                notFull.notify_one();
+        }
+
+        // went from empty to not: a consumer may be asleep
+        if (numBefore == 0)
+            signalNotEmpty();
+        return true;
+    }
+
+    /*****************************************
+     * BLOCKING QUEUE :: POP
+     * Wait (as told) for an item, take it, and wake
+     * whoever needs waking
+     ****************************************/
+    template <typename T>
+    template <class Wait>
+    bool blocking_queue <T> ::pop(T& data, Wait wait)
+    {
+        size_t numBefore;
+        {
+            std::unique_lock<std::mutex> lock(headLock);
+            auto hasItem = [this]() { return numElements.load(std::memory_order_acquire) > 0; };
+            if (!wait(lock, hasItem))
+                return false;
+
+            data = dequeue();
+            numBefore = numElements.fetch_sub(1, std::memory_order_acq_rel);
+            if (numBefore > 1)
+                notEmpty.notify_one();
+        }
+
+        // went from full to not: a producer may be asleep
+        if (numBefore == maxElements)
+            signalNotFull();
+        return true;
+    }
+
+    /*********************************************
+     * BLOCKING QUEUE :: PUSH BACK
+     * add an item, waiting as long as it takes for room
+     *    INPUT  : data to be added to the queue
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void blocking_queue <T> ::push_back(const T& data)
+    {
+        push(data, [this](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            notFull.wait(lock, ready);
+            return true;
+        });
+    }
+
+    template <typename T>
+    void blocking_queue <T> ::push_back(T&& data)
+    {
+        push(std::move(data), [this](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            notFull.wait(lock, ready);
+            return true;
+        });
+    }
+
+    /*********************************************
+     * BLOCKING QUEUE :: TRY PUSH
+     * add an item only if there is room now, or within
+     * the timeout
+     *    INPUT  : data to be added to the queue
+     *             how long to wait for room
+     *    OUTPUT : false if the queue stayed full
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    bool blocking_queue <T> ::try_push(const T& data)
+    {
+        if (size() >= maxElements)
+            return false;
+        return push(data, [](std::unique_lock<std::mutex>&, auto ready)
+        {
+            return ready();
+        });
+    }
+
+    template <typename T>
+    bool blocking_queue <T> ::try_push(T&& data)
+    {
+        if (size() >= maxElements)
+            return false;
+        return push(std::move(data), [](std::unique_lock<std::mutex>&, auto ready)
+        {
+            return ready();
+        });
+    }
+
+    template <typename T>
+    template <class Rep, class Period>
+    bool blocking_queue <T> ::try_push(const T& data,
+                                       const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return push(data, [this, &timeout](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            return notFull.wait_for(lock, timeout, ready);
+        });
+    }
+
+    template <typename T>
+    template <class Rep, class Period>
+    bool blocking_queue <T> ::try_push(T&& data,
+                                       const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return push(std::move(data), [this, &timeout](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            return notFull.wait_for(lock, timeout, ready);
+        });
+    }
+
+    /*********************************************
+     * BLOCKING QUEUE :: POP FRONT
+     * remove an item, waiting as long as it takes for one
+     *    INPUT  :
+     *    OUTPUT : the item
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    T blocking_queue <T> ::pop_front()
+    {
+        T data;
+        pop(data, [this](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            notEmpty.wait(lock, ready);
+            return true;
+        });
+        return data;
+    }
+
+    /*********************************************
+     * BLOCKING QUEUE :: TRY POP
+     * remove an item only if there is one now, or within
+     * the timeout
+     *    INPUT  : where to put the item
+     *             how long to wait for one
+     *    OUTPUT : false if the queue stayed empty
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    bool blocking_queue <T> ::try_pop(T& data)
+    {
+        if (empty())
+            return false;
+        return pop(data, [](std::unique_lock<std::mutex>&, auto ready)
+        {
+            return ready();
+        });
+    }
+
+    template <typename T>
+    template <class Rep, class Period>
+    bool blocking_queue <T> ::try_pop(T& data, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        return pop(data, [this, &timeout](std::unique_lock<std::mutex>& lock, auto ready)
+        {
+            return notEmpty.wait_for(lock, timeout, ready);
+        });
+    }
+
+    /*********************************************
+     * BLOCKING QUEUE :: POP N
+     * wait for at least one item, then move up to num
+     * of them onto the back of a list under a single
+     * acquisition of the head lock.  The nodes themselves
+     * are handed over; only the last item is moved
+     *    INPUT  : the list to append to, the most to take
+     *    OUTPUT : the number taken
+     *    COST   : O(k) in the number taken
+     *********************************************/
+    template <typename T>
+    size_t blocking_queue <T> ::pop_n(list <T>& rhs, size_t num)
+    {
+        if (num == 0)
+            return 0;
+
+        size_t numTaken;
+        size_t numBefore;
+        {
+            std::unique_lock<std::mutex> lock(headLock);
+            notEmpty.wait(lock, [this]() { return numElements.load(std::memory_order_acquire) > 0; });
+
+            size_t numQueued = numElements.load(std::memory_order_acquire);
+            numTaken = num < numQueued ? num : numQueued;
+
+            // the last node taken has to stay behind as the new dummy, since a
+            // producer may be linking onto it.  Its data moves into the old dummy,
+            // which takes its place at the end of the chain we hand over
+            Node* pFirst = pHead->pNext;
+            Node* pLast = pHead;
+            for (size_t i = 0; i < numTaken; i++)
+                pLast = pLast->pNext;
+
+            Node* pOldDummy = pHead;
+            pOldDummy->data = std::move(pLast->data);
+            pHead = pLast;
+
+            // the chain to hand over: pFirst ... (node before pLast), pOldDummy
+            Node* pChainHead = (numTaken == 1) ? pOldDummy : pFirst;
+            Node* pPrev = nullptr;
+            for (Node* p = pChainHead; p != pLast && p != pOldDummy; p = p->pNext)
+            {
+                p->pPrev = pPrev;
+                pPrev = p;
+            }
+            if (pPrev)
+                pPrev->pNext = pOldDummy;
+            pOldDummy->pPrev = pPrev;
+            pOldDummy->pNext = nullptr;
+
+            // append the chain to the list
+            if (rhs.pTail)
+            {
+                rhs.pTail->pNext = pChainHead;
+                pChainHead->pPrev = rhs.pTail;
+            }
+            else
+                rhs.pHead = pChainHead;
+            rhs.pTail = pOldDummy;
+            rhs.numElements += numTaken;
+
+            // producers may have filled the queue while we walked, so only
+            // the count fetch_sub saw can say what the wakeups should be
+            numBefore = numElements.fetch_sub(numTaken, std::memory_order_acq_rel);
+            if (numBefore > numTaken)
+                notEmpty.notify_one();
+        }
+
+        // went from full to not: producers may be asleep
+        if (numBefore == maxElements)
+        {
+            std::lock_guard<std::mutex> lock(tailLock);
+            notFull.notify_all();
+        }
+        return numTaken;
+    }
+
+}; // namespace custom
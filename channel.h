@@ -0,0 +1,285 @@
+/***********************************************************************
+ * Header:
+ *    CHANNEL
+ * Summary:
+ *    A bounded queue for C++20 coroutines.  co_await ch.push(x) and
+ *    co_await ch.pop() suspend the coroutine rather than blocking the
+ *    thread.  Items wait in a custom::list.  Coroutines that have to
+ *    wait are parked in intrusive waiter lists whose links live in the
+ *    awaiters themselves, inside the suspended coroutine frames, so
+ *    parking never allocates.
+ *
+ *    When a pop finds a push waiting, or a push finds a pop waiting, the
+ *    item goes straight across and the side that arrived second keeps
+ *    running.  Only the coroutine that was parked is handed to the
+ *    executor, to be resumed later.
+ *
+ *    A capacity of zero makes every push wait for a matching pop.
+ *
+ *    This will contain the class definition of:
+ *        channel : A co_await-able bounded queue
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __cpp_impl_coroutine
+
+#include "list.h"
+#include "executor.h"
+#include <coroutine>   // for std::coroutine_handle
+#include <mutex>       // for std::mutex
+#include <optional>    // for std::optional
+#include <utility>
+
+class TestChannel;     // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * CHANNEL
+     * co_await push() and pop() from coroutines on any thread.
+     * Parked coroutines are resumed through the executor
+     **************************************************/
+    template <typename T>
+    class channel
+    {
+        friend class ::TestChannel; // give unit tests access to the privates
+    public:
+        class push_awaiter;
+        class pop_awaiter;
+
+        //
+        // Construct
+        //
+
+        channel(executor& ex, size_t capacity) : ex(ex), capacity(capacity), closed(false) {}
+        channel(const channel& rhs) = delete;
+        channel& operator = (const channel& rhs) = delete;
+
+        //
+        // Access
+        //
+
+        // co_await gives true, or false if the channel is closed
+        push_awaiter push(T data) { return push_awaiter(*this, std::move(data)); }
+        // co_await gives the item, or nothing once closed and empty
+        pop_awaiter pop() { return pop_awaiter(*this); }
+        // wake everybody waiting; pushing fails from now on
+        void close();
+
+        //
+        // Status
+        //
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(lockChannel);
+            return items.size();
+        }
+        bool empty() const { return size() == 0; }
+        bool is_closed() const
+        {
+            std::lock_guard<std::mutex> lock(lockChannel);
+            return closed;
+        }
+
+    private:
+        // a parked coroutine, linked into pushers or poppers
+        struct Waiter
+        {
+            Waiter* pNext = nullptr;
+            std::coroutine_handle<> h;
+        };
+
+        // an intrusive first-in first-out list of waiters
+        struct WaitList
+        {
+            Waiter* pHead = nullptr;
+            Waiter* pTail = nullptr;
+
+            bool empty() const { return pHead == nullptr; }
+            void push_back(Waiter* p)
+            {
+                p->pNext = nullptr;
+                if (pTail)
+                    pTail->pNext = p;
+                else
+                    pHead = p;
+                pTail = p;
+            }
+            Waiter* pop_front()
+            {
+                Waiter* p = pHead;
+                pHead = p->pNext;
+                if (pHead == nullptr)
+                    pTail = nullptr;
+                return p;
+            }
+        };
+
+        // member variables
+        executor& ex;                  // where parked coroutines are resumed
+        size_t capacity;               // how many items may wait in the channel
+        mutable std::mutex lockChannel;// guards everything below
+        list <T> items;                // pushed, not yet popped
+        WaitList pushers;              // waiting for room
+        WaitList poppers;              // waiting for an item
+        bool closed;
+    };
+
+    /*************************************************
+     * CHANNEL PUSH AWAITER
+     * Holds the item while its coroutine is parked
+     ************************************************/
+    template <typename T>
+    class channel <T> ::push_awaiter : public channel <T> ::Waiter
+    {
+        friend class channel <T>;
+        friend class pop_awaiter;
+    public:
+        push_awaiter(channel& ch, T&& data) : ch(ch), data(std::move(data)), pushed(false) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        // push without suspending if we can, otherwise park
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(ch.lockChannel);
+            if (ch.closed)
+                return false;
+
+            // somebody is waiting for exactly this: hand it over
+            if (!ch.poppers.empty())
+            {
+                pop_awaiter* pPopper = static_cast<pop_awaiter*>(ch.poppers.pop_front());
+                pPopper->data = std::move(data);
+                std::coroutine_handle<> hPopper = pPopper->h;
+                lock.unlock();
+                pushed = true;
+                ch.ex.post(hPopper);
+                return false;
+            }
+
+            // room in the channel
+            if (ch.items.size() < ch.capacity)
+            {
+                ch.items.push_back(std::move(data));
+                pushed = true;
+                return false;
+            }
+
+            // park until a pop makes room.  Once unlocked, another
+            // thread may resume us, so this must be left alone
+            this->h = h;
+            ch.pushers.push_back(this);
+            return true;
+        }
+
+        bool await_resume() const noexcept { return pushed; }
+
+    private:
+        channel& ch;
+        T data;         // the item, until somebody takes it
+        bool pushed;    // false if the channel closed first
+    };
+
+    /*************************************************
+     * CHANNEL POP AWAITER
+     * Receives the item while its coroutine is parked
+     ************************************************/
+    template <typename T>
+    class channel <T> ::pop_awaiter : public channel <T> ::Waiter
+    {
+        friend class channel <T>;
+        friend class push_awaiter;
+    public:
+        pop_awaiter(channel& ch) : ch(ch) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        // pop without suspending if we can, otherwise park
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            std::unique_lock<std::mutex> lock(ch.lockChannel);
+
+            if (!ch.items.empty())
+            {
+                data = std::move(ch.items.front());
+                ch.items.pop_front();
+
+                // that made room for somebody waiting to push
+                if (!ch.pushers.empty())
+                {
+                    push_awaiter* pPusher = static_cast<push_awaiter*>(ch.pushers.pop_front());
+                    ch.items.push_back(std::move(pPusher->data));
+                    pPusher->pushed = true;
+                    std::coroutine_handle<> hPusher = pPusher->h;
+                    lock.unlock();
+                    ch.ex.post(hPusher);
+                }
+                return false;
+            }
+
+            // no room at all (capacity 0): take it straight from a pusher
+            if (!ch.pushers.empty())
+            {
+                push_awaiter* pPusher = static_cast<push_awaiter*>(ch.pushers.pop_front());
+                data = std::move(pPusher->data);
+                pPusher->pushed = true;
+                std::coroutine_handle<> hPusher = pPusher->h;
+                lock.unlock();
+                ch.ex.post(hPusher);
+                return false;
+            }
+
+            if (ch.closed)
+                return false;
+
+            // park until a push arrives
+            this->h = h;
+            ch.poppers.push_back(this);
+            return true;
+        }
+
+        std::optional<T> await_resume() noexcept { return std::move(data); }
+
+    private:
+        channel& ch;
+        std::optional<T> data;   // empty if the channel closed first
+    };
+
+    /*********************************************
+     * CHANNEL :: CLOSE
+     * No more pushes.  Every parked pusher gets false and
+     * every parked popper gets nothing.  Items already in
+     * the channel can still be popped
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(number waiting)
+     *********************************************/
+    template <typename T>
+    void channel <T> ::close()
+    {
+        WaitList wake;
+        {
+            std::lock_guard<std::mutex> lock(lockChannel);
+            closed = true;
+            while (!pushers.empty())
+                wake.push_back(pushers.pop_front());
+            while (!poppers.empty())
+                wake.push_back(poppers.pop_front());
+        }
+
+        while (!wake.empty())
+        {
+            Waiter* p = wake.pop_front();
+            ex.post(p->h);   // p is gone once this runs
+        }
+    }
+
+}; // namespace custom
+
+#endif // __cpp_impl_coroutine
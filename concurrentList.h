@@ -0,0 +1,394 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT LIST
+ * Summary:
+ *    A list that many threads can change at once.  Every node carries
+ *    its own lock, and threads move through the list by lock coupling
+ *    (hand-over-hand): take the next node's lock before letting go of
+ *    the current one.  Two threads working on different parts of the
+ *    list never touch the same lock, so their inserts and erases run in
+ *    parallel.
+ *
+ *    Locks are only ever taken front to back, which is what keeps this
+ *    free of deadlock.  That is also why the nodes are singly linked: a
+ *    pPrev could never be followed safely.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_list : A list with a lock per node
+ *        iterator        : A cursor that holds the locks around its node
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <mutex>       // for std::mutex
+#include <initializer_list>
+#include <utility>
+
+class TestConcurrentList;  // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * CONCURRENT LIST
+     * A singly linked list with a lock per node
+     **************************************************/
+    template <typename T>
+    class concurrent_list
+    {
+        friend class ::TestConcurrentList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        concurrent_list() : numElements(0) {}
+        concurrent_list(const std::initializer_list<T>& il);
+        concurrent_list(const concurrent_list& rhs) = delete;
+        concurrent_list& operator = (const concurrent_list& rhs) = delete;
+        ~concurrent_list()
+        {
+            clear();
+        }
+
+        //
+        // Iterator
+        //
+
+        class  iterator;
+        iterator begin() { return iterator(&head); }
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_front(T&& data);
+        void push_back(const T& data);
+        void insert(iterator& it, const T& data);
+        void insert(iterator& it, T&& data);
+
+        //
+        // Remove
+        //
+
+        void erase(iterator& it);
+        template <class Predicate>
+        size_t remove_if(Predicate pred);
+        void clear();
+
+        //
+        // Search
+        //
+
+        template <class Predicate>
+        iterator find_if(Predicate pred);
+        template <class Function>
+        void for_each(Function f);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return numElements.load(std::memory_order_relaxed); }
+
+    private:
+        // nested linked list class
+        class Node;
+
+        // hook a new node in at the cursor
+        void link(iterator& it, Node* pNew);
+
+        // member variables
+        std::atomic<size_t> numElements; // changed by many threads at once
+        Node head;                       // sentinel, locked to reach the first node
+    };
+
+    /*************************************************
+     * NODE
+     * the node class: data, the next link, and the lock
+     * that guards that link
+     *************************************************/
+    template <typename T>
+    class concurrent_list <T> ::Node
+    {
+    public:
+        Node() : data(), pNext(nullptr) {}
+        Node(const T& data) : data(data), pNext(nullptr) {}
+        Node(T&& data) : data(std::move(data)), pNext(nullptr) {}
+
+        T data;             // user data
+        Node* pNext;        // pointer to next node, guarded by lock
+        std::mutex lock;    // held by whoever may change pNext or data
+    };
+
+    /*************************************************
+     * CONCURRENT LIST ITERATOR
+     * A cursor through the list.  It keeps the node it is
+     * on and the one in front of it locked, which is
+     * exactly what insert() and erase() need.  Since it
+     * owns locks it can be moved but not copied, and a
+     * thread should hold one iterator per list at a time
+     ************************************************/
+    template <typename T>
+    class concurrent_list <T> ::iterator
+    {
+        friend class ::TestConcurrentList; // give unit tests access to the privates
+        friend class concurrent_list <T>;
+    public:
+        // start at the sentinel: lock it and the first node
+        iterator(Node* pHead) : pPrev(pHead), p(nullptr)
+        {
+            pPrev->lock.lock();
+            p = pPrev->pNext;
+            if (p)
+                p->lock.lock();
+        }
+        iterator(iterator&& rhs) : pPrev(rhs.pPrev), p(rhs.p)
+        {
+            rhs.pPrev = rhs.p = nullptr;
+        }
+        iterator(const iterator& rhs) = delete;
+        iterator& operator = (const iterator& rhs) = delete;
+        ~iterator()
+        {
+            release();
+        }
+
+        // at the end once there is no current node
+        bool done() const { return p == nullptr; }
+
+        // dereference operator, the node is locked so this is safe
+        T& operator * ()
+        {
+            assert(p != nullptr);
+            return p->data;
+        }
+
+        // prefix increment: lock the next node before letting go of the previous
+        iterator& operator ++ ()
+        {
+            assert(p != nullptr);
+            Node* pNext = p->pNext;
+            if (pNext)
+                pNext->lock.lock();
+            pPrev->lock.unlock();
+            pPrev = p;
+            p = pNext;
+            return *this;
+        }
+
+        // let go of every lock early
+        void release()
+        {
+            if (p)
+                p->lock.unlock();
+            if (pPrev)
+                pPrev->lock.unlock();
+            pPrev = p = nullptr;
+        }
+
+    private:
+        Node* pPrev;    // locked: the node whose pNext is p
+        Node* p;        // locked: the current node, nullptr at the end
+    };
+
+    /*****************************************
+     * CONCURRENT LIST :: INITIALIZER constructors
+     ****************************************/
+    template <typename T>
+    concurrent_list <T> ::concurrent_list(const std::initializer_list<T>& il) : numElements(0)
+    {
+        Node* pLast = &head;
+        for (const auto& x : il)
+        {
+            pLast->pNext = new Node(x);
+            pLast = pLast->pNext;
+        }
+        numElements = il.size();
+    }
+
+    /**********************************************
+     * CONCURRENT LIST :: CLEAR
+     * Remove everything, one node at a time from the front
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T>
+    void concurrent_list <T> ::clear()
+    {
+        for (iterator it = begin(); !it.done(); )
+            erase(it);
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: LINK
+     * Put a new node between the two locked nodes of the
+     * cursor.  The cursor moves onto the new node, which
+     * nobody else can reach until we let go of pPrev
+     *    INPUT  : the cursor, the new node
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void concurrent_list <T> ::link(iterator& it, Node* pNew)
+    {
+        assert(it.pPrev != nullptr);
+        pNew->lock.lock();
+        pNew->pNext = it.p;
+        it.pPrev->pNext = pNew;
+        if (it.p)
+            it.p->lock.unlock();
+        it.p = pNew;
+        numElements.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /******************************************
+     * CONCURRENT LIST :: INSERT
+     * add an item in front of the cursor
+     *     INPUT  : the cursor; it is left on the new item
+     *              data to be added to the list
+     *     OUTPUT :
+     *     COST   : O(1), holding only the two locks the cursor has
+     ******************************************/
+    template <typename T>
+    void concurrent_list <T> ::insert(iterator& it, const T& data)
+    {
+        link(it, new Node(data));
+    }
+
+    template <typename T>
+    void concurrent_list <T> ::insert(iterator& it, T&& data)
+    {
+        link(it, new Node(std::move(data)));
+    }
+
+    /******************************************
+     * CONCURRENT LIST :: ERASE
+     * remove the item under the cursor.  Nobody else can
+     * be waiting on its lock: to get there they would need
+     * pPrev's lock, which the cursor holds
+     *     INPUT  : the cursor; it is left on the following item
+     *     OUTPUT :
+     *     COST   : O(1), holding only the locks the cursor has
+     ******************************************/
+    template <typename T>
+    void concurrent_list <T> ::erase(iterator& it)
+    {
+        if (it.p == nullptr)
+            return;
+
+        Node* pDead = it.p;
+        Node* pNext = pDead->pNext;
+        if (pNext)
+            pNext->lock.lock();
+        it.pPrev->pNext = pNext;
+        pDead->lock.unlock();
+        delete pDead;
+        it.p = pNext;
+        numElements.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: PUSH FRONT
+     * add an item to the head of the list
+     *     INPUT  : data to be added to the list
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void concurrent_list <T> ::push_front(const T& data)
+    {
+        iterator it = begin();
+        insert(it, data);
+    }
+
+    template <typename T>
+    void concurrent_list <T> ::push_front(T&& data)
+    {
+        iterator it = begin();
+        insert(it, std::move(data));
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: PUSH BACK
+     * add an item to the end of the list.  There is no
+     * tail pointer (it would be one lock everybody wants),
+     * so this walks the list hand over hand
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void concurrent_list <T> ::push_back(const T& data)
+    {
+        iterator it = begin();
+        while (!it.done())
+            ++it;
+        insert(it, data);
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: FIND IF
+     * walk to the first item matching a predicate
+     *    INPUT  : the predicate
+     *    OUTPUT : a cursor on the item, or done() if none
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Predicate>
+    typename concurrent_list <T> ::iterator concurrent_list <T> ::find_if(Predicate pred)
+    {
+        iterator it = begin();
+        while (!it.done() && !pred(*it))
+            ++it;
+        return it;
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: FOR EACH
+     * visit every item, each one locked while visited
+     *    INPUT  : what to do with each item
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Function>
+    void concurrent_list <T> ::for_each(Function f)
+    {
+        for (iterator it = begin(); !it.done(); ++it)
+            f(*it);
+    }
+
+    /*********************************************
+     * CONCURRENT LIST :: REMOVE IF
+     * erase every item matching a predicate in one pass
+     *    INPUT  : the predicate
+     *    OUTPUT : how many were removed
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Predicate>
+    size_t concurrent_list <T> ::remove_if(Predicate pred)
+    {
+        size_t num = 0;
+        iterator it = begin();
+        while (!it.done())
+        {
+            if (pred(*it))
+            {
+                erase(it);
+                num++;
+            }
+            else
+                ++it;
+        }
+        return num;
+    }
+
+}; // namespace custom
@@ -0,0 +1,331 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT SORTED LIST
+ * Summary:
+ *    A lock-free ordered set kept as a sorted singly linked list, after
+ *    Tim Harris's "A Pragmatic Implementation of Non-Blocking Linked
+ *    Lists."  insert(), erase() and contains() are lock-free: a thread
+ *    that stalls never stops the others, and some thread always makes
+ *    progress.  None of them is wait-free: insert() and erase() can be
+ *    made to retry by other threads changing the list under them, and
+ *    contains() walks for as long as others keep inserting ahead of
+ *    it.  Pinning the epoch and retiring a node never wait either, so
+ *    the one place any of this can block is the memory allocator
+ *    behind new and delete.
+ *
+ *    Erasing happens in two steps.  First the low bit of the victim's
+ *    pNext is set, which marks it as logically gone and stops anybody
+ *    from linking in behind it.  Then one CAS on the predecessor snips
+ *    it out.  Any thread that runs into a chain of marked nodes while
+ *    searching snips the whole chain with a single CAS.
+ *
+ *    The thread whose CAS unlinks a node retires it to an epoch_domain.
+ *    Every operation holds an epoch guard while it walks, so a node is
+ *    only deleted once every operation that might have reached it has
+ *    finished.  Operations that start later begin at the head, and
+ *    unlinked nodes can no longer be reached from there.  Unlike waiting
+ *    for a moment with no operation running at all, this keeps freeing
+ *    nodes under constant traffic.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_sorted_list : A lock-free sorted set (not counting new and delete)
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <cstdint>     // for std::uintptr_t
+#include "epoch.h"     // for epoch_domain
+
+class TestConcurrentSortedList;  // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * CONCURRENT SORTED LIST
+     * A set of T in ascending order.  T needs operator <
+     **************************************************/
+    template <typename T>
+    class concurrent_sorted_list
+    {
+        friend class ::TestConcurrentSortedList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        concurrent_sorted_list(epoch_domain& domain = epoch_domain::global());
+        concurrent_sorted_list(const concurrent_sorted_list& rhs) = delete;
+        concurrent_sorted_list& operator = (const concurrent_sorted_list& rhs) = delete;
+        ~concurrent_sorted_list();
+
+        //
+        // Access
+        //
+
+        bool insert(const T& data);
+        bool erase(const T& data);
+        bool contains(const T& data);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return numElements.load(std::memory_order_relaxed); }
+
+    private:
+        // nested linked list classes.  The head and tail sentinels
+        // carry no data, so they are only Links
+        struct Link;
+        class Node;
+
+        // the low bit of a pNext says the node holding it is erased
+        static bool  isMarked(std::uintptr_t link) { return (link & 1) != 0; }
+        static Link* pointer(std::uintptr_t link)  { return reinterpret_cast<Link*>(link & ~std::uintptr_t(1)); }
+        static std::uintptr_t address(Link* p)     { return reinterpret_cast<std::uintptr_t>(p); }
+
+        // the node's data, only to be called on a real node
+        static const T& value(Link* p)             { return static_cast<Node*>(p)->data; }
+
+        // find the unmarked neighbors on either side of where data belongs
+        Link* search(const T& data, Link*& pLeft);
+
+        // hand unlinked nodes over to be deleted later
+        void retire(Link* pFirst, Link* pStop);
+
+        // member variables
+        std::atomic<size_t> numElements;     // how many are in the set
+        Link head;                           // in front of the smallest item
+        Link tail;                           // behind the largest item
+        epoch_domain& domain;                // where unlinked nodes wait
+    };
+
+    /*************************************************
+     * LINK
+     * A pNext, with the erased mark in its low bit
+     *************************************************/
+    template <typename T>
+    struct concurrent_sorted_list <T> ::Link
+    {
+        Link() : pNext(0) {}
+        std::atomic<std::uintptr_t> pNext;   // pointer to next node, plus mark
+    };
+
+    /*************************************************
+     * NODE
+     * the node class.  An unlinked node keeps its pNext,
+     * because a thread still walking the list may be
+     * following it out of the node
+     *************************************************/
+    template <typename T>
+    class concurrent_sorted_list <T> ::Node : public Link
+    {
+    public:
+        Node(const T& data) : data(data) {}
+
+        const T data;       // user data, never changes once linked
+    };
+
+    /*****************************************
+     * CONCURRENT SORTED LIST :: DEFAULT constructors
+     * An empty list is the head linked to the tail
+     ****************************************/
+    template <typename T>
+    concurrent_sorted_list <T> ::concurrent_sorted_list(epoch_domain& domain) :
+        numElements(0), domain(domain)
+    {
+        head.pNext.store(address(&tail), std::memory_order_relaxed);
+    }
+
+    /*****************************************
+     * CONCURRENT SORTED LIST :: DESTRUCTOR
+     * No operation may still be running.  Nodes already
+     * retired belong to the domain now
+     ****************************************/
+    template <typename T>
+    concurrent_sorted_list <T> ::~concurrent_sorted_list()
+    {
+        Link* p = pointer(head.pNext.load(std::memory_order_acquire));
+        while (p != &tail)
+        {
+            Link* pNext = pointer(p->pNext.load(std::memory_order_relaxed));
+            delete static_cast<Node*>(p);
+            p = pNext;
+        }
+    }
+
+    /*********************************************
+     * CONCURRENT SORTED LIST :: SEARCH
+     * Find the first node not smaller than data (right)
+     * and the node in front of it (left), both unmarked
+     * and adjacent.  Marked nodes between them are
+     * snipped out with one CAS on left's pNext
+     *    INPUT  : the value, where to put left
+     *    OUTPUT : right, which may be the tail
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    typename concurrent_sorted_list <T> ::Link*
+        concurrent_sorted_list <T> ::search(const T& data, Link*& pLeft)
+    {
+        for (;;)
+        {
+            // 1. walk to right, remembering the last unmarked node before it
+            Link* p = &head;
+            std::uintptr_t pNext = head.pNext.load(std::memory_order_acquire);
+            std::uintptr_t leftNext = pNext;
+            pLeft = &head;
+            do
+            {
+                if (!isMarked(pNext))
+                {
+                    pLeft = p;
+                    leftNext = pNext;
+                }
+                p = pointer(pNext);
+                if (p == &tail)
+                    break;
+                pNext = p->pNext.load(std::memory_order_acquire);
+            }
+            while (isMarked(pNext) || value(p) < data);
+            Link* pRight = p;
+
+            // 2. already adjacent
+            if (pointer(leftNext) == pRight)
+            {
+                if (pRight != &tail && isMarked(pRight->pNext.load(std::memory_order_acquire)))
+                    continue;
+                return pRight;
+            }
+
+            // 3. snip out the marked nodes in between
+            if (pLeft->pNext.compare_exchange_strong(leftNext, address(pRight),
+                                                     std::memory_order_acq_rel))
+            {
+                retire(pointer(leftNext), pRight);
+                if (pRight != &tail && isMarked(pRight->pNext.load(std::memory_order_acquire)))
+                    continue;
+                return pRight;
+            }
+        }
+    }
+
+    /*********************************************
+     * CONCURRENT SORTED LIST :: INSERT
+     * add an item in its sorted place
+     *    INPUT  : data to be added
+     *    OUTPUT : false if it was already there
+     *    COST   : O(n), lock-free
+     *********************************************/
+    template <typename T>
+    bool concurrent_sorted_list <T> ::insert(const T& data)
+    {
+        epoch_domain::guard g(domain);
+        Node* pNew = nullptr;
+        for (;;)
+        {
+            Link* pLeft;
+            Link* pRight = search(data, pLeft);
+            if (pRight != &tail && !(data < value(pRight)))
+            {
+                delete pNew;
+                return false;
+            }
+
+            if (pNew == nullptr)
+                pNew = new Node(data);
+            pNew->pNext.store(address(pRight), std::memory_order_relaxed);
+            std::uintptr_t expected = address(pRight);
+            if (pLeft->pNext.compare_exchange_strong(expected, address(pNew),
+                                                     std::memory_order_acq_rel))
+            {
+                numElements.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    /*********************************************
+     * CONCURRENT SORTED LIST :: ERASE
+     * remove an item.  It is gone the moment its mark is
+     * set; if snipping it out then fails, a search will
+     * finish the job
+     *    INPUT  : data to be removed
+     *    OUTPUT : false if it was not there
+     *    COST   : O(n), lock-free
+     *********************************************/
+    template <typename T>
+    bool concurrent_sorted_list <T> ::erase(const T& data)
+    {
+        epoch_domain::guard g(domain);
+        Link* pLeft;
+        Link* pRight;
+        std::uintptr_t rightNext;
+        for (;;)
+        {
+            pRight = search(data, pLeft);
+            if (pRight == &tail || data < value(pRight))
+                return false;
+
+            rightNext = pRight->pNext.load(std::memory_order_acquire);
+            if (!isMarked(rightNext) &&
+                pRight->pNext.compare_exchange_strong(rightNext, rightNext | 1,
+                                                      std::memory_order_acq_rel))
+                break;
+        }
+        numElements.fetch_sub(1, std::memory_order_relaxed);
+
+        std::uintptr_t expected = address(pRight);
+        if (pLeft->pNext.compare_exchange_strong(expected, rightNext,
+                                                 std::memory_order_acq_rel))
+            retire(pRight, pointer(rightNext));
+        else
+            search(data, pLeft);
+        return true;
+    }
+
+    /*********************************************
+     * CONCURRENT SORTED LIST :: CONTAINS
+     * is an item in the set?  This only reads, marked
+     * nodes and all
+     *    INPUT  : data to look for
+     *    OUTPUT : true if it is there and not erased
+     *    COST   : O(n), lock-free
+     *********************************************/
+    template <typename T>
+    bool concurrent_sorted_list <T> ::contains(const T& data)
+    {
+        epoch_domain::guard g(domain);
+        Link* p = pointer(head.pNext.load(std::memory_order_acquire));
+        while (p != &tail && value(p) < data)
+            p = pointer(p->pNext.load(std::memory_order_acquire));
+        return p != &tail &&
+               !(data < value(p)) &&
+               !isMarked(p->pNext.load(std::memory_order_acquire));
+    }
+
+    /*********************************************
+     * CONCURRENT SORTED LIST :: RETIRE
+     * hand a chain of nodes this thread just unlinked to
+     * the epoch domain, to be deleted once no operation
+     * can still be standing on them
+     *    INPUT  : the first unlinked node, the node after the last
+     *    OUTPUT :
+     *    COST   : O(length of the chain)
+     *********************************************/
+    template <typename T>
+    void concurrent_sorted_list <T> ::retire(Link* pFirst, Link* pStop)
+    {
+        for (Link* p = pFirst; p != pStop; )
+        {
+            Node* pNode = static_cast<Node*>(p);
+            p = pointer(p->pNext.load(std::memory_order_relaxed));
+            domain.retire(pNode);
+        }
+    }
+
+}; // namespace custom
@@ -0,0 +1,497 @@
+/***********************************************************************
+ * Header:
+ *    COW LIST
+ * Summary:
+ *    A copy-on-write wrapper around custom::list.  Copies share one
+ *    reference-counted chain of nodes, so passing a cow_list by value
+ *    costs O(1).  The first call that could change the chain (push,
+ *    insert, erase, or a non-const front/back/begin) makes a private
+ *    copy if anyone else is still looking at it.
+ *
+ *    An iterator or reference that can write, once handed out, could
+ *    reach into a body shared later.  So handing one out marks the body
+ *    unshareable, and the next copy is a deep one, as the copy-on-write
+ *    strings of old did.  The body stays that way until it is let go.
+ *
+ *    This will contain the class definition of:
+ *        cow_list       : A List that is copied only when written to
+ *        const_iterator : A read-only iterator that never forces a copy
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <atomic>      // for std::atomic
+#include <initializer_list>
+#include <utility>
+
+class TestCowList;     // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * COW LIST
+     * A custom::list that shares its nodes until written
+     **************************************************/
+    template <typename T>
+    class cow_list
+    {
+        friend class ::TestCowList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        cow_list() : pBody(nullptr) {}
+        cow_list(const cow_list& rhs);
+        cow_list(cow_list&& rhs);
+        cow_list(list <T>&& rhs);
+        cow_list(size_t num, const T& t);
+        cow_list(size_t num);
+        cow_list(const std::initializer_list<T>& il);
+        template <class Iterator>
+        cow_list(Iterator first, Iterator last);
+        ~cow_list()
+        {
+            release();
+        }
+
+        //
+        // Assign
+        //
+
+        cow_list& operator = (const cow_list& rhs);
+        cow_list& operator = (cow_list&& rhs);
+        cow_list& operator = (const std::initializer_list<T>& il);
+        void swap(cow_list& rhs) { std::swap(pBody, rhs.pBody); }
+
+        //
+        // Iterator
+        //
+
+        typedef typename list <T> ::iterator iterator;
+        class const_iterator;
+        iterator begin() { return unshare().begin(); }
+        iterator rbegin() { return unshare().rbegin(); }
+        iterator end() { return iterator(nullptr); }
+        const_iterator begin() const;
+        const_iterator end() const { return const_iterator(); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        //
+        // Access
+        //
+
+        T& front() { return unshare().front(); }
+        T& back() { return unshare().back(); }
+        const T& front() const;
+        const T& back() const;
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data) { detach().push_front(data); }
+        void push_front(T&& data) { detach().push_front(std::move(data)); }
+        void push_back(const T& data) { detach().push_back(data); }
+        void push_back(T&& data) { detach().push_back(std::move(data)); }
+        iterator insert(iterator it, const T& data);
+        iterator insert(iterator it, T&& data);
+
+        //
+        // Remove
+        //
+
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator erase(const iterator& it);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return pBody ? pBody->data.size() : 0; }
+        size_t use_count() const { return pBody ? pBody->refs.load(std::memory_order_relaxed) : 0; }
+
+    private:
+        // the shared part: the list itself and how many cow_lists see it
+        struct Body
+        {
+            Body() : data(), refs(1), shareable(true) {}
+            Body(list <T>& rhs) : data(rhs), refs(1), shareable(true) {}
+            Body(list <T>&& rhs) : data(std::move(rhs)), refs(1), shareable(true) {}
+
+            list <T> data;
+            std::atomic<size_t> refs;
+            bool shareable;     // false once a way to write into it is handed out
+        };
+
+        // make sure we are the only owner before writing
+        list <T>& detach();
+        iterator detach(iterator it);
+
+        // detach, and keep it ours: a writable iterator or reference is going out
+        list <T>& unshare();
+
+        // share rhs's body, or copy it if it may not be shared
+        static Body* share(Body* pRhs);
+
+        // drop our reference, freeing the body if we were the last
+        void release();
+
+        // member variables
+        Body* pBody;        // shared node chain, nullptr when empty
+    };
+
+    /*************************************************
+     * COW LIST CONST ITERATOR
+     * Read through a shared list without copying it
+     ************************************************/
+    template <typename T>
+    class cow_list <T> ::const_iterator
+    {
+        friend class ::TestCowList; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        const_iterator() : it(nullptr) {}
+        const_iterator(const iterator& it) : it(it) {}
+
+        // equals, not equals operator
+        bool operator == (const const_iterator& rhs) const { return it == rhs.it; }
+        bool operator != (const const_iterator& rhs) const { return it != rhs.it; }
+
+        // dereference operator, read only
+        const T& operator * () const { return *it; }
+
+        // increment and decrement
+        const_iterator& operator ++ ()     { ++it; return *this; }
+        const_iterator  operator ++ (int)  { const_iterator temp(*this); ++it; return temp; }
+        const_iterator& operator -- ()     { --it; return *this; }
+        const_iterator  operator -- (int)  { const_iterator temp(*this); --it; return temp; }
+
+    private:
+        mutable iterator it;  // list<T>::iterator only has a non-const operator *
+    };
+
+    /*****************************************
+     * COW LIST :: COPY constructors
+     * Share the RHS's nodes: O(1)
+     ****************************************/
+    template <typename T>
+    cow_list <T> ::cow_list(const cow_list& rhs) : pBody(share(rhs.pBody))
+    {
+    }
+
+    /*****************************************
+     * COW LIST :: MOVE constructors
+     * Steal the RHS's reference
+     ****************************************/
+    template <typename T>
+    cow_list <T> ::cow_list(cow_list&& rhs) : pBody(rhs.pBody)
+    {
+        rhs.pBody = nullptr;
+    }
+
+    template <typename T>
+    cow_list <T> ::cow_list(list <T>&& rhs) : pBody(nullptr)
+    {
+        if (!rhs.empty())
+            pBody = new Body(std::move(rhs));
+    }
+
+    /*****************************************
+     * COW LIST :: NON-DEFAULT constructors
+     * Create a list initialized to a value
+     ****************************************/
+    template <typename T>
+    cow_list <T> ::cow_list(size_t num, const T& t) : pBody(nullptr)
+    {
+        if (num)
+            pBody = new Body(list <T>(num, t));
+    }
+
+    template <typename T>
+    cow_list <T> ::cow_list(size_t num) : pBody(nullptr)
+    {
+        if (num)
+            pBody = new Body(list <T>(num));
+    }
+
+    /*****************************************
+     * COW LIST :: INITIALIZER and ITERATOR constructors
+     * Create a list initialized to a set of values
+     ****************************************/
+    template <typename T>
+    cow_list <T> ::cow_list(const std::initializer_list<T>& il) : pBody(nullptr)
+    {
+        if (il.size())
+            pBody = new Body(list <T>(il));
+    }
+
+    template <typename T>
+    template <class Iterator>
+    cow_list <T> ::cow_list(Iterator first, Iterator last) : pBody(nullptr)
+    {
+        if (first != last)
+            pBody = new Body(list <T>(first, last));
+    }
+
+    /**********************************************
+     * COW LIST :: assignment operator
+     * Share the RHS's nodes
+     *     INPUT  : a list to be copied
+     *     OUTPUT :
+     *     COST   : O(1), plus freeing our old nodes if we were the last owner
+     *********************************************/
+    template <typename T>
+    cow_list <T>& cow_list <T> :: operator = (const cow_list& rhs)
+    {
+        if (pBody == rhs.pBody)
+            return *this;
+
+        Body* pNew = share(rhs.pBody);
+        release();
+        pBody = pNew;
+        return *this;
+    }
+
+    template <typename T>
+    cow_list <T>& cow_list <T> :: operator = (cow_list&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        release();
+        pBody = rhs.pBody;
+        rhs.pBody = nullptr;
+        return *this;
+    }
+
+    template <typename T>
+    cow_list <T>& cow_list <T> :: operator = (const std::initializer_list<T>& il)
+    {
+        cow_list tmp(il);
+        swap(tmp);
+        return *this;
+    }
+
+    template <typename T>
+    void swap(cow_list <T>& lhs, cow_list <T>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /**********************************************
+     * COW LIST :: RELEASE
+     * Let go of the shared body
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(1), or O(n) when we were the last owner
+     *********************************************/
+    template <typename T>
+    void cow_list <T> ::release()
+    {
+        if (pBody && pBody->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete pBody;
+        pBody = nullptr;
+    }
+
+    /**********************************************
+     * COW LIST :: SHARE
+     * Take another reference to a body, unless writable
+     * iterators or references into it are out there
+     *     INPUT  : the body to share, or nullptr
+     *     OUTPUT : the body to use
+     *     COST   : O(1) if shareable, O(n) otherwise
+     *********************************************/
+    template <typename T>
+    typename cow_list <T> ::Body* cow_list <T> ::share(Body* pRhs)
+    {
+        if (pRhs == nullptr)
+            return nullptr;
+        if (!pRhs->shareable)
+            return new Body(pRhs->data);
+        pRhs->refs.fetch_add(1, std::memory_order_relaxed);
+        return pRhs;
+    }
+
+    /**********************************************
+     * COW LIST :: UNSHARE
+     * Get a list that nobody else can see, now or later
+     *     INPUT  :
+     *     OUTPUT : our own private list
+     *     COST   : O(1) if we are the only owner, O(n) otherwise
+     *********************************************/
+    template <typename T>
+    list <T>& cow_list <T> ::unshare()
+    {
+        list <T>& data = detach();
+        pBody->shareable = false;
+        return data;
+    }
+
+    /**********************************************
+     * COW LIST :: DETACH
+     * Get a list that nobody else can see
+     *     INPUT  :
+     *     OUTPUT : our own private list
+     *     COST   : O(1) if we are the only owner, O(n) otherwise
+     *********************************************/
+    template <typename T>
+    list <T>& cow_list <T> ::detach()
+    {
+        if (pBody == nullptr)
+            pBody = new Body;
+        else if (pBody->refs.load(std::memory_order_acquire) != 1)
+        {
+            Body* pCopy = new Body(pBody->data);
+            release();
+            pBody = pCopy;
+        }
+        return pBody->data;
+    }
+
+    /**********************************************
+     * COW LIST :: DETACH
+     * Detach, and find where an iterator into the shared
+     * list lands in our private copy
+     *     INPUT  : an iterator into the (possibly shared) list
+     *     OUTPUT : the matching iterator into our private list
+     *     COST   : O(1) if we are the only owner, O(n) otherwise
+     *********************************************/
+    template <typename T>
+    typename cow_list <T> ::iterator cow_list <T> ::detach(iterator it)
+    {
+        if (pBody == nullptr || pBody->refs.load(std::memory_order_acquire) == 1)
+        {
+            detach();
+            return it;
+        }
+
+        // walk the old and new lists together to translate the position
+        iterator itOld = pBody->data.begin();
+        list <T>& data = detach();
+        iterator itNew = data.begin();
+        while (itOld != it && itOld != iterator(nullptr))
+        {
+            ++itOld;
+            ++itNew;
+        }
+        return itNew;
+    }
+
+    /******************************************
+     * COW LIST :: INSERT
+     * add an item to the middle of the list
+     *     INPUT  : data to be added to the list
+     *              an iterator to the location where it is to be inserted
+     *     OUTPUT : iterator to the new item
+     *     COST   : O(1) if unshared, otherwise O(n) for the copy
+     ******************************************/
+    template <typename T>
+    typename cow_list <T> ::iterator cow_list <T> ::insert(iterator it, const T& data)
+    {
+        iterator itInsert = detach(it);
+        pBody->shareable = false;
+        return pBody->data.insert(itInsert, data);
+    }
+
+    template <typename T>
+    typename cow_list <T> ::iterator cow_list <T> ::insert(iterator it, T&& data)
+    {
+        iterator itInsert = detach(it);
+        pBody->shareable = false;
+        return pBody->data.insert(itInsert, std::move(data));
+    }
+
+    /******************************************
+     * COW LIST :: ERASE
+     * remove an item from the middle of the list
+     *     INPUT  : an iterator to the item being removed
+     *     OUTPUT : iterator to the new location
+     *     COST   : O(1) if unshared, otherwise O(n) for the copy
+     ******************************************/
+    template <typename T>
+    typename cow_list <T> ::iterator cow_list <T> ::erase(const iterator& it)
+    {
+        if (empty())
+            return end();
+        iterator itErase = detach(it);
+        pBody->shareable = false;
+        return pBody->data.erase(itErase);
+    }
+
+    /*********************************************
+     * COW LIST :: POP BACK, POP FRONT
+     * remove an item from an end of the list
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1) if unshared, otherwise O(n) for the copy
+     *********************************************/
+    template <typename T>
+    void cow_list <T> ::pop_back()
+    {
+        if (!empty())
+            detach().pop_back();
+    }
+
+    template <typename T>
+    void cow_list <T> ::pop_front()
+    {
+        if (!empty())
+            detach().pop_front();
+    }
+
+    /*********************************************
+     * COW LIST :: CLEAR
+     * Let go of our nodes.  Nothing is copied: the
+     * other owners keep theirs
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1) if shared, otherwise O(n)
+     *********************************************/
+    template <typename T>
+    void cow_list <T> ::clear()
+    {
+        release();
+    }
+
+    /*********************************************
+     * COW LIST :: BEGIN (const)
+     * Start reading without forcing a copy
+     *********************************************/
+    template <typename T>
+    typename cow_list <T> ::const_iterator cow_list <T> ::begin() const
+    {
+        return pBody ? const_iterator(pBody->data.begin()) : const_iterator();
+    }
+
+    /*********************************************
+     * COW LIST :: FRONT and BACK (const)
+     * Read an end of the list without forcing a copy
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    const T& cow_list <T> ::front() const
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return pBody->data.front();
+    }
+
+    template <typename T>
+    const T& cow_list <T> ::back() const
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return pBody->data.back();
+    }
+
+}; // namespace custom
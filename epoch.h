@@ -0,0 +1,380 @@
+/***********************************************************************
+ * Header:
+ *    EPOCH
+ * Summary:
+ *    Epoch-based memory reclamation.  Readers pin the current epoch
+ *    with a guard for as long as they hold pointers into a shared
+ *    structure.  Writers unlink a node and retire it instead of
+ *    deleting it.  A retired node is only freed once every reader that
+ *    could have seen it has let go of its guard.
+ *
+ *    A thread holds at most one slot in a domain: a guard made while
+ *    the thread already holds one just counts itself in, and the slot
+ *    keeps the older epoch.  When every slot is taken, another block of
+ *    slots is chained on, so pinning never waits for a reader to leave.
+ *
+ *    Retired nodes go on a lock-free stack.  A reclaimer takes the whole
+ *    stack with one exchange and pushes back what is not ripe yet, so
+ *    neither retiring nor reclaiming ever waits on another thread.  The
+ *    only thing that can block is the memory allocator.
+ *
+ *    The global epoch only advances once every pinned reader is in the
+ *    current epoch.  Anything retired in epoch e was unlinked before
+ *    the epoch moved to e + 1, so once it reaches e + 2 no reader can
+ *    still be holding it.
+ *
+ *    This will contain the class definition of:
+ *        epoch_domain : The global epoch, the reader slots, the retired nodes
+ *        guard        : Pins the epoch for one reader
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic
+#include <cassert>     // for assert
+#include <cstdint>     // for std::uint64_t
+#include <functional>  // for std::hash
+#include <thread>      // for std::this_thread
+#include <vector>      // for std::vector
+
+class TestEpoch;       // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * EPOCH DOMAIN
+     * Everything sharing a domain shares one epoch.  Most
+     * code should use epoch_domain::global()
+     **************************************************/
+    class epoch_domain
+    {
+        friend class ::TestEpoch; // give unit tests access to the privates
+    public:
+        class guard;
+
+        // how many slots each block holds
+        static const size_t numSlots = 64;
+        // retire() tries to reclaim every time this many pile up
+        static const size_t reclaimEvery = 64;
+
+        //
+        // Construct
+        //
+
+        epoch_domain() : epoch(1), pRetired(nullptr), numRetired(0) {}
+        epoch_domain(const epoch_domain& rhs) = delete;
+        epoch_domain& operator = (const epoch_domain& rhs) = delete;
+        ~epoch_domain();
+
+        static epoch_domain& global()
+        {
+            static epoch_domain domain;
+            return domain;
+        }
+
+        //
+        // Reclaim
+        //
+
+        template <class U>
+        void retire(U* p)
+        {
+            retire(static_cast<void*>(p), [](void* pv) { delete static_cast<U*>(pv); });
+        }
+        void retire(void* p, void (*destroy)(void*));
+        size_t try_reclaim();
+
+        //
+        // Status
+        //
+
+        std::uint64_t current() const { return epoch.load(); }
+        size_t retired() const { return numRetired.load(std::memory_order_relaxed); }
+
+    private:
+        // a reader's slot: 0 when free, otherwise the epoch it pinned.
+        // Padded rather than aligned, so blocks can come from new
+        struct Slot
+        {
+            Slot() : pinned(0) {}
+            std::atomic<std::uint64_t> pinned;
+            char pad[64 - sizeof(std::atomic<std::uint64_t>)];
+        };
+
+        // the slots, and the next block once these have all been taken
+        struct SlotBlock
+        {
+            SlotBlock() : pNext(nullptr) {}
+            Slot slots[numSlots];
+            std::atomic<SlotBlock*> pNext;
+        };
+
+        // the slot this thread holds in a domain, and how many guards share it
+        struct Pin
+        {
+            const epoch_domain* pDomain;
+            Slot* pSlot;
+            size_t depth;
+        };
+        static std::vector<Pin>& pins()
+        {
+            thread_local std::vector<Pin> v;
+            return v;
+        }
+
+        // something waiting to be freed, on a stack of them
+        struct Retired
+        {
+            void* p;
+            void (*destroy)(void*);
+            std::uint64_t epoch;
+            Retired* pNext;
+        };
+
+        Slot* pin();
+        Slot* claim();
+        void unpin(Slot* pSlot);
+        bool tryAdvance();
+        void pushRetired(Retired* pFirst, Retired* pLast);
+
+        // member variables
+        alignas(64) std::atomic<std::uint64_t> epoch;   // the global epoch, never 0
+        SlotBlock slots;                                // one per pinned thread, then more
+        alignas(64) std::atomic<Retired*> pRetired;     // retired, not yet freed
+        std::atomic<size_t> numRetired;                 // how many are on that stack
+    };
+
+    /*************************************************
+     * GUARD
+     * Holds the epoch still for one reader.  Any node the
+     * reader reaches while the guard lives stays valid
+     * until the guard is gone.  A guard must be destroyed
+     * on the thread that made it
+     ************************************************/
+    class epoch_domain::guard
+    {
+        friend class ::TestEpoch; // give unit tests access to the privates
+    public:
+        guard() : pDomain(&epoch_domain::global()), pSlot(pDomain->pin()) {}
+        guard(epoch_domain& domain) : pDomain(&domain), pSlot(domain.pin()) {}
+        guard(guard&& rhs) : pDomain(rhs.pDomain), pSlot(rhs.pSlot)
+        {
+            rhs.pDomain = nullptr;
+        }
+        guard(const guard& rhs) = delete;
+        guard& operator = (const guard& rhs) = delete;
+        ~guard()
+        {
+            if (pDomain)
+                pDomain->unpin(pSlot);
+        }
+
+    private:
+        epoch_domain* pDomain;
+        Slot* pSlot;
+    };
+
+    /*****************************************
+     * EPOCH DOMAIN :: DESTRUCTOR
+     * No guard may still be alive.  Free everything
+     ****************************************/
+    inline epoch_domain::~epoch_domain()
+    {
+        for (Retired* p = pRetired.load(); p != nullptr; )
+        {
+            Retired* pNext = p->pNext;
+            p->destroy(p->p);
+            delete p;
+            p = pNext;
+        }
+        for (SlotBlock* p = slots.pNext.load(); p != nullptr; )
+        {
+            SlotBlock* pNext = p->pNext.load();
+            delete p;
+            p = pNext;
+        }
+    }
+
+    /*****************************************
+     * EPOCH DOMAIN :: PIN
+     * Pin this thread.  If it already holds a slot here,
+     * count one more guard on it; otherwise claim one
+     *     INPUT  :
+     *     OUTPUT : the slot
+     *     COST   : O(1) expected
+     ****************************************/
+    inline epoch_domain::Slot* epoch_domain::pin()
+    {
+        std::vector<Pin>& v = pins();
+        for (Pin& held : v)
+            if (held.pDomain == this)
+            {
+                held.depth++;
+                return held.pSlot;
+            }
+        Slot* pSlot = claim();
+        v.push_back(Pin{ this, pSlot, 1 });
+        return pSlot;
+    }
+
+    /*****************************************
+     * EPOCH DOMAIN :: UNPIN
+     * One guard fewer; the last one frees the slot
+     *     INPUT  : the slot pin() gave
+     *     OUTPUT :
+     *     COST   : O(domains this thread is pinned in)
+     ****************************************/
+    inline void epoch_domain::unpin(Slot* pSlot)
+    {
+        std::vector<Pin>& v = pins();
+        for (size_t i = 0; i < v.size(); i++)
+            if (v[i].pDomain == this)
+            {
+                assert(v[i].pSlot == pSlot);
+                if (--v[i].depth == 0)
+                {
+                    pSlot->pinned.store(0, std::memory_order_release);
+                    v[i] = v.back();
+                    v.pop_back();
+                }
+                return;
+            }
+        assert(false);
+    }
+
+    /*****************************************
+     * EPOCH DOMAIN :: CLAIM
+     * Take a free slot and stamp it with the current
+     * epoch.  Threads start looking in different places so
+     * they rarely fight over a slot.  If a block is full,
+     * move on to the next, adding one if there is none
+     *     INPUT  :
+     *     OUTPUT : the slot claimed
+     *     COST   : O(1) expected
+     ****************************************/
+    inline epoch_domain::Slot* epoch_domain::claim()
+    {
+        size_t iStart = std::hash<std::thread::id>()(std::this_thread::get_id()) % numSlots;
+        SlotBlock* pBlock = &slots;
+        for (;;)
+        {
+            for (size_t n = 0; n < numSlots; n++)
+            {
+                Slot& slot = pBlock->slots[(iStart + n) % numSlots];
+                std::uint64_t expected = 0;
+                if (slot.pinned.load(std::memory_order_relaxed) == 0 &&
+                    slot.pinned.compare_exchange_strong(expected, epoch.load()))
+                    return &slot;
+            }
+
+            SlotBlock* pNext = pBlock->pNext.load(std::memory_order_acquire);
+            if (pNext == nullptr)
+            {
+                SlotBlock* pNew = new SlotBlock;
+                if (pBlock->pNext.compare_exchange_strong(pNext, pNew))
+                    pNext = pNew;
+                else
+                    delete pNew;   // somebody else added one; pNext is theirs
+            }
+            pBlock = pNext;
+        }
+    }
+
+    /*****************************************
+     * EPOCH DOMAIN :: TRY ADVANCE
+     * Move to the next epoch if every pinned reader is
+     * already in this one
+     *     INPUT  :
+     *     OUTPUT : true if the epoch moved
+     *     COST   : O(slots)
+     ****************************************/
+    inline bool epoch_domain::tryAdvance()
+    {
+        std::uint64_t e = epoch.load();
+        for (SlotBlock* pBlock = &slots; pBlock != nullptr; pBlock = pBlock->pNext.load())
+            for (auto& slot : pBlock->slots)
+            {
+                std::uint64_t pinned = slot.pinned.load();
+                if (pinned != 0 && pinned != e)
+                    return false;
+            }
+        return epoch.compare_exchange_strong(e, e + 1);
+    }
+
+    /*********************************************
+     * EPOCH DOMAIN :: RETIRE
+     * The node has been unlinked; free it once no reader
+     * can still see it.  It goes on a lock-free stack;
+     * pushing onto one is safe from ABA, since nothing
+     * is ever popped from the top alone
+     *    INPUT  : the node, how to free it
+     *    OUTPUT :
+     *    COST   : O(1) amortized
+     *********************************************/
+    inline void epoch_domain::retire(void* p, void (*destroy)(void*))
+    {
+        // count it first so a reclaimer that frees it never takes the count below 0
+        size_t num = numRetired.fetch_add(1, std::memory_order_relaxed) + 1;
+        Retired* pNew = new Retired{ p, destroy, epoch.load(), nullptr };
+        pushRetired(pNew, pNew);
+        if (num % reclaimEvery == 0)
+            try_reclaim();
+    }
+
+    // put a chain back on top of the stack
+    inline void epoch_domain::pushRetired(Retired* pFirst, Retired* pLast)
+    {
+        Retired* pTop = pRetired.load(std::memory_order_relaxed);
+        do
+            pLast->pNext = pTop;
+        while (!pRetired.compare_exchange_weak(pTop, pFirst, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+    /*********************************************
+     * EPOCH DOMAIN :: TRY RECLAIM
+     * Advance the epoch if we can, then free everything
+     * retired two or more epochs ago.  The whole stack is
+     * taken with one exchange, so reclaimers running at
+     * once each sort a different chain, and what is not
+     * ripe yet is pushed back
+     *    INPUT  :
+     *    OUTPUT : how many were freed
+     *    COST   : O(slots + number retired)
+     *********************************************/
+    inline size_t epoch_domain::try_reclaim()
+    {
+        tryAdvance();
+        std::uint64_t e = epoch.load();
+
+        Retired* pKeep = nullptr;
+        Retired* pKeepLast = nullptr;
+        size_t num = 0;
+        for (Retired* p = pRetired.exchange(nullptr, std::memory_order_acquire); p != nullptr; )
+        {
+            Retired* pNext = p->pNext;
+            if (p->epoch + 2 <= e)
+            {
+                p->destroy(p->p);
+                delete p;
+                num++;
+            }
+            else
+            {
+                p->pNext = pKeep;
+                pKeep = p;
+                if (pKeepLast == nullptr)
+                    pKeepLast = p;
+            }
+            p = pNext;
+        }
+
+        if (pKeep != nullptr)
+            pushRetired(pKeep, pKeepLast);
+        numRetired.fetch_sub(num, std::memory_order_relaxed);
+        return num;
+    }
+
+}; // namespace custom
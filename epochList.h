@@ -0,0 +1,366 @@
+/***********************************************************************
+ * Header:
+ *    EPOCH LIST
+ * Summary:
+ *    A list that readers walk without taking any lock, even while a
+ *    writer is erasing.  Writers take turns on one mutex, link nodes
+ *    with release stores, and hand erased nodes to an epoch_domain
+ *    rather than deleting them.  A reader holds an epoch guard while it
+ *    walks, so the node it stands on cannot be freed out from under it.
+ *
+ *    An erased node keeps pointing at its old successor, so a reader
+ *    standing on it simply walks back into the live list.
+ *
+ *    This will contain the class definition of:
+ *        epoch_list     : A list with lock-free readers
+ *        const_iterator : A reader's forward walk through the list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "epoch.h"
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <mutex>       // for std::mutex
+#include <initializer_list>
+#include <utility>
+
+class TestEpochList;   // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * EPOCH LIST
+     * Many readers, one writer at a time
+     **************************************************/
+    template <typename T>
+    class epoch_list
+    {
+        friend class ::TestEpochList; // give unit tests access to the privates
+    public:
+        typedef epoch_domain::guard guard;
+
+        //
+        // Construct
+        //
+
+        epoch_list(epoch_domain& domain = epoch_domain::global()) :
+            numElements(0), pHead(nullptr), pTail(nullptr), domain(domain) {}
+        epoch_list(const std::initializer_list<T>& il, epoch_domain& domain = epoch_domain::global());
+        epoch_list(const epoch_list& rhs) = delete;
+        epoch_list& operator = (const epoch_list& rhs) = delete;
+        ~epoch_list();
+
+        //
+        // Reader side: hold a guard from pin() while walking
+        //
+
+        class  const_iterator;
+        guard pin() const { return guard(domain); }
+        const_iterator begin() const;
+        const_iterator end()   const { return const_iterator(nullptr); }
+
+        //
+        // Writer side: any thread, one at a time
+        //
+
+        void push_front(const T& data);
+        void push_back(const T& data);
+        void pop_front();
+        void pop_back();
+        bool erase(const const_iterator& it);
+        template <class Predicate>
+        size_t remove_if(Predicate pred);
+        void clear();
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const { return numElements.load(std::memory_order_relaxed); }
+
+    private:
+        // nested linked list class
+        class Node;
+
+        // unlink a node the writer holds and retire it
+        void unlink(Node* p);
+
+        // member variables
+        std::atomic<size_t> numElements;    // readers may ask at any time
+        std::atomic<Node*> pHead;           // readers start here
+        Node* pTail;                        // writers only
+        std::mutex lockWriter;              // one writer at a time
+        epoch_domain& domain;               // where erased nodes wait
+    };
+
+    /*************************************************
+     * NODE
+     * Readers only ever follow pNext.  pPrev and erased
+     * belong to the writers
+     *************************************************/
+    template <typename T>
+    class epoch_list <T> ::Node
+    {
+    public:
+        Node(const T& data) : data(data), pNext(nullptr), pPrev(nullptr), erased(false) {}
+
+        const T data;                // user data, fixed once readers can see it
+        std::atomic<Node*> pNext;    // pointer to next node
+        Node* pPrev;                 // pointer to previous node, writers only
+        bool erased;                 // unlinked already, writers only
+    };
+
+    /*************************************************
+     * EPOCH LIST CONST ITERATOR
+     * Only valid while the thread holds a guard
+     ************************************************/
+    template <typename T>
+    class epoch_list <T> ::const_iterator
+    {
+        friend class ::TestEpochList; // give unit tests access to the privates
+        friend class epoch_list <T>;
+    public:
+        const_iterator() : p(nullptr) {}
+        const_iterator(Node* p) : p(p) {}
+
+        bool operator == (const const_iterator& rhs) const { return p == rhs.p; }
+        bool operator != (const const_iterator& rhs) const { return p != rhs.p; }
+
+        // dereference operator
+        const T& operator * () const
+        {
+            assert(p != nullptr);
+            return p->data;
+        }
+
+        // prefix increment
+        const_iterator& operator ++ ()
+        {
+            assert(p != nullptr);
+            p = p->pNext.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        // postfix increment
+        const_iterator operator ++ (int postfix)
+        {
+            const_iterator itReturn = *this;
+            ++(*this);
+            return itReturn;
+        }
+
+    private:
+        Node* p;
+    };
+
+    /*****************************************
+     * EPOCH LIST :: INITIALIZER constructors
+     ****************************************/
+    template <typename T>
+    epoch_list <T> ::epoch_list(const std::initializer_list<T>& il, epoch_domain& domain) :
+        numElements(0), pHead(nullptr), pTail(nullptr), domain(domain)
+    {
+        for (const auto& x : il)
+            push_back(x);
+    }
+
+    /*****************************************
+     * EPOCH LIST :: DESTRUCTOR
+     * No reader may still be walking.  Nodes already
+     * retired belong to the domain
+     ****************************************/
+    template <typename T>
+    epoch_list <T> ::~epoch_list()
+    {
+        Node* p = pHead.load(std::memory_order_acquire);
+        while (p)
+        {
+            Node* pNext = p->pNext.load(std::memory_order_relaxed);
+            delete p;
+            p = pNext;
+        }
+    }
+
+    /*********************************************
+     * EPOCH LIST :: BEGIN
+     * where a reader starts
+     *    INPUT  :
+     *    OUTPUT : the first node, or end() if there is none
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    typename epoch_list <T> ::const_iterator epoch_list <T> ::begin() const
+    {
+        return const_iterator(pHead.load(std::memory_order_acquire));
+    }
+
+    /*********************************************
+     * EPOCH LIST :: PUSH FRONT
+     * add an item to the head of the list.  The node is
+     * filled in before the release store publishes it
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::push_front(const T& data)
+    {
+        Node* pNew = new Node(data);
+        std::lock_guard<std::mutex> lock(lockWriter);
+        Node* pOld = pHead.load(std::memory_order_relaxed);
+        pNew->pNext.store(pOld, std::memory_order_relaxed);
+        if (pOld)
+            pOld->pPrev = pNew;
+        else
+            pTail = pNew;
+        pHead.store(pNew, std::memory_order_release);
+        numElements.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*********************************************
+     * EPOCH LIST :: PUSH BACK
+     * add an item to the end of the list
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::push_back(const T& data)
+    {
+        Node* pNew = new Node(data);
+        std::lock_guard<std::mutex> lock(lockWriter);
+        pNew->pPrev = pTail;
+        if (pTail)
+            pTail->pNext.store(pNew, std::memory_order_release);
+        else
+            pHead.store(pNew, std::memory_order_release);
+        pTail = pNew;
+        numElements.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*********************************************
+     * EPOCH LIST :: UNLINK
+     * take a node out of the list and retire it.  Its own
+     * pNext is left alone for any reader standing on it.
+     * The caller holds lockWriter
+     *    INPUT  : the node
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::unlink(Node* p)
+    {
+        Node* pNext = p->pNext.load(std::memory_order_relaxed);
+        if (p->pPrev)
+            p->pPrev->pNext.store(pNext, std::memory_order_release);
+        else
+            pHead.store(pNext, std::memory_order_release);
+        if (pNext)
+            pNext->pPrev = p->pPrev;
+        else
+            pTail = p->pPrev;
+
+        p->erased = true;
+        numElements.fetch_sub(1, std::memory_order_relaxed);
+        domain.retire(p);
+    }
+
+    /*********************************************
+     * EPOCH LIST :: POP FRONT
+     * remove the first item, if there is one
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::pop_front()
+    {
+        std::lock_guard<std::mutex> lock(lockWriter);
+        Node* p = pHead.load(std::memory_order_relaxed);
+        if (p)
+            unlink(p);
+    }
+
+    /*********************************************
+     * EPOCH LIST :: POP BACK
+     * remove the last item, if there is one
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::pop_back()
+    {
+        std::lock_guard<std::mutex> lock(lockWriter);
+        if (pTail)
+            unlink(pTail);
+    }
+
+    /*********************************************
+     * EPOCH LIST :: ERASE
+     * remove the item a reader found.  The caller must
+     * still hold the guard it walked under; if another
+     * writer got there first nothing happens
+     *    INPUT  : the item
+     *    OUTPUT : true if this call removed it
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    bool epoch_list <T> ::erase(const const_iterator& it)
+    {
+        if (it.p == nullptr)
+            return false;
+        std::lock_guard<std::mutex> lock(lockWriter);
+        if (it.p->erased)
+            return false;
+        unlink(it.p);
+        return true;
+    }
+
+    /*********************************************
+     * EPOCH LIST :: REMOVE IF
+     * remove every item matching a predicate
+     *    INPUT  : the predicate
+     *    OUTPUT : how many were removed
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Predicate>
+    size_t epoch_list <T> ::remove_if(Predicate pred)
+    {
+        std::lock_guard<std::mutex> lock(lockWriter);
+        size_t num = 0;
+        Node* p = pHead.load(std::memory_order_relaxed);
+        while (p)
+        {
+            Node* pNext = p->pNext.load(std::memory_order_relaxed);
+            if (pred(p->data))
+            {
+                unlink(p);
+                num++;
+            }
+            p = pNext;
+        }
+        return num;
+    }
+
+    /**********************************************
+     * EPOCH LIST :: CLEAR
+     * Remove everything
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void epoch_list <T> ::clear()
+    {
+        std::lock_guard<std::mutex> lock(lockWriter);
+        while (pHead.load(std::memory_order_relaxed))
+            unlink(pHead.load(std::memory_order_relaxed));
+    }
+
+}; // namespace custom
@@ -0,0 +1,180 @@
+/***********************************************************************
+ * Header:
+ *    EXECUTOR
+ * Summary:
+ *    Somewhere for C++20 coroutines to run.  An executor takes
+ *    suspended coroutines and resumes them later, either all on the
+ *    calling thread or spread over a pool of threads.  Ready coroutines
+ *    wait in a custom::list.
+ *
+ *    A coroutine moves onto an executor with co_await ex.schedule().
+ *    detached_task is the simplest coroutine type: it starts right away
+ *    and frees itself when it finishes.
+ *
+ *    Everything here needs compiler support for coroutines, so none of
+ *    it exists when __cpp_impl_coroutine is not defined.
+ *
+ *    This will contain the class definition of:
+ *        executor               : What every executor can do
+ *        single_thread_executor : Resumes everything on the thread calling run()
+ *        thread_pool_executor   : Resumes on whichever worker is free
+ *        detached_task          : A fire-and-forget coroutine
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __cpp_impl_coroutine
+
+#include "list.h"
+#include <condition_variable>  // for std::condition_variable
+#include <coroutine>           // for std::coroutine_handle
+#include <exception>           // for std::terminate
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include <vector>              // for std::vector
+
+class TestChannel;     // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * EXECUTOR
+     * Anything that can resume a suspended coroutine
+     **************************************************/
+    class executor
+    {
+    public:
+        virtual ~executor() {}
+
+        // resume this coroutine at some point, from some thread
+        virtual void post(std::coroutine_handle<> h) = 0;
+
+        // co_await ex.schedule() to continue on this executor
+        struct schedule_awaiter
+        {
+            executor& ex;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { ex.post(h); }
+            void await_resume() const noexcept {}
+        };
+        schedule_awaiter schedule() { return schedule_awaiter{ *this }; }
+    };
+
+    /**************************************************
+     * SINGLE THREAD EXECUTOR
+     * Coroutines only run inside run().  Not thread safe:
+     * post() and run() belong to one thread
+     **************************************************/
+    class single_thread_executor : public executor
+    {
+        friend class ::TestChannel; // give unit tests access to the privates
+    public:
+        void post(std::coroutine_handle<> h) override
+        {
+            ready.push_back(h);
+        }
+
+        // resume until nobody is ready, return how many were resumed
+        size_t run()
+        {
+            size_t num = 0;
+            while (!ready.empty())
+            {
+                std::coroutine_handle<> h = ready.front();
+                ready.pop_front();
+                h.resume();
+                num++;
+            }
+            return num;
+        }
+
+    private:
+        list <std::coroutine_handle<>> ready;   // waiting to be resumed
+    };
+
+    /**************************************************
+     * THREAD POOL EXECUTOR
+     * A fixed set of worker threads sharing one ready list
+     **************************************************/
+    class thread_pool_executor : public executor
+    {
+        friend class ::TestChannel; // give unit tests access to the privates
+    public:
+        thread_pool_executor(size_t numThreads = std::thread::hardware_concurrency()) : stopping(false)
+        {
+            for (size_t i = 0; i < (numThreads ? numThreads : 1); i++)
+                workers.emplace_back([this]() { work(); });
+        }
+        thread_pool_executor(const thread_pool_executor& rhs) = delete;
+        thread_pool_executor& operator = (const thread_pool_executor& rhs) = delete;
+
+        // everything already posted still gets to run
+        ~thread_pool_executor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(lockReady);
+                stopping = true;
+            }
+            notEmpty.notify_all();
+            for (auto& th : workers)
+                th.join();
+        }
+
+        void post(std::coroutine_handle<> h) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(lockReady);
+                ready.push_back(h);
+            }
+            notEmpty.notify_one();
+        }
+
+    private:
+        // a worker: resume whatever is ready until told to stop
+        void work()
+        {
+            for (;;)
+            {
+                std::coroutine_handle<> h;
+                {
+                    std::unique_lock<std::mutex> lock(lockReady);
+                    notEmpty.wait(lock, [this]() { return stopping || !ready.empty(); });
+                    if (ready.empty())
+                        return;
+                    h = ready.front();
+                    ready.pop_front();
+                }
+                h.resume();
+            }
+        }
+
+        std::mutex lockReady;                    // guards ready and stopping
+        std::condition_variable notEmpty;        // something was posted
+        list <std::coroutine_handle<>> ready;    // waiting to be resumed
+        bool stopping;                           // the destructor is waiting
+        std::vector<std::thread> workers;
+    };
+
+    /**************************************************
+     * DETACHED TASK
+     * A coroutine nobody waits for.  It runs as soon as
+     * it is called and its frame is freed when it ends
+     **************************************************/
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() noexcept { return detached_task(); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+}; // namespace custom
+
+#endif // __cpp_impl_coroutine
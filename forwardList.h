@@ -0,0 +1,618 @@
+/***********************************************************************
+ * Header:
+ *    FORWARD LIST
+ * Summary:
+ *    Our custom implementation of std::forward_list.  Each node only
+ *    carries a pNext pointer so it is one pointer smaller than the
+ *    node of custom::list, and every link update is one store cheaper.
+ *
+ *    This will contain the class definition of:
+ *        forward_list : A class that represents a singly linked list
+ *        iterator     : An iterator through forward_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <iostream>    // for nullptr
+#include <new>         // std::bad_alloc
+#include <initializer_list>
+#include <utility>
+
+class TestForwardList;  // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * FORWARD LIST
+     * Just like std::forward_list.  When hasTail is set,
+     * the list also keeps a pointer to the last node so
+     * push_back() and back() are O(1)
+     **************************************************/
+    template <typename T, bool hasTail = false>
+    class forward_list
+    {
+        friend class ::TestForwardList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        forward_list();
+        forward_list(forward_list& rhs);
+        forward_list(forward_list&& rhs);
+        forward_list(size_t num, const T& t);
+        forward_list(size_t num);
+        forward_list(const std::initializer_list<T>& il);
+        template <class Iterator>
+        forward_list(Iterator first, Iterator last);
+        ~forward_list()
+        {
+            clear();
+        }
+
+        //
+        // Assign
+        //
+
+        forward_list& operator = (forward_list& rhs);
+        forward_list& operator = (forward_list&& rhs);
+        forward_list& operator = (const std::initializer_list<T>& il);
+        void swap(forward_list& rhs);
+
+        //
+        // Iterator
+        //
+
+        class  iterator;
+        iterator before_begin() { return iterator(&head); }
+        iterator begin() { return iterator(head.pNext); }
+        iterator end() { return iterator(nullptr); }
+
+        //
+        // Access
+        //
+
+        T& front();
+        T& back();
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_front(T&& data);
+        void push_back(const T& data);
+        void push_back(T&& data);
+        iterator insert_after(iterator it, const T& data);
+        iterator insert_after(iterator it, T&& data);
+        void splice_after(iterator it, forward_list& rhs);
+        void splice_after(iterator it, forward_list& rhs, iterator itBefore);
+
+        //
+        // Remove
+        //
+
+        void pop_front();
+        void clear();
+        iterator erase_after(const iterator& it);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return numElements == 0; }
+        size_t size() const { return numElements; }
+
+    private:
+        // nested linked list classes
+        class Link;
+        class Node;
+
+        // hook a freshly allocated node in after pPrev
+        iterator link_after(Link* pPrev, Node* pNew);
+
+        // member variables
+        size_t numElements; // though we could count, it is faster to keep a variable
+        Link head;          // sentinel before the first node: head.pNext is the front
+        Node* pTail;        // last node, only maintained when hasTail is set
+    };
+
+    /*************************************************
+     * LINK
+     * The part of a node that the list walks.  The
+     * sentinel before the first element is a bare link,
+     * which is what lets before_begin() exist
+     *************************************************/
+    template <typename T, bool hasTail>
+    class forward_list <T, hasTail> ::Link
+    {
+    public:
+        Link() : pNext(nullptr) {}
+
+        Node* pNext;       // pointer to next node
+    };
+
+    /*************************************************
+     * NODE
+     * the node class.  There is no pPrev: that is the
+     * whole point of a forward list
+     *************************************************/
+    template <typename T, bool hasTail>
+    class forward_list <T, hasTail> ::Node : public forward_list <T, hasTail> ::Link
+    {
+    public:
+        //
+        // Construct
+        //
+        Node() : data() {}
+        Node(const T& data) : data(data) {}
+        Node(T&& data) : data(std::move(data)) {}
+
+        //
+        // Data
+        //
+
+        T data;             // user data
+    };
+
+    /*************************************************
+     * FORWARD LIST ITERATOR
+     * Iterate through a forward list, non-constant version
+     ************************************************/
+    template <typename T, bool hasTail>
+    class forward_list <T, hasTail> ::iterator
+    {
+        friend class ::TestForwardList; // give unit tests access to the privates
+        friend class forward_list <T, hasTail>;
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : p(nullptr) {}
+        iterator(Link* pIn) : p(pIn) {}
+        iterator(const iterator& rhs) : p(rhs.p) {}
+        iterator& operator = (const iterator& rhs)
+        {
+            p = rhs.p;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator == (const iterator& rhs) const { return p == rhs.p; }
+        bool operator != (const iterator& rhs) const { return p != rhs.p; }
+
+        // dereference operator, fetch a node.  Not valid on before_begin()
+        T& operator * ()
+        {
+            assert(p != nullptr);
+            return static_cast<Node*>(p)->data;
+        }
+
+        // postfix increment
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            p = p->pNext;
+            return temp;
+        }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            p = p->pNext;
+            return *this;
+        }
+
+    private:
+
+        Link* p;
+    };
+
+    /*****************************************
+     * FORWARD LIST :: DEFAULT constructors
+     ****************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list()
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+    }
+
+    /*****************************************
+     * FORWARD LIST :: NON-DEFAULT constructors
+     * Create a list initialized to a value
+     ****************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list(size_t num, const T& t)
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+        Link* pLast = &head;
+        for (size_t i = 0; i < num; ++i)
+            pLast = link_after(pLast, new Node(t)).p;
+    }
+
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list(size_t num)
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+        Link* pLast = &head;
+        for (size_t i = 0; i < num; ++i)
+            pLast = link_after(pLast, new Node()).p;
+    }
+
+    /*****************************************
+     * FORWARD LIST :: ITERATOR constructors
+     * Create a list initialized to a set of values
+     ****************************************/
+    template <typename T, bool hasTail>
+    template <class Iterator>
+    forward_list <T, hasTail> ::forward_list(Iterator first, Iterator last)
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+        Link* pLast = &head;
+        for (; first != last; ++first)
+            pLast = link_after(pLast, new Node(*first)).p;
+    }
+
+    /*****************************************
+     * FORWARD LIST :: INITIALIZER constructors
+     * Create a list initialized to a set of values
+     ****************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list(const std::initializer_list<T>& il)
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+        Link* pLast = &head;
+        for (const auto& x : il)
+            pLast = link_after(pLast, new Node(x)).p;
+    }
+
+    /*****************************************
+     * FORWARD LIST :: COPY constructors
+     ****************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list(forward_list& rhs)
+    {
+        numElements = 0;
+        head.pNext = pTail = nullptr;
+        Link* pLast = &head;
+        for (Node* cur = rhs.head.pNext; cur != nullptr; cur = cur->pNext)
+            pLast = link_after(pLast, new Node(cur->data)).p;
+    }
+
+    /*****************************************
+     * FORWARD LIST :: MOVE constructors
+     * Steal the values from the RHS
+     ****************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail> ::forward_list(forward_list&& rhs)
+    {
+        numElements = rhs.numElements;
+        head.pNext = rhs.head.pNext;
+        pTail = rhs.pTail;
+
+        rhs.numElements = 0;
+        rhs.head.pNext = rhs.pTail = nullptr;
+    }
+
+    /**********************************************
+     * FORWARD LIST :: assignment operator
+     * Copy one list onto another
+     *     INPUT  : a list to be copied
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail>& forward_list <T, hasTail> :: operator = (forward_list& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        forward_list tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+
+    /**********************************************
+     * FORWARD LIST :: assignment operator - MOVE
+     * Move one list onto another
+     *     INPUT  : a list to be moved
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the size of the LHS
+     *********************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail>& forward_list <T, hasTail> :: operator = (forward_list&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        swap(rhs);
+        return *this;
+    }
+
+    /**********************************************
+     * FORWARD LIST :: assignment operator
+     * Copy an initializer list onto the list
+     *     INPUT  : the values to be copied
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, bool hasTail>
+    forward_list <T, hasTail>& forward_list <T, hasTail> :: operator = (const std::initializer_list<T>& il)
+    {
+        forward_list tmp(il);
+        swap(tmp);
+        return *this;
+    }
+
+    /**********************************************
+     * FORWARD LIST :: SWAP
+     * Exchange the contents of two lists
+     *     INPUT  : the list to swap with
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::swap(forward_list& rhs)
+    {
+        std::swap(numElements, rhs.numElements);
+        std::swap(head.pNext, rhs.head.pNext);
+        std::swap(pTail, rhs.pTail);
+    }
+
+    template <typename T, bool hasTail>
+    void swap(forward_list <T, hasTail>& lhs, forward_list <T, hasTail>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /**********************************************
+     * FORWARD LIST :: CLEAR
+     * Remove all the items currently in the linked list
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::clear()
+    {
+        Node* cur = head.pNext;
+        while (cur)
+        {
+            Node* next = cur->pNext;
+            delete cur;
+            cur = next;
+        }
+
+        head.pNext = pTail = nullptr;
+        numElements = 0;
+    }
+
+    /*********************************************
+     * FORWARD LIST :: LINK AFTER
+     * Hook a new node in directly after pPrev.  This is
+     * the one place the tail pointer gets advanced
+     *    INPUT  : the link to follow, the new node
+     *    OUTPUT : iterator to the new node
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    typename forward_list <T, hasTail> ::iterator
+        forward_list <T, hasTail> ::link_after(Link* pPrev, Node* pNew)
+    {
+        pNew->pNext = pPrev->pNext;
+        pPrev->pNext = pNew;
+        if (hasTail && pNew->pNext == nullptr)
+            pTail = pNew;
+        ++numElements;
+        return iterator(pNew);
+    }
+
+    /*********************************************
+     * FORWARD LIST :: PUSH FRONT
+     * add an item to the head of the list
+     *     INPUT  : data to be added to the list
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::push_front(const T& data)
+    {
+        link_after(&head, new Node(data));
+    }
+
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::push_front(T&& data)
+    {
+        link_after(&head, new Node(std::move(data)));
+    }
+
+    /*********************************************
+     * FORWARD LIST :: PUSH BACK
+     * add an item to the end of the list.  Only
+     * available when the list keeps a tail pointer
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::push_back(const T& data)
+    {
+        static_assert(hasTail, "push_back() requires forward_list<T, true>");
+        link_after(pTail ? static_cast<Link*>(pTail) : &head, new Node(data));
+    }
+
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::push_back(T&& data)
+    {
+        static_assert(hasTail, "push_back() requires forward_list<T, true>");
+        link_after(pTail ? static_cast<Link*>(pTail) : &head, new Node(std::move(data)));
+    }
+
+    /******************************************
+     * FORWARD LIST :: INSERT AFTER
+     * add an item directly after an iterator
+     *     INPUT  : an iterator to the item before the new one
+     *              (before_begin() to insert at the front)
+     *              data to be added to the list
+     *     OUTPUT : iterator to the new item
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T, bool hasTail>
+    typename forward_list <T, hasTail> ::iterator
+        forward_list <T, hasTail> ::insert_after(iterator it, const T& data)
+    {
+        assert(it.p != nullptr);
+        return link_after(it.p, new Node(data));
+    }
+
+    template <typename T, bool hasTail>
+    typename forward_list <T, hasTail> ::iterator
+        forward_list <T, hasTail> ::insert_after(iterator it, T&& data)
+    {
+        assert(it.p != nullptr);
+        return link_after(it.p, new Node(std::move(data)));
+    }
+
+    /*********************************************
+     * FORWARD LIST :: POP FRONT
+     * remove an item from the front of the list
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::pop_front()
+    {
+        erase_after(before_begin());
+    }
+
+    /******************************************
+     * FORWARD LIST :: ERASE AFTER
+     * remove the item directly after an iterator
+     *     INPUT  : an iterator to the item before the one to remove
+     *     OUTPUT : iterator to the item following the removed one
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T, bool hasTail>
+    typename forward_list <T, hasTail> ::iterator
+        forward_list <T, hasTail> ::erase_after(const iterator& it)
+    {
+        // end(), or nothing after it
+        if (it.p == nullptr || it.p->pNext == nullptr)
+            return end();
+
+        Node* cur = it.p->pNext;
+        it.p->pNext = cur->pNext;
+        if (hasTail && cur == pTail)
+            pTail = (it.p == &head) ? nullptr : static_cast<Node*>(it.p);
+
+        delete cur;
+        --numElements;
+
+        return iterator(it.p->pNext);
+    }
+
+    /******************************************
+     * FORWARD LIST :: SPLICE AFTER
+     * move every node of rhs in after an iterator.
+     * No node is allocated or copied
+     *     INPUT  : an iterator to the item before the spliced nodes
+     *              the list to drain
+     *     OUTPUT :
+     *     COST   : O(1) with a tail pointer, otherwise O(n) of rhs
+     ******************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::splice_after(iterator it, forward_list& rhs)
+    {
+        assert(it.p != nullptr);
+        if (this == &rhs || rhs.head.pNext == nullptr)
+            return;
+
+        // find the end of the chain we are moving
+        Node* pLast = rhs.pTail;
+        if (!hasTail)
+            for (pLast = rhs.head.pNext; pLast->pNext; pLast = pLast->pNext)
+                ;
+
+        pLast->pNext = it.p->pNext;
+        it.p->pNext = rhs.head.pNext;
+        if (hasTail && pLast->pNext == nullptr)
+            pTail = pLast;
+        numElements += rhs.numElements;
+
+        rhs.head.pNext = rhs.pTail = nullptr;
+        rhs.numElements = 0;
+    }
+
+    /******************************************
+     * FORWARD LIST :: SPLICE AFTER
+     * move the single node following itBefore (in rhs)
+     * to directly after it (in this list)
+     *     INPUT  : an iterator to the item before the destination
+     *              the list owning the node
+     *              an iterator to the item before the node to move
+     *     OUTPUT :
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T, bool hasTail>
+    void forward_list <T, hasTail> ::splice_after(iterator it, forward_list& rhs,
+                                                  iterator itBefore)
+    {
+        assert(it.p != nullptr);
+        if (itBefore.p == nullptr || itBefore.p->pNext == nullptr)
+            return;
+
+        Node* pMove = itBefore.p->pNext;
+        if (it.p == itBefore.p || it.p == pMove)
+            return;
+
+        // unhook from rhs
+        itBefore.p->pNext = pMove->pNext;
+        if (hasTail && pMove == rhs.pTail)
+            rhs.pTail = (itBefore.p == &rhs.head) ? nullptr : static_cast<Node*>(itBefore.p);
+        --rhs.numElements;
+
+        // hook into this list
+        link_after(it.p, pMove);
+    }
+
+    /*********************************************
+     * FORWARD LIST :: FRONT
+     * retrieves the first element in the list
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    T& forward_list <T, hasTail> ::front()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return head.pNext->data;
+    }
+
+    /*********************************************
+     * FORWARD LIST :: BACK
+     * retrieves the last element in the list.  Only
+     * available when the list keeps a tail pointer
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, bool hasTail>
+    T& forward_list <T, hasTail> ::back()
+    {
+        static_assert(hasTail, "back() requires forward_list<T, true>");
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return pTail->data;
+    }
+
+}; // namespace custom
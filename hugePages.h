@@ -0,0 +1,193 @@
+/***********************************************************************
+ * Header:
+ *    HUGE PAGES
+ * Summary:
+ *    Large regions of memory for nodes, backed by transparent huge
+ *    pages where the system has them.  A region is reserved with mmap,
+ *    aligned to a 2 MiB boundary so the kernel can back it with huge
+ *    pages, and then madvise(MADV_HUGEPAGE) asks it to.  One huge page
+ *    covers what would otherwise take 512 TLB entries, so walking a
+ *    large list misses the TLB far less often.
+ *
+ *    Where there is no mmap, or it fails, the region comes from the
+ *    ordinary heap instead.  Where mmap works but huge pages are turned
+ *    off, the region is still mapped, just with normal pages.  Either
+ *    way the caller gets usable memory; the region says what it got.
+ *
+ *    This will contain the class definition of:
+ *        huge_pages : Allocate and free huge-page regions
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <atomic>      // for std::atomic
+#include <cstdint>     // for uintptr_t
+#include <fstream>     // for std::ifstream
+#include <new>         // for operator new
+#include <string>      // for std::string
+#if defined(__linux__)
+#include <sys/mman.h>  // for mmap, madvise
+#endif
+
+class TestHugePages;   // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * HUGE PAGES
+     * allocate() a region, deallocate() it when done
+     **************************************************/
+    class huge_pages
+    {
+        friend class ::TestHugePages; // give unit tests access to the privates
+    public:
+        static const size_t pageSize = 2 * 1024 * 1024;
+
+        // a piece of memory, and how it was obtained
+        struct region
+        {
+            void* p;         // the memory
+            size_t bytes;    // how much of it there is
+            bool mapped;     // from mmap, else from the heap
+            bool advised;    // the kernel agreed to back it with huge pages
+        };
+
+        // what has been handed out so far
+        struct stats
+        {
+            size_t regions;      // allocate() calls
+            size_t mapped;       // ... that got an mmap region
+            size_t advised;      // ... that got huge pages, too
+            size_t fallbacks;    // ... that had to use the heap
+        };
+
+        static region allocate(size_t bytes);
+        static void deallocate(const region& r);
+        static bool available();
+        static stats get_stats();
+
+    private:
+        static region fromHeap(size_t bytes);
+
+        static std::atomic<size_t>& counter(size_t i)
+        {
+            static std::atomic<size_t> counters[4];
+            return counters[i];
+        }
+    };
+
+    /*********************************************
+     * HUGE PAGES :: AVAILABLE
+     * Will the kernel give us transparent huge pages
+     * when we ask?  Only "never" says no
+     *    INPUT  :
+     *    OUTPUT : true if madvise(MADV_HUGEPAGE) can work
+     *    COST   : one small file read
+     *********************************************/
+    inline bool huge_pages::available()
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        std::ifstream fin("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string setting;
+        if (!std::getline(fin, setting))
+            return false;
+        return setting.find("[never]") == std::string::npos;
+#else
+        return false;
+#endif
+    }
+
+    /*********************************************
+     * HUGE PAGES :: ALLOCATE
+     * Map a region on a huge-page boundary and ask for
+     * huge pages, falling back as far as we must
+     *    INPUT  : how many bytes
+     *    OUTPUT : the region, which may hold more than asked
+     *    COST   : a system call or two
+     *********************************************/
+    inline huge_pages::region huge_pages::allocate(size_t bytes)
+    {
+        counter(0)++;
+#if defined(__linux__)
+        // round up, and map one page extra so we can trim to a boundary
+        size_t size = (bytes + pageSize - 1) / pageSize * pageSize;
+        size_t extra = size + pageSize;
+        void* pMap = mmap(nullptr, extra, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pMap == MAP_FAILED)
+        {
+            counter(3)++;
+            return fromHeap(bytes);
+        }
+
+        uintptr_t begin = reinterpret_cast<uintptr_t>(pMap);
+        uintptr_t aligned = (begin + pageSize - 1) / pageSize * pageSize;
+        if (aligned > begin)
+            munmap(pMap, aligned - begin);
+        if (aligned + size < begin + extra)
+            munmap(reinterpret_cast<void*>(aligned + size), begin + extra - (aligned + size));
+
+        region r = { reinterpret_cast<void*>(aligned), size, true, false };
+        counter(1)++;
+#if defined(MADV_HUGEPAGE)
+        if (madvise(r.p, r.bytes, MADV_HUGEPAGE) == 0)
+        {
+            r.advised = true;
+            counter(2)++;
+        }
+#endif
+        return r;
+#else
+        counter(3)++;
+        return fromHeap(bytes);
+#endif
+    }
+
+    /*********************************************
+     * HUGE PAGES :: FROM HEAP
+     * The last resort: ordinary memory
+     *    INPUT  : how many bytes
+     *    OUTPUT : the region
+     *    COST   : one operator new
+     *********************************************/
+    inline huge_pages::region huge_pages::fromHeap(size_t bytes)
+    {
+        region r = { ::operator new(bytes), bytes, false, false };
+        return r;
+    }
+
+    /*********************************************
+     * HUGE PAGES :: DEALLOCATE
+     * Give a region back the way it came
+     *    INPUT  : the region from allocate()
+     *    OUTPUT :
+     *    COST   : a system call
+     *********************************************/
+    inline void huge_pages::deallocate(const region& r)
+    {
+#if defined(__linux__)
+        if (r.mapped)
+        {
+            munmap(r.p, r.bytes);
+            return;
+        }
+#endif
+        ::operator delete(r.p);
+    }
+
+    /*********************************************
+     * HUGE PAGES :: STATS
+     * How allocate() has fared
+     *    INPUT  :
+     *    OUTPUT : the counts
+     *    COST   : O(1)
+     *********************************************/
+    inline huge_pages::stats huge_pages::get_stats()
+    {
+        stats s = { counter(0).load(), counter(1).load(), counter(2).load(), counter(3).load() };
+        return s;
+    }
+
+}; // namespace custom
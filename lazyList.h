@@ -0,0 +1,603 @@
+/***********************************************************************
+ * Header:
+ *    LAZY LIST
+ * Summary:
+ *    A list whose fill constructors cost O(1).  list(num, t) makes num
+ *    nodes up front, though a list of preallocated slots is mostly
+ *    never touched.  Here every node carries a count: a node with a
+ *    count of 1 is an ordinary item, and one with a count of num is a
+ *    run of num copies of the same item.  So lazy_list(10000000, t) is
+ *    one node.
+ *
+ *    Reading never changes the runs: const_iterator walks a run slot
+ *    by slot.  Writing through an iterator, front() or back() splits
+ *    the run around that one slot, so only the slots written to ever
+ *    become nodes of their own.  insert() splits a run in two, and
+ *    erasing from a run or popping from its end just shrinks it.
+ *    Splitting a run invalidates other iterators into that run.
+ *
+ *    This will contain the class definition of:
+ *        lazy_list                 : The list
+ *        lazy_list::iterator       : Splits runs as it is written through
+ *        lazy_list::const_iterator : Reads runs as they are
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for assert
+#include <initializer_list>
+#include <utility>     // for std::move
+
+class TestLazyList;    // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * LAZY LIST
+     * Just like custom::list, with runs of equal items
+     * kept as one node until they are written to
+     **************************************************/
+    template <typename T>
+    class lazy_list
+    {
+        friend class ::TestLazyList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        lazy_list() : numElements(0), pHead(nullptr), pTail(nullptr) {}
+        lazy_list(lazy_list& rhs);
+        lazy_list(lazy_list&& rhs);
+        lazy_list(size_t num, const T& t);
+        lazy_list(size_t num);
+        lazy_list(const std::initializer_list<T>& il);
+        ~lazy_list()
+        {
+            clear();
+        }
+
+        //
+        // Assign
+        //
+
+        lazy_list& operator = (lazy_list& rhs);
+        lazy_list& operator = (lazy_list&& rhs);
+        lazy_list& operator = (const std::initializer_list<T>& il);
+        void swap(lazy_list& rhs);
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        class const_iterator;
+        iterator begin() { return iterator(this, pHead, 0); }
+        iterator rbegin() { return iterator(this, pTail, pTail ? pTail->count - 1 : 0); }
+        iterator end() { return iterator(this, nullptr, 0); }
+        const_iterator cbegin() const { return const_iterator(pHead, 0); }
+        const_iterator cend() const { return const_iterator(nullptr, 0); }
+
+        //
+        // Access
+        //
+
+        T& front();
+        T& back();
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_front(T&& data);
+        void push_back(const T& data);
+        void push_back(T&& data);
+        iterator insert(iterator it, const T& data);
+        iterator insert(iterator it, T&& data);
+
+        //
+        // Remove
+        //
+
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator erase(const iterator& it);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return numElements == 0; }
+        size_t size() const { return numElements; }
+
+    private:
+        // nested linked list class
+        class Node;
+
+        Node* materialize(Node* p, size_t i);
+        Node* splitBefore(Node* p, size_t i);
+        void linkBefore(Node* pNew, Node* pNext);
+        void unlink(Node* p);
+
+        // member variables
+        size_t numElements; // items, counting every slot of every run
+        Node* pHead;        // pointer to the beginning of the list
+        Node* pTail;        // pointer to the ending of the list
+    };
+
+    /*************************************************
+     * NODE
+     * count copies of data.  Almost always just one
+     *************************************************/
+    template <typename T>
+    class lazy_list <T> ::Node
+    {
+    public:
+        Node(const T& data, size_t count = 1) : data(data), count(count), pNext(nullptr), pPrev(nullptr) {}
+        Node(T&& data) : data(std::move(data)), count(1), pNext(nullptr), pPrev(nullptr) {}
+
+        T data;             // user data, once for the whole run
+        size_t count;       // how many slots this node stands for
+        Node* pNext;        // pointer to next node
+        Node* pPrev;        // pointer to previous node
+    };
+
+    /*************************************************
+     * LAZY LIST ITERATOR
+     * A node and a slot in it.  Dereferencing a slot of
+     * a run gives that slot a node of its own
+     ************************************************/
+    template <typename T>
+    class lazy_list <T> ::iterator
+    {
+        friend class ::TestLazyList; // give unit tests access to the privates
+        friend class lazy_list <T>;
+    public:
+        iterator() : pList(nullptr), p(nullptr), i(0) {}
+
+        bool operator == (const iterator& rhs) const { return p == rhs.p && i == rhs.i; }
+        bool operator != (const iterator& rhs) const { return !(*this == rhs); }
+
+        T& operator * ()
+        {
+            assert(p != nullptr);
+            p = pList->materialize(p, i);
+            i = 0;
+            return p->data;
+        }
+
+        iterator& operator ++ ()
+        {
+            if (i + 1 < p->count)
+                i++;
+            else
+            {
+                p = p->pNext;
+                i = 0;
+            }
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        iterator& operator -- ()
+        {
+            if (i > 0)
+                i--;
+            else
+            {
+                p = p->pPrev;
+                i = p ? p->count - 1 : 0;
+            }
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        iterator(lazy_list* pList, Node* p, size_t i) : pList(pList), p(p), i(i) {}
+
+        lazy_list* pList;
+        Node* p;
+        size_t i;           // which slot of p's run
+    };
+
+    /*************************************************
+     * LAZY LIST CONST ITERATOR
+     * Reads the runs as they are, allocating nothing
+     ************************************************/
+    template <typename T>
+    class lazy_list <T> ::const_iterator
+    {
+        friend class ::TestLazyList; // give unit tests access to the privates
+        friend class lazy_list <T>;
+    public:
+        const_iterator() : p(nullptr), i(0) {}
+
+        bool operator == (const const_iterator& rhs) const { return p == rhs.p && i == rhs.i; }
+        bool operator != (const const_iterator& rhs) const { return !(*this == rhs); }
+
+        const T& operator * () const
+        {
+            assert(p != nullptr);
+            return p->data;
+        }
+
+        const_iterator& operator ++ ()
+        {
+            if (i + 1 < p->count)
+                i++;
+            else
+            {
+                p = p->pNext;
+                i = 0;
+            }
+            return *this;
+        }
+        const_iterator operator ++ (int postfix)
+        {
+            const_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+    private:
+        const_iterator(const Node* p, size_t i) : p(p), i(i) {}
+
+        const Node* p;
+        size_t i;
+    };
+
+    /*****************************************
+     * LAZY LIST :: FILL constructors
+     * One run, however many items
+     ****************************************/
+    template <typename T>
+    lazy_list <T> ::lazy_list(size_t num, const T& t) : numElements(0), pHead(nullptr), pTail(nullptr)
+    {
+        if (num == 0)
+            return;
+        pHead = pTail = new Node(t, num);
+        numElements = num;
+    }
+
+    template <typename T>
+    lazy_list <T> ::lazy_list(size_t num) : numElements(0), pHead(nullptr), pTail(nullptr)
+    {
+        if (num == 0)
+            return;
+        pHead = pTail = new Node(T(), num);
+        numElements = num;
+    }
+
+    /*****************************************
+     * LAZY LIST :: INITIALIZER constructor
+     ****************************************/
+    template <typename T>
+    lazy_list <T> ::lazy_list(const std::initializer_list<T>& il) : numElements(0), pHead(nullptr), pTail(nullptr)
+    {
+        for (const auto& x : il)
+            push_back(x);
+    }
+
+    /*****************************************
+     * LAZY LIST :: COPY constructor
+     * The runs are copied as runs
+     ****************************************/
+    template <typename T>
+    lazy_list <T> ::lazy_list(lazy_list& rhs) : numElements(0), pHead(nullptr), pTail(nullptr)
+    {
+        for (Node* p = rhs.pHead; p != nullptr; p = p->pNext)
+        {
+            linkBefore(new Node(p->data, p->count), nullptr);
+            numElements += p->count;
+        }
+    }
+
+    /*****************************************
+     * LAZY LIST :: MOVE constructor
+     ****************************************/
+    template <typename T>
+    lazy_list <T> ::lazy_list(lazy_list&& rhs) :
+        numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
+    {
+        rhs.numElements = 0;
+        rhs.pHead = rhs.pTail = nullptr;
+    }
+
+    /**********************************************
+     * LAZY LIST :: assignment operators
+     *     INPUT  : a list to be copied or moved, or the items
+     *     OUTPUT :
+     *     COST   : O(nodes)
+     *********************************************/
+    template <typename T>
+    lazy_list <T>& lazy_list <T> ::operator = (lazy_list& rhs)
+    {
+        if (this != &rhs)
+        {
+            lazy_list copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    lazy_list <T>& lazy_list <T> ::operator = (lazy_list&& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    lazy_list <T>& lazy_list <T> ::operator = (const std::initializer_list<T>& il)
+    {
+        lazy_list copy(il);
+        swap(copy);
+        return *this;
+    }
+
+    /**********************************************
+     * LAZY LIST :: SWAP
+     *     INPUT  : the list to swap with
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void lazy_list <T> ::swap(lazy_list& rhs)
+    {
+        std::swap(numElements, rhs.numElements);
+        std::swap(pHead, rhs.pHead);
+        std::swap(pTail, rhs.pTail);
+    }
+
+    template <typename T>
+    void swap(lazy_list <T>& lhs, lazy_list <T>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /******************************************
+     * LAZY LIST :: LINK BEFORE and UNLINK
+     * hook a node in front of pNext (nullptr is the
+     * end), or take one out.  Counts are the caller's
+     *     INPUT  : the node, and where it goes
+     *     OUTPUT :
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    void lazy_list <T> ::linkBefore(Node* pNew, Node* pNext)
+    {
+        Node* pPrev = pNext ? pNext->pPrev : pTail;
+        pNew->pNext = pNext;
+        pNew->pPrev = pPrev;
+        if (pPrev)
+            pPrev->pNext = pNew;
+        else
+            pHead = pNew;
+        if (pNext)
+            pNext->pPrev = pNew;
+        else
+            pTail = pNew;
+    }
+
+    template <typename T>
+    void lazy_list <T> ::unlink(Node* p)
+    {
+        if (p->pPrev)
+            p->pPrev->pNext = p->pNext;
+        else
+            pHead = p->pNext;
+        if (p->pNext)
+            p->pNext->pPrev = p->pPrev;
+        else
+            pTail = p->pPrev;
+    }
+
+    /******************************************
+     * LAZY LIST :: SPLIT BEFORE
+     * cut a run so that slot i starts a node
+     *     INPUT  : the run, the slot
+     *     OUTPUT : the node now starting at slot i
+     *     COST   : O(1), one allocation if i is inside the run
+     ******************************************/
+    template <typename T>
+    typename lazy_list <T> ::Node* lazy_list <T> ::splitBefore(Node* p, size_t i)
+    {
+        assert(i < p->count);
+        if (i == 0)
+            return p;
+        Node* pRest = new Node(p->data, p->count - i);
+        linkBefore(pRest, p->pNext);
+        p->count = i;
+        return pRest;
+    }
+
+    /******************************************
+     * LAZY LIST :: MATERIALIZE
+     * give slot i of a run a node of its own, so it can
+     * be written without changing its neighbors
+     *     INPUT  : the run, the slot
+     *     OUTPUT : the node holding just that slot
+     *     COST   : O(1), at most two allocations
+     ******************************************/
+    template <typename T>
+    typename lazy_list <T> ::Node* lazy_list <T> ::materialize(Node* p, size_t i)
+    {
+        p = splitBefore(p, i);
+        if (p->count > 1)
+            splitBefore(p, 1);
+        return p;
+    }
+
+    /*********************************************
+     * LAZY LIST :: FRONT and BACK
+     * the first or last item, ready to be written
+     *     INPUT  :
+     *     OUTPUT : the item
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    T& lazy_list <T> ::front()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return materialize(pHead, 0)->data;
+    }
+
+    template <typename T>
+    T& lazy_list <T> ::back()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return materialize(pTail, pTail->count - 1)->data;
+    }
+
+    /*********************************************
+     * LAZY LIST :: PUSH BACK and PUSH FRONT
+     * add an item at one end
+     *     INPUT  : the item
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void lazy_list <T> ::push_back(const T& data)
+    {
+        linkBefore(new Node(data), nullptr);
+        numElements++;
+    }
+
+    template <typename T>
+    void lazy_list <T> ::push_back(T&& data)
+    {
+        linkBefore(new Node(std::move(data)), nullptr);
+        numElements++;
+    }
+
+    template <typename T>
+    void lazy_list <T> ::push_front(const T& data)
+    {
+        linkBefore(new Node(data), pHead);
+        numElements++;
+    }
+
+    template <typename T>
+    void lazy_list <T> ::push_front(T&& data)
+    {
+        linkBefore(new Node(std::move(data)), pHead);
+        numElements++;
+    }
+
+    /******************************************
+     * LAZY LIST :: INSERT
+     * add an item before it.  Inside a run, the run is
+     * split in two around the new node
+     *     INPUT  : where, and the item
+     *     OUTPUT : iterator to the new item
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    typename lazy_list <T> ::iterator lazy_list <T> ::insert(iterator it, const T& data)
+    {
+        T copy(data);
+        return insert(it, std::move(copy));
+    }
+
+    template <typename T>
+    typename lazy_list <T> ::iterator lazy_list <T> ::insert(iterator it, T&& data)
+    {
+        Node* pNext = it.p ? splitBefore(it.p, it.i) : nullptr;
+        Node* pNew = new Node(std::move(data));
+        linkBefore(pNew, pNext);
+        numElements++;
+        return iterator(this, pNew, 0);
+    }
+
+    /******************************************
+     * LAZY LIST :: ERASE
+     * remove an item.  From a run, that is one less copy
+     *     INPUT  : the item to remove
+     *     OUTPUT : iterator to the item after it
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    typename lazy_list <T> ::iterator lazy_list <T> ::erase(const iterator& it)
+    {
+        Node* p = it.p;
+        if (p == nullptr)
+            return end();
+        numElements--;
+
+        // every slot of a run is the same, so drop the last
+        if (p->count > 1)
+        {
+            p->count--;
+            if (it.i < p->count)
+                return iterator(this, p, it.i);
+            return iterator(this, p->pNext, 0);
+        }
+
+        Node* pNext = p->pNext;
+        unlink(p);
+        delete p;
+        return iterator(this, pNext, 0);
+    }
+
+    /*********************************************
+     * LAZY LIST :: POP BACK and POP FRONT
+     * remove the last or first item, if there is one
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void lazy_list <T> ::pop_back()
+    {
+        if (pTail)
+            erase(iterator(this, pTail, pTail->count - 1));
+    }
+
+    template <typename T>
+    void lazy_list <T> ::pop_front()
+    {
+        if (pHead)
+            erase(begin());
+    }
+
+    /*********************************************
+     * LAZY LIST :: CLEAR
+     * remove every item
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(nodes)
+     *********************************************/
+    template <typename T>
+    void lazy_list <T> ::clear()
+    {
+        while (pHead)
+        {
+            Node* pNext = pHead->pNext;
+            delete pHead;
+            pHead = pNext;
+        }
+        pTail = nullptr;
+        numElements = 0;
+    }
+
+}; // namespace custom
@@ -11,9 +11,13 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *
+ *    Built as C++20, the list can be used in constant expressions,
+ *    and freeze() keeps one built at compile time.
+ *
  *    This will contain the class definition of:
  *        List         : A class that represents a List
  *        ListIterator : An iterator through List
+ *        frozen_list  : The items of a list built at compile time
  * Author
  *    Michael Johnson, Brayden Jones, James Gassaway
  ************************************************************************/
@@ -25,13 +29,650 @@
 #include <memory>      // for std::allocator
 #include <initializer_list>
 #include <utility>
+#include <atomic>      // for std::atomic
+#include <cstddef>     // for std::max_align_t
+#include <cstdint>     // for uintptr_t
+#include <algorithm>   // for std::sort
+#include <vector>      // for std::vector
+#include <typeinfo>    // for typeid
+#include <type_traits> // for std::is_trivially_copyable
+#include "hugePages.h"  // for huge_pages
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>  // for _mm_prefetch
+#endif
+
+// C++20 can run new and delete at compile time.  There, the list's
+// members are constexpr; elsewhere these expand to nothing
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define CUSTOM_LIST_HAS_CONSTEXPR 1
+#define CUSTOM_LIST_CONSTEXPR constexpr
+#define CUSTOM_LIST_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define CUSTOM_LIST_HAS_CONSTEXPR 0
+#define CUSTOM_LIST_CONSTEXPR
+#define CUSTOM_LIST_CONSTANT_EVALUATED() false
+#endif
 
 class TestList;        // forward declaration for unit tests
 class TestHash;        // to be used later
+class TestHugePages;
 
 namespace custom
 {
 
+    /**************************************************
+     * PREFETCH
+     * Hint that a line will be read soon.  Does nothing
+     * where the compiler has no way to say it
+     **************************************************/
+    inline void prefetch(const void* p)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p, 0 /* read */, 3 /* keep in all levels */);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch((const char*)p, _MM_HINT_T0);
+#else
+        (void)p;
+#endif
+    }
+
+    /**************************************************
+     * NODE BLOCKS
+     * Blocks of nodes laid out side by side, as
+     * list::compact() and bulk copies make them.  Nodes
+     * in a block were not made with new, so they must not
+     * be freed with delete.  A block takes whole 4 KiB
+     * pages that nothing else shares, and a page map says
+     * which block owns each page, so a node finds its
+     * block from its address alone and needs no pointer
+     * to it.  The block counts its live nodes, so the
+     * nodes can be spliced or mailed into other lists and
+     * still find their way home.  A block is freed once
+     * the last of its nodes is released.  While no block
+     * exists, freeing a node never looks at the map.
+     *
+     * With use_huge_pages() on, a block of a huge page or
+     * more is mapped from huge_pages rather than the heap.
+     *
+     * With use_arena() on, ordinary nodes are not made
+     * with new either: each thread carves them one after
+     * another out of blocks filling one huge page.  A node
+     * freed, on any thread, goes on its block's free list,
+     * and the thread that carved it takes those slots
+     * before carving fresh ones.  When its block is used
+     * up, the thread moves to another of its blocks with a
+     * quarter or more free before it makes a new one, and
+     * gives back all but one of the blocks that have
+     * emptied.  So what a thread holds stays near the most
+     * nodes it has had alive at once, however long it
+     * churns.  A thread holds its blocks until it ends or
+     * its arena is flushed; after that, a block is freed
+     * with the last of its nodes, and its free slots wait
+     **************************************************/
+    class node_blocks
+    {
+    public:
+        // a released slot, linked through the slot itself
+        struct slot
+        {
+            slot* pNext;
+        };
+
+        // the header in front of the nodes of a block
+        struct block
+        {
+            std::atomic<size_t> numLive;  // nodes not yet released, plus an arena's hold
+            size_t numNodes;              // how many the block was made with
+            size_t numBytes;              // the whole pages it covers, header and all
+            huge_pages::region memory;    // where the block came from
+            bool reusable;                // carved by an arena, so freed slots are kept
+            std::atomic<slot*> pFree;     // ... on this list, for the arena to take
+        };
+
+        // one thread's blocks, carved a node at a time
+        class arena
+        {
+        public:
+            explicit arena(size_t nodeSize) : nodeSize(nodeSize), pBlock(nullptr),
+                                              pNext(nullptr), numLeft(0), pLocal(nullptr) {}
+            ~arena() { flush(); }
+            void* carve(block*& pOwner);
+            void flush();
+        private:
+            void refill();
+
+            size_t nodeSize;           // how big each slot is
+            block* pBlock;             // the block being carved, if any
+            char* pNext;               // its next slot never carved
+            size_t numLeft;            // ... and how many follow it
+            slot* pLocal;              // slots taken back from its free list
+            std::vector<block*> held;  // every block this thread holds, pBlock too
+        };
+
+        static block* allocate(size_t numNodes, size_t nodeSize);
+        static void deallocate(block* pBlock);
+        static void release(block* pBlock, size_t numNodes = 1);
+        static void recycle(block* pBlock, slot* pFirst, slot* pLast, size_t numNodes);
+        static void recycle(block* pBlock, void* p)
+        {
+            slot* pSlot = toSlot(p, nullptr);
+            recycle(pBlock, pSlot, pSlot, 1);
+        }
+
+        // the memory of a destroyed node, as a free slot
+        static slot* toSlot(void* p, slot* pNext)
+        {
+            return new (p) slot{ pNext };
+        }
+
+        // where the nodes of a block begin
+        static void* nodes(block* pBlock)
+        {
+            return reinterpret_cast<char*>(pBlock) + headerSize;
+        }
+
+        // which block a node was placed in, or nullptr if it came from new
+        static block* owner(const void* p);
+
+        // how big a block of numNodes nodes is, header and all, in whole pages
+        static size_t bytes(size_t numNodes, size_t nodeSize)
+        {
+            return (headerSize + numNodes * nodeSize + mapPageSize - 1) / mapPageSize * mapPageSize;
+        }
+
+        // how many blocks are alive, across all lists
+        static size_t size() { return numBlocks().load(std::memory_order_acquire); }
+
+        // should big blocks come from huge pages?
+        static void use_huge_pages(bool on = true) { hugePages().store(on); }
+        static bool uses_huge_pages() { return hugePages().load(); }
+
+        // should ordinary nodes be carved from an arena?
+        static void use_arena(bool on = true) { arenas().store(on, std::memory_order_relaxed); }
+        static bool uses_arena() { return arenas().load(std::memory_order_relaxed); }
+
+        // what a single allocation of this size really costs on a typical
+        // heap: a header word, rounded up to the heap's alignment
+        static size_t footprint(size_t bytes)
+        {
+            const size_t align = 2 * sizeof(void*);
+            size_t total = (bytes + sizeof(void*) + align - 1) & ~(align - 1);
+            return total < 2 * align ? 2 * align : total;
+        }
+
+    private:
+        // the header, rounded up so the nodes after it are aligned
+        static const size_t headerSize = (sizeof(block) + alignof(std::max_align_t) - 1) /
+                                         alignof(std::max_align_t) * alignof(std::max_align_t);
+
+        static block* place(size_t numNodes, size_t nodeSize, bool huge);
+        static huge_pages::region fromHeap(size_t numBytes);
+        static void toHeap(const huge_pages::region& memory);
+
+        // the page map: three levels, each indexed by mapBits of the page
+        // number.  Levels are made the first time a block needs them and
+        // kept for good, so a lookup never meets one being freed
+        static const size_t mapPageSize = 4096;
+        static const size_t mapBits = 12;
+        static const size_t mapFanout = size_t(1) << mapBits;
+        struct mapLeaf   { std::atomic<block*> owners[mapFanout]; };
+        struct mapMiddle { std::atomic<mapLeaf*> leaves[mapFanout]; };
+        static std::atomic<mapMiddle*>* mapRoot()
+        {
+            static std::atomic<mapMiddle*> root[mapFanout];
+            return root;
+        }
+        static mapLeaf* leafFor(uintptr_t page);
+        static void mark(block* pBlock, block* pOwner);
+
+        // only touched when a block is made or freed
+        static std::atomic<size_t>& numBlocks()
+        {
+            static std::atomic<size_t> num(0);
+            return num;
+        }
+        static std::atomic<bool>& hugePages()
+        {
+            static std::atomic<bool> on(false);
+            return on;
+        }
+        static std::atomic<bool>& arenas()
+        {
+            static std::atomic<bool> on(false);
+            return on;
+        }
+    };
+
+    /*********************************************
+     * NODE BLOCKS :: ALLOCATE
+     * Raw memory for numNodes nodes, all counted as live.
+     * Big blocks come from huge pages if we were asked to
+     *    INPUT  : how many nodes, how big each is
+     *    OUTPUT : the block; its nodes are uninitialized
+     *    COST   : O(1)
+     *********************************************/
+    inline node_blocks::block* node_blocks::allocate(size_t numNodes, size_t nodeSize)
+    {
+        return place(numNodes, nodeSize,
+                     uses_huge_pages() && bytes(numNodes, nodeSize) >= huge_pages::pageSize);
+    }
+
+    // from huge_pages, or from the heap, and entered in the page map
+    inline node_blocks::block* node_blocks::place(size_t numNodes, size_t nodeSize, bool huge)
+    {
+        size_t numBytes = bytes(numNodes, nodeSize);
+        huge_pages::region memory = { nullptr, numBytes, false, false };
+        if (huge)
+            memory = huge_pages::allocate(numBytes);
+        if (!memory.mapped)
+        {
+            // huge_pages falls back on plain new, which is not page aligned
+            if (memory.p != nullptr)
+                huge_pages::deallocate(memory);
+            memory = fromHeap(numBytes);
+        }
+
+        uintptr_t begin = reinterpret_cast<uintptr_t>(memory.p);
+        block* pBlock = reinterpret_cast<block*>((begin + mapPageSize - 1) / mapPageSize * mapPageSize);
+        pBlock->numLive.store(numNodes, std::memory_order_relaxed);
+        pBlock->numNodes = numNodes;
+        pBlock->numBytes = numBytes;
+        pBlock->memory = memory;
+        pBlock->reusable = false;
+        pBlock->pFree.store(nullptr, std::memory_order_relaxed);
+        numBlocks()++;
+        mark(pBlock, pBlock);
+        return pBlock;
+    }
+
+    // whole pages from the heap, so no node made with new shares one
+    inline huge_pages::region node_blocks::fromHeap(size_t numBytes)
+    {
+#if defined(__cpp_aligned_new)
+        huge_pages::region memory = { ::operator new(numBytes, std::align_val_t(mapPageSize)),
+                                      numBytes, false, false };
+#else
+        huge_pages::region memory = { ::operator new(numBytes + mapPageSize - 1),
+                                      numBytes + mapPageSize - 1, false, false };
+#endif
+        return memory;
+    }
+
+    inline void node_blocks::toHeap(const huge_pages::region& memory)
+    {
+#if defined(__cpp_aligned_new)
+        ::operator delete(memory.p, std::align_val_t(mapPageSize));
+#else
+        ::operator delete(memory.p);
+#endif
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: DEALLOCATE
+     * Give back a whole block at once, whatever is live
+     *    INPUT  : the block from allocate()
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    inline void node_blocks::deallocate(block* pBlock)
+    {
+        huge_pages::region memory = pBlock->memory;
+        mark(pBlock, nullptr);
+        numBlocks()--;
+        if (memory.mapped)
+            huge_pages::deallocate(memory);
+        else
+            toHeap(memory);
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: OWNER
+     * Which block holds this node?  A page owned by a
+     * block holds nothing else, and a live node keeps its
+     * block and so its pages in the map, so the answer
+     * cannot change under us
+     *    INPUT  : the node
+     *    OUTPUT : its block, or nullptr if it came from new
+     *    COST   : O(1): one load while no block exists, else four
+     *********************************************/
+    inline node_blocks::block* node_blocks::owner(const void* p)
+    {
+        if (size() == 0)
+            return nullptr;
+        uintptr_t page = reinterpret_cast<uintptr_t>(p) / mapPageSize;
+        if ((page >> (2 * mapBits)) >= mapFanout)
+            return nullptr;   // above anything the map covers
+        mapMiddle* pMiddle = mapRoot()[page >> (2 * mapBits)].load(std::memory_order_acquire);
+        if (pMiddle == nullptr)
+            return nullptr;
+        mapLeaf* pLeaf = pMiddle->leaves[(page >> mapBits) % mapFanout].load(std::memory_order_acquire);
+        if (pLeaf == nullptr)
+            return nullptr;
+        return pLeaf->owners[page % mapFanout].load(std::memory_order_acquire);
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: MARK
+     * Say who owns every page of a block: the block as it
+     * is placed, nobody as it is freed.  Levels of the map
+     * missing along the way are made here
+     *    INPUT  : the block, its new owner
+     *    OUTPUT :
+     *    COST   : O(pages in the block)
+     *********************************************/
+    inline void node_blocks::mark(block* pBlock, block* pOwner)
+    {
+        uintptr_t first = reinterpret_cast<uintptr_t>(pBlock) / mapPageSize;
+        for (uintptr_t page = first; page < first + pBlock->numBytes / mapPageSize; page++)
+            leafFor(page)->owners[page % mapFanout].store(pOwner, std::memory_order_release);
+    }
+
+    // the leaf of the map covering this page, made if need be
+    inline node_blocks::mapLeaf* node_blocks::leafFor(uintptr_t page)
+    {
+        assert((page >> (2 * mapBits)) < mapFanout);
+        std::atomic<mapMiddle*>& middle = mapRoot()[page >> (2 * mapBits)];
+        mapMiddle* pMiddle = middle.load(std::memory_order_acquire);
+        if (pMiddle == nullptr)
+        {
+            mapMiddle* pNew = new mapMiddle();
+            if (middle.compare_exchange_strong(pMiddle, pNew, std::memory_order_acq_rel))
+                pMiddle = pNew;
+            else
+                delete pNew;   // another thread made it first
+        }
+
+        std::atomic<mapLeaf*>& leaf = pMiddle->leaves[(page >> mapBits) % mapFanout];
+        mapLeaf* pLeaf = leaf.load(std::memory_order_acquire);
+        if (pLeaf == nullptr)
+        {
+            mapLeaf* pNew = new mapLeaf();
+            if (leaf.compare_exchange_strong(pLeaf, pNew, std::memory_order_acq_rel))
+                pLeaf = pNew;
+            else
+                delete pNew;
+        }
+        return pLeaf;
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: RELEASE
+     * Nodes of this block have been destroyed.  Count
+     * them as gone, and free the block if they were the
+     * last.  The nodes may have been released from
+     * different threads
+     *    INPUT  : the block, how many of its nodes
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    inline void node_blocks::release(block* pBlock, size_t numNodes)
+    {
+        size_t numBefore = pBlock->numLive.fetch_sub(numNodes, std::memory_order_acq_rel);
+        assert(numBefore >= numNodes);
+        if (numBefore == numNodes)
+            deallocate(pBlock);
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: RECYCLE
+     * Nodes of this block have been destroyed.  If an
+     * arena carved the block, their slots go on its free
+     * list first, so the arena can carve them again.  The
+     * slots are pushed before they stop counting as live,
+     * so the block cannot be freed under the push
+     *    INPUT  : the block, a chain of its slots, how long
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    inline void node_blocks::recycle(block* pBlock, slot* pFirst, slot* pLast, size_t numNodes)
+    {
+        if (pBlock->reusable)
+        {
+            slot* pTop = pBlock->pFree.load(std::memory_order_relaxed);
+            do
+                pLast->pNext = pTop;
+            while (!pBlock->pFree.compare_exchange_weak(pTop, pFirst, std::memory_order_release,
+                                                        std::memory_order_relaxed));
+        }
+        release(pBlock, numNodes);
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: ARENA :: CARVE
+     * The next slot: one freed back to this block first,
+     * else one never carved, else one from another block
+     *    INPUT  :
+     *    OUTPUT : the slot, uninitialized, and its block
+     *    COST   : O(1), but O(blocks held) when the block runs out
+     *********************************************/
+    inline void* node_blocks::arena::carve(block*& pOwner)
+    {
+        for (;;)
+        {
+            // only the arena takes from the free list, and it takes it all,
+            // so there is no ABA to fear from the threads pushing onto it
+            if (pLocal == nullptr && pBlock != nullptr &&
+                pBlock->pFree.load(std::memory_order_relaxed) != nullptr)
+                pLocal = pBlock->pFree.exchange(nullptr, std::memory_order_acquire);
+
+            if (pLocal != nullptr)
+            {
+                // a freed slot does not count as live until it is carved again
+                slot* pSlot = pLocal;
+                pLocal = pSlot->pNext;
+                pBlock->numLive.fetch_add(1, std::memory_order_relaxed);
+                pOwner = pBlock;
+                return pSlot;
+            }
+            if (numLeft != 0)
+            {
+                // slots never carved were counted as live when the block was made
+                void* p = pNext;
+                pNext += nodeSize;
+                numLeft--;
+                pOwner = pBlock;
+                return p;
+            }
+            refill();
+        }
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: ARENA :: REFILL
+     * The current block is used up.  Move to a held block
+     * with a quarter or more of its slots free, giving
+     * back any others that have emptied, or make a new
+     * block of one huge page
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(blocks held)
+     *********************************************/
+    inline void node_blocks::arena::refill()
+    {
+        block* pNew = nullptr;
+        for (size_t i = 0; i < held.size(); )
+        {
+            block* p = held[i];
+            // a block left behind has nothing uncarved, so all it is not
+            // using is on its free list.  Less one for our hold
+            size_t numUsed = p->numLive.load(std::memory_order_acquire) - 1;
+            if (p != pBlock && numUsed == 0 && pNew != nullptr)
+            {
+                // no node in it, and nobody else can put one there
+                held[i] = held.back();
+                held.pop_back();
+                deallocate(p);
+                continue;
+            }
+            if (p != pBlock && pNew == nullptr && 4 * numUsed <= 3 * p->numNodes)
+                pNew = p;
+            i++;
+        }
+
+        if (pNew != nullptr)
+        {
+            pBlock = pNew;
+            pLocal = pNew->pFree.exchange(nullptr, std::memory_order_acquire);
+            return;
+        }
+
+        size_t numNodes = huge_pages::pageSize > headerSize + nodeSize ?
+                          (huge_pages::pageSize - headerSize) / nodeSize : 1;
+        pNew = place(numNodes, nodeSize, true /* huge */);
+        try
+        {
+            held.push_back(pNew);
+        }
+        catch (...)
+        {
+            deallocate(pNew);
+            throw;
+        }
+        pNew->reusable = true;
+        pNew->numLive.store(numNodes + 1, std::memory_order_relaxed);   // and our hold
+        pBlock = pNew;
+        pNext = static_cast<char*>(nodes(pNew));
+        numLeft = numNodes;
+    }
+
+    /*********************************************
+     * NODE BLOCKS :: ARENA :: FLUSH
+     * Let go of every block.  The slots never carved and
+     * the hold come off each count, so a block with no
+     * nodes is freed now and the rest go with their last
+     * node
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(blocks held)
+     *********************************************/
+    inline void node_blocks::arena::flush()
+    {
+        size_t numUncarved = numLeft;
+        block* pCurrent = pBlock;
+        pBlock = nullptr;
+        pNext = nullptr;
+        numLeft = 0;
+        pLocal = nullptr;
+        for (size_t i = 0; i < held.size(); i++)
+            release(held[i], 1 + (held[i] == pCurrent ? numUncarved : 0));
+        held.clear();
+    }
+
+    /**************************************************
+     * LIST MEMORY
+     * Process-wide accounting of list nodes: for every
+     * element type, the nodes alive, their bytes, and the
+     * most bytes ever alive at once.  Nodes count
+     * themselves as they are made and destroyed, wherever
+     * that happens.  Off by default; while off, a node
+     * pays one relaxed load.  Turn it on before making
+     * the nodes you want counted
+     **************************************************/
+    class list_memory
+    {
+    public:
+        // one element type's numbers
+        struct totals
+        {
+            const char* type;    // typeid(T).name()
+            long long nodes;     // alive now
+            long long bytes;     // their sizeof(Node)s
+            long long peakBytes; // high-water mark of bytes
+        };
+
+        static void enable(bool on = true) { enabled().store(on, std::memory_order_relaxed); }
+        static bool is_enabled() { return enabled().load(std::memory_order_relaxed); }
+
+        template <typename T>
+        static totals of() { return counters<T>().get(); }
+        static std::vector<totals> report();
+
+        // called by the nodes themselves
+        // nothing is counted at compile time
+        template <typename T>
+        static CUSTOM_LIST_CONSTEXPR void made(size_t bytes, size_t numNodes = 1)
+        {
+            if (CUSTOM_LIST_CONSTANT_EVALUATED())
+                return;
+            if (is_enabled())
+                counters<T>().add((long long)numNodes, (long long)(bytes * numNodes));
+        }
+        template <typename T>
+        static CUSTOM_LIST_CONSTEXPR void destroyed(size_t bytes, size_t numNodes = 1)
+        {
+            if (CUSTOM_LIST_CONSTANT_EVALUATED())
+                return;
+            if (is_enabled())
+                counters<T>().add(-(long long)numNodes, -(long long)(bytes * numNodes));
+        }
+
+    private:
+        // the running numbers for one type, chained into the registry
+        struct Counters
+        {
+            const char* type;
+            std::atomic<long long> nodes;
+            std::atomic<long long> bytes;
+            std::atomic<long long> peakBytes;
+            Counters* pNext;
+
+            Counters(const char* type) : type(type), nodes(0), bytes(0), peakBytes(0), pNext(nullptr)
+            {
+                pNext = registry().load(std::memory_order_relaxed);
+                while (!registry().compare_exchange_weak(pNext, this,
+                       std::memory_order_release, std::memory_order_relaxed))
+                    ;
+            }
+            void add(long long numNodes, long long numBytes)
+            {
+                nodes.fetch_add(numNodes, std::memory_order_relaxed);
+                long long now = bytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+                long long peak = peakBytes.load(std::memory_order_relaxed);
+                while (now > peak && !peakBytes.compare_exchange_weak(peak, now,
+                       std::memory_order_relaxed))
+                    ;
+            }
+            totals get() const
+            {
+                return totals{ type, nodes.load(std::memory_order_relaxed),
+                               bytes.load(std::memory_order_relaxed),
+                               peakBytes.load(std::memory_order_relaxed) };
+            }
+        };
+
+        template <typename T>
+        static Counters& counters()
+        {
+            static Counters c(typeid(T).name());
+            return c;
+        }
+        static std::atomic<Counters*>& registry()
+        {
+            static std::atomic<Counters*> pHead(nullptr);
+            return pHead;
+        }
+        static std::atomic<bool>& enabled()
+        {
+            static std::atomic<bool> on(false);
+            return on;
+        }
+    };
+
+    /*********************************************
+     * LIST MEMORY :: REPORT
+     * The numbers for every type that has been counted
+     *    INPUT  :
+     *    OUTPUT : one entry per element type
+     *    COST   : O(types)
+     *********************************************/
+    inline std::vector<list_memory::totals> list_memory::report()
+    {
+        std::vector<totals> v;
+        for (Counters* p = registry().load(std::memory_order_acquire); p != nullptr; p = p->pNext)
+            v.push_back(p->get());
+        return v;
+    }
+
     /**************************************************
      * LIST
      * Just like std::list
@@ -41,21 +682,26 @@ namespace custom
     {
         friend class ::TestList; // give unit tests access to the privates
         friend class ::TestHash;
+        friend class ::TestHugePages;
+        template <typename TT>
+        friend class blocking_queue; // hands its nodes over in pop_n()
+        template <typename TT>
+        friend class mailbox;        // hands whole chains between threads
         friend void swap(list& lhs, list& rhs);
     public:
         // 
         // Construct
         //
 
-        list();
-        list(list <T>& rhs);
-        list(list <T>&& rhs);
-        list(size_t num, const T& t);
-        list(size_t num);
-        list(const std::initializer_list<T>& il);
+        CUSTOM_LIST_CONSTEXPR list();
+        CUSTOM_LIST_CONSTEXPR list(list <T>& rhs);
+        CUSTOM_LIST_CONSTEXPR list(list <T>&& rhs);
+        CUSTOM_LIST_CONSTEXPR list(size_t num, const T& t);
+        CUSTOM_LIST_CONSTEXPR list(size_t num);
+        CUSTOM_LIST_CONSTEXPR list(const std::initializer_list<T>& il);
         template <class Iterator>
-        list(Iterator first, Iterator last);
-        ~list()
+        CUSTOM_LIST_CONSTEXPR list(Iterator first, Iterator last);
+        CUSTOM_LIST_CONSTEXPR ~list()
         {
             clear();
         }
@@ -64,58 +710,143 @@ namespace custom
         // Assign
         //
 
-        list <T>& operator = (list& rhs);
-        list <T>& operator = (list&& rhs);
-        list <T>& operator = (const std::initializer_list<T>& il);
-        void swap(list <T>& rhs);
+        CUSTOM_LIST_CONSTEXPR list <T>& operator = (list& rhs);
+        CUSTOM_LIST_CONSTEXPR list <T>& operator = (list&& rhs);
+        CUSTOM_LIST_CONSTEXPR list <T>& operator = (const std::initializer_list<T>& il);
+        CUSTOM_LIST_CONSTEXPR void swap(list <T>& rhs);
 
         //
         // Iterator
         //
 
         class  iterator;
-        iterator begin() { return iterator(pHead); }
-        iterator rbegin() { return iterator(pTail); }
-        iterator end() { return iterator(nullptr); }
+        CUSTOM_LIST_CONSTEXPR iterator begin() { return iterator(pHead); }
+        CUSTOM_LIST_CONSTEXPR iterator rbegin() { return iterator(pTail); }
+        CUSTOM_LIST_CONSTEXPR iterator end() { return iterator(nullptr); }
 
         //
         // Access
         //
 
-        T& front();
-        T& back();
+        CUSTOM_LIST_CONSTEXPR T& front();
+        CUSTOM_LIST_CONSTEXPR T& back();
 
         //
         // Insert
         //
 
-        void push_front(const T& data);
-        void push_front(T&& data);
-        void push_back(const T& data);
-        void push_back(T&& data);
-        iterator insert(iterator it, const T& data);
-        iterator insert(iterator it, T&& data);
+        CUSTOM_LIST_CONSTEXPR void push_front(const T& data);
+        CUSTOM_LIST_CONSTEXPR void push_front(T&& data);
+        CUSTOM_LIST_CONSTEXPR void push_back(const T& data);
+        CUSTOM_LIST_CONSTEXPR void push_back(T&& data);
+        CUSTOM_LIST_CONSTEXPR iterator insert(iterator it, const T& data);
+        CUSTOM_LIST_CONSTEXPR iterator insert(iterator it, T&& data);
 
         //
         // Remove
         //
 
-        void pop_back();
-        void pop_front();
-        void clear();
-        iterator erase(const iterator& it);
+        CUSTOM_LIST_CONSTEXPR void pop_back();
+        CUSTOM_LIST_CONSTEXPR void pop_front();
+        CUSTOM_LIST_CONSTEXPR void clear();
+        CUSTOM_LIST_CONSTEXPR iterator erase(const iterator& it);
+
+        //
+        // Splice
+        //
+
+        CUSTOM_LIST_CONSTEXPR void splice(iterator it, list <T>& rhs);
+        CUSTOM_LIST_CONSTEXPR list <T> split_front(size_t num);
+        template <class Compare>
+        CUSTOM_LIST_CONSTEXPR void merge(list <T>& rhs, Compare comp);
+
+        //
+        // Traverse
+        //
+
+        template <class Function>
+        CUSTOM_LIST_CONSTEXPR void for_each(Function f);
+
+        //
+        // Layout
+        //
+
+        // what compact() did
+        struct compact_report
+        {
+            size_t nodes;            // nodes moved into the new block
+            size_t bytesBefore;      // heap the nodes occupied before
+            size_t bytesAfter;       // heap the new block occupies
+            size_t bytesReclaimed;   // before - after, or zero
+        };
+        compact_report compact();
+
+        // how scattered the nodes are, following pNext
+        struct locality_report
+        {
+            static const size_t numBuckets = 16;
+
+            size_t links;               // pNext links followed, size() - 1
+            size_t backward;            // links to a lower address
+            double sameLine;            // fraction of links staying on one cache line
+            double adjacentLine;        // ... moving to the line before or after
+            double samePage;            // fraction staying on one page
+            double adjacentPage;        // ... moving to the page before or after
+            size_t distinctLines;       // cache lines holding a node
+            size_t distinctPages;       // pages holding a node
+            double bytesPerElement;     // distinctLines * line size / size()
+            size_t nodeBytes;           // sizeof a node, the best possible
+            size_t histogram[numBuckets]; // |delta| < 2^(6+i) bytes, last is the rest
+        };
+        locality_report locality(size_t lineSize = 64, size_t pageSize = 4096) const;
+
+        // what this list's nodes really cost
+        struct memory_report
+        {
+            size_t nodes;            // size()
+            size_t payloadBytes;     // the items themselves
+            size_t linkBytes;        // pNext and pPrev
+            size_t overheadBytes;    // padding in the node, heap headers and rounding
+            size_t slackBytes;       // released slots in the blocks we touch
+            size_t totalBytes;       // all of the above
+        };
+        memory_report memory_usage() const;
 
         // 
         // Status
         //
 
-        bool empty()  const { return numElements == 0; }
-        size_t size() const { return numElements; }
+        CUSTOM_LIST_CONSTEXPR bool empty()  const { return numElements == 0; }
+        CUSTOM_LIST_CONSTEXPR size_t size() const { return numElements; }
 
     private:
         // nested linked list class
         class Node;
 
+        // make a node, from the arena if there is one
+        template <class... Args>
+        static CUSTOM_LIST_CONSTEXPR Node* newNode(Args&&... args);
+        template <class... Args>
+        static Node* carveNode(Args&&... args);
+        static node_blocks::arena& localArena()
+        {
+            thread_local node_blocks::arena a(sizeof(Node));
+            return a;
+        }
+
+        // free a node, wherever it was allocated
+        static CUSTOM_LIST_CONSTEXPR void deleteNode(Node* p);
+
+        // trivially copyable items are copied in one block at this size
+        static const size_t bulkCopyThreshold = 64;
+
+        CUSTOM_LIST_CONSTEXPR void copyFrom(const list <T>& rhs);
+        void copyFrom(const list <T>& rhs, std::true_type);
+        CUSTOM_LIST_CONSTEXPR void copyFrom(const list <T>& rhs, std::false_type);
+        void clear(std::true_type);
+        CUSTOM_LIST_CONSTEXPR void clear(std::false_type);
+        void linkBlock(node_blocks::block* pBlock, size_t num);
+
         // member variables
         size_t numElements; // though we could count, it is faster to keep a variable
         Node* pHead;    // pointer to the beginning of the list
@@ -136,20 +867,31 @@ namespace custom
         //
         // Construct
         //
-        Node()
+        CUSTOM_LIST_CONSTEXPR Node()
         {
             data = T();
             pNext = pPrev = nullptr;
+            list_memory::made<T>(sizeof(Node));
         }
-        Node(const T& data)
+        CUSTOM_LIST_CONSTEXPR Node(const T& data)
         {
             this->data = data;
             pNext = pPrev = nullptr;
+            list_memory::made<T>(sizeof(Node));
         }
-        Node(T&& data)
+        CUSTOM_LIST_CONSTEXPR Node(T&& data)
         {
             this->data = std::move(data);
             pNext = pPrev = nullptr;
+            list_memory::made<T>(sizeof(Node));
+        }
+        // for bulk copies, which account for their nodes all at once.
+        // Copy constructs the item, so a trivially copyable one cannot throw
+        struct uncounted {};
+        Node(const T& data, uncounted) : data(data), pNext(nullptr), pPrev(nullptr) {}
+        CUSTOM_LIST_CONSTEXPR ~Node()
+        {
+            list_memory::destroyed<T>(sizeof(Node));
         }
 
         //
@@ -175,20 +917,20 @@ namespace custom
     public:
         // constructors, destructors, and assignment operator
 
-        iterator()
+        CUSTOM_LIST_CONSTEXPR iterator()
         {
            p = nullptr;
         }
-        iterator(Node* pIn)
+        CUSTOM_LIST_CONSTEXPR iterator(Node* pIn)
         {
            p = pIn;
 
         }
-        iterator(const iterator& rhs)
+        CUSTOM_LIST_CONSTEXPR iterator(const iterator& rhs)
         {
            p = rhs.p;
         }
-        iterator& operator = (const iterator& rhs)
+        CUSTOM_LIST_CONSTEXPR iterator& operator = (const iterator& rhs)
         {
            if (this != &rhs)
            {
@@ -199,18 +941,18 @@ namespace custom
         }
 
         // equals, not equals operator
-        bool operator == (const iterator& rhs) const { return p == rhs.p; }
-        bool operator != (const iterator& rhs) const { return p != rhs.p; }
+        CUSTOM_LIST_CONSTEXPR bool operator == (const iterator& rhs) const { return p == rhs.p; }
+        CUSTOM_LIST_CONSTEXPR bool operator != (const iterator& rhs) const { return p != rhs.p; }
 
         // dereference operator, fetch a node
-        T& operator * ()
+        CUSTOM_LIST_CONSTEXPR T& operator * ()
         {
            assert(p != nullptr);
            return p->data;
         }
 
         // postfix increment
-        iterator operator ++ (int postfix)
+        CUSTOM_LIST_CONSTEXPR iterator operator ++ (int postfix)
         {
             iterator temp(*this);
             p = p->pNext;
@@ -218,14 +960,14 @@ namespace custom
         }
 
         // prefix increment
-        iterator& operator ++ ()
+        CUSTOM_LIST_CONSTEXPR iterator& operator ++ ()
         {
             p = p->pNext;
             return *this;
         }
 
         // postfix decrement
-        iterator operator -- (int postfix)
+        CUSTOM_LIST_CONSTEXPR iterator operator -- (int postfix)
         {
             iterator temp(*this);
             p = p->pPrev;
@@ -233,16 +975,16 @@ namespace custom
         }
 
         // prefix decrement
-        iterator& operator -- ()
+        CUSTOM_LIST_CONSTEXPR iterator& operator -- ()
         {
             p = p->pPrev;
             return *this;
         }
 
         // two friends who need to access p directly
-        friend iterator list <T> ::insert(iterator it, const T& data);
-        friend iterator list <T> ::insert(iterator it, T&& data);
-        friend iterator list <T> ::erase(const iterator& it);
+        friend CUSTOM_LIST_CONSTEXPR iterator list <T> ::insert(iterator it, const T& data);
+        friend CUSTOM_LIST_CONSTEXPR iterator list <T> ::insert(iterator it, T&& data);
+        friend CUSTOM_LIST_CONSTEXPR iterator list <T> ::erase(const iterator& it);
 
     private:
 
@@ -254,7 +996,7 @@ namespace custom
      * Create a list initialized to a value
      ****************************************/
     template <typename T>
-    list <T> ::list(size_t num, const T& t)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(size_t num, const T& t)
     {
         numElements = 0;
         pHead = pTail = nullptr;
@@ -268,7 +1010,7 @@ namespace custom
      ****************************************/
     template <typename T>
     template <class Iterator>
-    list <T> ::list(Iterator first, Iterator last)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(Iterator first, Iterator last)
     {
         numElements = 0;
         pHead = pTail = nullptr;
@@ -281,7 +1023,7 @@ namespace custom
      * Create a list initialized to a set of values
      ****************************************/
     template <typename T>
-    list <T> ::list(const std::initializer_list<T>& il)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(const std::initializer_list<T>& il)
     {
         numElements = 0;
         pHead = pTail = nullptr;
@@ -294,7 +1036,7 @@ namespace custom
      * Create a list initialized to a value
      ****************************************/
     template <typename T>
-    list <T> ::list(size_t num)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(size_t num)
     {
         numElements = 0;
         pHead = pTail = nullptr;
@@ -306,7 +1048,7 @@ namespace custom
      * LIST :: DEFAULT constructors
      ****************************************/
     template <typename T>
-    list <T> ::list()
+    CUSTOM_LIST_CONSTEXPR list <T> ::list()
     {
         numElements = 0;
         pHead = pTail = nullptr;
@@ -316,12 +1058,11 @@ namespace custom
      * LIST :: COPY constructors
      ****************************************/
     template <typename T>
-    list <T> ::list(list& rhs)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(list& rhs)
     {
         numElements = 0;
         pHead = pTail = nullptr;
-        for (Node* cur = rhs.pHead; cur != nullptr; cur = cur->pNext)
-            push_back(cur->data);
+        copyFrom(rhs);
     }
 
     /*****************************************
@@ -329,7 +1070,7 @@ namespace custom
      * Steal the values from the RHS
      ****************************************/
     template <typename T>
-    list <T> ::list(list <T>&& rhs)
+    CUSTOM_LIST_CONSTEXPR list <T> ::list(list <T>&& rhs)
     {
         numElements = rhs.numElements;
         pHead = rhs.pHead;
@@ -339,6 +1080,481 @@ namespace custom
         rhs.pHead = rhs.pTail = nullptr;
     }
 
+    /******************************************
+     * LIST :: SPLICE
+     * move every node of another list in front of an
+     * item of this one.  Nothing is copied or allocated
+     *     INPUT  : where the nodes go, the list giving them up
+     *     OUTPUT :
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::splice(iterator it, list <T>& rhs)
+    {
+        if (&rhs == this || rhs.pHead == nullptr)
+            return;
+
+        // insert at end (it == end())
+        if (it.p == nullptr)
+        {
+            rhs.pHead->pPrev = pTail;
+            if (pTail)
+                pTail->pNext = rhs.pHead;
+            else
+                pHead = rhs.pHead;
+            pTail = rhs.pTail;
+        }
+        // insert before it.p
+        else
+        {
+            Node* prev = it.p->pPrev;
+            rhs.pHead->pPrev = prev;
+            rhs.pTail->pNext = it.p;
+            it.p->pPrev = rhs.pTail;
+            if (prev)
+                prev->pNext = rhs.pHead;
+            else
+                pHead = rhs.pHead;
+        }
+
+        numElements += rhs.numElements;
+        rhs.pHead = rhs.pTail = nullptr;
+        rhs.numElements = 0;
+    }
+
+    /******************************************
+     * LIST :: SPLIT FRONT
+     * cut the first few nodes off into a list of their
+     * own.  Nothing is copied or allocated
+     *     INPUT  : how many to cut off
+     *     OUTPUT : a list of those nodes
+     *     COST   : O(num)
+     ******************************************/
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR list <T> list <T> ::split_front(size_t num)
+    {
+        list <T> lReturn;
+        if (num == 0 || pHead == nullptr)
+            return lReturn;
+        if (num >= numElements)
+        {
+            lReturn.swap(*this);
+            return lReturn;
+        }
+
+        Node* pLast = pHead;
+        for (size_t i = 1; i < num; i++)
+            pLast = pLast->pNext;
+
+        lReturn.pHead = pHead;
+        lReturn.pTail = pLast;
+        lReturn.numElements = num;
+
+        pHead = pLast->pNext;
+        pHead->pPrev = nullptr;
+        pLast->pNext = nullptr;
+        numElements -= num;
+        return lReturn;
+    }
+
+    /******************************************
+     * LIST :: MERGE
+     * fold another sorted list into this sorted one by
+     * relinking nodes.  The merge is stable: of two equal
+     * items, the one already in this list comes first
+     *     INPUT  : the list giving up its nodes, the ordering
+     *     OUTPUT :
+     *     COST   : O(n + m)
+     ******************************************/
+    template <typename T>
+    template <class Compare>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::merge(list <T>& rhs, Compare comp)
+    {
+        if (&rhs == this || rhs.pHead == nullptr)
+            return;
+
+        Node* pLeft = pHead;
+        Node* pRight = rhs.pHead;
+        Node* pLast = nullptr;
+        pHead = nullptr;
+        while (pLeft && pRight)
+        {
+            Node* pTake;
+            if (comp(pRight->data, pLeft->data))
+            {
+                pTake = pRight;
+                pRight = pRight->pNext;
+            }
+            else
+            {
+                pTake = pLeft;
+                pLeft = pLeft->pNext;
+            }
+            pTake->pPrev = pLast;
+            if (pLast)
+                pLast->pNext = pTake;
+            else
+                pHead = pTake;
+            pLast = pTake;
+        }
+
+        // whatever is left is already in order
+        Node* pRest = pLeft ? pLeft : pRight;
+        if (pLast)
+            pLast->pNext = pRest;
+        else
+            pHead = pRest;
+        pRest->pPrev = pLast;
+        pTail = pLeft ? pTail : rhs.pTail;
+
+        numElements += rhs.numElements;
+        rhs.pHead = rhs.pTail = nullptr;
+        rhs.numElements = 0;
+    }
+
+    /******************************************
+     * LIST :: FOR EACH
+     * call f on every item, front to back.  The loop
+     * follows the raw node pointers with no iterator in
+     * the way, so f can be inlined into it
+     *     INPUT  : what to call on each item
+     *     OUTPUT :
+     *     COST   : O(n)
+     ******************************************/
+    template <typename T>
+    template <class Function>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::for_each(Function f)
+    {
+        for (Node* p = pHead; p != nullptr; p = p->pNext)
+            f(p->data);
+    }
+
+    /******************************************
+     * LIST :: NEW NODE
+     * make a node.  With node_blocks::use_arena() on it
+     * is carved from this thread's arena, otherwise it
+     * comes from new
+     *     INPUT  : what to build the item from
+     *     OUTPUT : the node, not yet linked
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    template <class... Args>
+    CUSTOM_LIST_CONSTEXPR typename list <T> ::Node* list <T> ::newNode(Args&&... args)
+    {
+        // at compile time there are no blocks
+        if (CUSTOM_LIST_CONSTANT_EVALUATED() || !node_blocks::uses_arena())
+            return new Node(std::forward<Args>(args)...);
+        return carveNode(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    template <class... Args>
+    typename list <T> ::Node* list <T> ::carveNode(Args&&... args)
+    {
+        static_assert(alignof(Node) <= alignof(std::max_align_t),
+                      "the arena cannot place over-aligned nodes");
+        node_blocks::block* pBlock = nullptr;
+        void* p = localArena().carve(pBlock);
+        try
+        {
+            return new (p) Node(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            node_blocks::recycle(pBlock, p);   // back on the free list
+            throw;
+        }
+    }
+
+    /******************************************
+     * LIST :: DELETE NODE
+     * destroy a node.  Ones made with new go back with
+     * delete; ones placed in a block are released to the
+     * block
+     *     INPUT  : the node, already unlinked
+     *     OUTPUT :
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::deleteNode(Node* p)
+    {
+        // at compile time there are no blocks; every node came from new
+        if (CUSTOM_LIST_CONSTANT_EVALUATED())
+        {
+            delete p;
+            return;
+        }
+
+        node_blocks::block* pBlock = node_blocks::owner(p);
+        p->~Node();
+        if (pBlock)
+            node_blocks::recycle(pBlock, p);
+        else
+            ::operator delete(p);
+    }
+
+    /******************************************
+     * LIST :: LINK BLOCK
+     * hook up nodes placed side by side in a block, in
+     * order, and make them the whole list
+     *     INPUT  : the block, how many nodes
+     *     OUTPUT :
+     *     COST   : O(num)
+     ******************************************/
+    template <typename T>
+    void list <T> ::linkBlock(node_blocks::block* pBlock, size_t num)
+    {
+        Node* pNodes = static_cast<Node*>(node_blocks::nodes(pBlock));
+        for (size_t i = 0; i < num; i++)
+        {
+            pNodes[i].pPrev = (i == 0) ? nullptr : pNodes + i - 1;
+            pNodes[i].pNext = (i + 1 == num) ? nullptr : pNodes + i + 1;
+        }
+        pHead = pNodes;
+        pTail = pNodes + num - 1;
+    }
+
+    /******************************************
+     * LIST :: COPY FROM
+     * append copies of every item of rhs to this empty
+     * list, the fast way when the items allow it
+     *     INPUT  : the list to copy
+     *     OUTPUT :
+     *     COST   : O(n)
+     ******************************************/
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::copyFrom(const list <T>& rhs)
+    {
+        if (CUSTOM_LIST_CONSTANT_EVALUATED())
+            copyFrom(rhs, std::false_type());
+        else
+            copyFrom(rhs, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+    }
+
+    // one node at a time
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::copyFrom(const list <T>& rhs, std::false_type)
+    {
+        for (Node* cur = rhs.pHead; cur != nullptr; cur = cur->pNext)
+            push_back(cur->data);
+    }
+
+    // a long list of plain bytes: one allocation, each node constructed
+    // in place by a trivial copy, links computed from the positions in
+    // the block, and the nodes accounted for all at once.  Nothing here
+    // can throw after the allocation
+    template <typename T>
+    void list <T> ::copyFrom(const list <T>& rhs, std::true_type)
+    {
+        assert(pHead == nullptr);
+        if (rhs.numElements < bulkCopyThreshold)
+        {
+            copyFrom(rhs, std::false_type());
+            return;
+        }
+
+        node_blocks::block* pBlock = node_blocks::allocate(rhs.numElements, sizeof(Node));
+        Node* pDes = static_cast<Node*>(node_blocks::nodes(pBlock));
+        for (Node* pSrc = rhs.pHead; pSrc != nullptr; pSrc = pSrc->pNext, pDes++)
+            new (pDes) Node(pSrc->data, typename Node::uncounted());
+        linkBlock(pBlock, rhs.numElements);
+        list_memory::made<T>(sizeof(Node), rhs.numElements);
+        numElements = rhs.numElements;
+    }
+
+    /******************************************
+     * LIST :: COMPACT
+     * after a lot of inserting and erasing, neighbors in
+     * the list are scattered across the heap.  Move every
+     * item into one new block, laid out in traversal
+     * order, and free the old nodes.
+     *
+     * Every iterator into this list is invalidated, as
+     * are pointers and references to its items.  If an
+     * item throws while being moved, the list is left as
+     * it was
+     *     INPUT  :
+     *     OUTPUT : how many bytes that saved
+     *     COST   : O(n)
+     ******************************************/
+    template <typename T>
+    typename list <T> ::compact_report list <T> ::compact()
+    {
+        static_assert(alignof(Node) <= alignof(std::max_align_t),
+                      "compact() cannot place over-aligned nodes");
+        compact_report report = { numElements, 0, 0, 0 };
+        if (numElements == 0)
+            return report;
+
+        // build the new chain beside the old one
+        node_blocks::block* pBlock = node_blocks::allocate(numElements, sizeof(Node));
+        Node* pNodes = static_cast<Node*>(node_blocks::nodes(pBlock));
+        size_t num = 0;
+        try
+        {
+            for (Node* p = pHead; p != nullptr; p = p->pNext, num++)
+                new (pNodes + num) Node(std::move_if_noexcept(p->data));
+        }
+        catch (...)
+        {
+            while (num > 0)
+                pNodes[--num].~Node();
+            node_blocks::deallocate(pBlock);
+            throw;
+        }
+
+        // free the old chain
+        for (Node* p = pHead; p != nullptr; )
+        {
+            Node* pNext = p->pNext;
+            report.bytesBefore += node_blocks::owner(p) ? sizeof(Node) :
+                                  node_blocks::footprint(sizeof(Node));
+            deleteNode(p);
+            p = pNext;
+        }
+
+        linkBlock(pBlock, numElements);
+
+        report.bytesAfter = node_blocks::footprint(node_blocks::bytes(numElements, sizeof(Node)));
+        if (report.bytesBefore > report.bytesAfter)
+            report.bytesReclaimed = report.bytesBefore - report.bytesAfter;
+        return report;
+    }
+
+    /******************************************
+     * LIST :: LOCALITY
+     * walk the pNext chain and measure how far apart
+     * neighbors are in memory.  A freshly built or freshly
+     * compacted list has nearly every link on the same or
+     * the next line; after churn, the fractions drop and
+     * the histogram spreads out.  That is the time to
+     * call compact()
+     *     INPUT  : the cache line and page sizes
+     *     OUTPUT : the report
+     *     COST   : O(n log n), and O(n) extra memory
+     ******************************************/
+    template <typename T>
+    typename list <T> ::locality_report list <T> ::locality(size_t lineSize, size_t pageSize) const
+    {
+        locality_report report = {};
+        report.nodeBytes = sizeof(Node);
+        if (pHead == nullptr)
+            return report;
+
+        std::vector<uintptr_t> lines;
+        std::vector<uintptr_t> pages;
+        lines.reserve(numElements);
+        pages.reserve(numElements);
+
+        size_t numSameLine = 0;
+        size_t numAdjacentLine = 0;
+        size_t numSamePage = 0;
+        size_t numAdjacentPage = 0;
+        for (const Node* p = pHead; p != nullptr; p = p->pNext)
+        {
+            uintptr_t address = reinterpret_cast<uintptr_t>(p);
+            lines.push_back(address / lineSize);
+            pages.push_back(address / pageSize);
+            if (p->pNext == nullptr)
+                break;
+
+            uintptr_t next = reinterpret_cast<uintptr_t>(p->pNext);
+            uintptr_t delta = next > address ? next - address : address - next;
+            report.links++;
+            if (next < address)
+                report.backward++;
+
+            uintptr_t lineFrom = address / lineSize;
+            uintptr_t lineTo = next / lineSize;
+            uintptr_t lineGap = lineTo > lineFrom ? lineTo - lineFrom : lineFrom - lineTo;
+            numSameLine += lineGap == 0;
+            numAdjacentLine += lineGap == 1;
+            uintptr_t pageFrom = address / pageSize;
+            uintptr_t pageTo = next / pageSize;
+            uintptr_t pageGap = pageTo > pageFrom ? pageTo - pageFrom : pageFrom - pageTo;
+            numSamePage += pageGap == 0;
+            numAdjacentPage += pageGap == 1;
+
+            size_t bucket = 0;
+            while (bucket + 1 < locality_report::numBuckets && delta >= (uintptr_t(64) << bucket))
+                bucket++;
+            report.histogram[bucket]++;
+        }
+
+        if (report.links)
+        {
+            report.sameLine = double(numSameLine) / report.links;
+            report.adjacentLine = double(numAdjacentLine) / report.links;
+            report.samePage = double(numSamePage) / report.links;
+            report.adjacentPage = double(numAdjacentPage) / report.links;
+        }
+
+        std::sort(lines.begin(), lines.end());
+        std::sort(pages.begin(), pages.end());
+        report.distinctLines = std::unique(lines.begin(), lines.end()) - lines.begin();
+        report.distinctPages = std::unique(pages.begin(), pages.end()) - pages.begin();
+        report.bytesPerElement = double(report.distinctLines * lineSize) / numElements;
+        return report;
+    }
+
+    /******************************************
+     * LIST :: MEMORY USAGE
+     * add up what the nodes cost: the items, the links,
+     * and the overhead around them.  A node made with new
+     * pays for a heap header and rounding; one in a block
+     * does not, but the block's released slots are slack
+     * until the arena carves them again or the whole block
+     * goes.  A block
+     * shared with another list is counted by both
+     *     INPUT  :
+     *     OUTPUT : the report
+     *     COST   : O(1) while no blocks exist, else O(n)
+     ******************************************/
+    template <typename T>
+    typename list <T> ::memory_report list <T> ::memory_usage() const
+    {
+        const size_t linkSize = 2 * sizeof(Node*);
+        const size_t padding = sizeof(Node) - sizeof(T) - linkSize;
+        const size_t header = node_blocks::footprint(sizeof(Node)) - sizeof(Node);
+
+        memory_report report = {};
+        report.nodes = numElements;
+        report.payloadBytes = numElements * sizeof(T);
+        report.linkBytes = numElements * linkSize;
+        report.overheadBytes = numElements * padding;
+
+        // every node came from new
+        size_t numHeap = numElements;
+        if (node_blocks::size() != 0)
+        {
+            std::vector<const node_blocks::block*> touched;
+            numHeap = 0;
+            for (const Node* p = pHead; p != nullptr; p = p->pNext)
+            {
+                const node_blocks::block* pBlock = node_blocks::owner(p);
+                if (pBlock == nullptr)
+                    numHeap++;
+                else if (touched.empty() || touched.back() != pBlock)
+                    touched.push_back(pBlock);
+            }
+            std::sort(touched.begin(), touched.end());
+            touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+            for (size_t i = 0; i < touched.size(); i++)
+            {
+                // an arena's block counts its uncarved slots and its hold as live
+                size_t numLive = std::min(touched[i]->numNodes,
+                                          touched[i]->numLive.load(std::memory_order_relaxed));
+                report.slackBytes += (touched[i]->numNodes - numLive) * sizeof(Node);
+            }
+        }
+
+        report.overheadBytes += numHeap * header;
+        report.totalBytes = report.payloadBytes + report.linkBytes +
+                            report.overheadBytes + report.slackBytes;
+        return report;
+    }
+
     /**********************************************
      * LIST :: assignment operator - MOVE
      * Copy one list onto another
@@ -347,7 +1563,7 @@ namespace custom
      *     COST   : O(n) with respect to the size of the LHS
      *********************************************/
     template <typename T>
-    list <T>& list <T> :: operator = (list <T>&& rhs)
+    CUSTOM_LIST_CONSTEXPR list <T>& list <T> :: operator = (list <T>&& rhs)
     {
         if (this == &rhs)
             return *this;
@@ -372,14 +1588,13 @@ namespace custom
      *     COST   : O(n) with respect to the number of nodes
      *********************************************/
     template <typename T>
-    list <T>& list <T> :: operator = (list <T>& rhs)
+    CUSTOM_LIST_CONSTEXPR list <T>& list <T> :: operator = (list <T>& rhs)
     {
         if (this == &rhs)
             return *this;
 
         clear();
-        for (Node* cur = rhs.pHead; cur != nullptr; cur = cur->pNext)
-            push_back(cur->data);
+        copyFrom(rhs);
 
         return *this;
     }
@@ -392,7 +1607,7 @@ namespace custom
      *     COST   : O(n) with respect to the number of nodes
      *********************************************/
     template <typename T>
-    list <T>& list <T> :: operator = (const std::initializer_list<T>& il)
+    CUSTOM_LIST_CONSTEXPR list <T>& list <T> :: operator = (const std::initializer_list<T>& il)
     {
        list<T> tmp(il);  // build a temporary list from the initializer values
        this->swap(tmp);  // swap head/tail/size; tmp now holds old nodes
@@ -408,14 +1623,77 @@ namespace custom
      *     COST   : O(n) with respect to the number of nodes
      *********************************************/
     template <typename T>
-    void list <T> ::clear()
+    CUSTOM_LIST_CONSTEXPR void list <T> ::clear()
+    {
+       if (CUSTOM_LIST_CONSTANT_EVALUATED())
+          clear(std::false_type());
+       else
+          clear(std::integral_constant<bool, std::is_trivially_destructible<T>::value>());
+    }
+
+    /**********************************************
+     * LIST :: CLEAR - TRIVIAL
+     * Nothing to destroy in the items, so the nodes are
+     * freed without calling their destructors.  Runs of
+     * nodes from the same block, as compact(), bulk
+     * copies and the arena leave them, go back to their
+     * block in one step
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void list <T> ::clear(std::true_type)
+    {
+       list_memory::destroyed<T>(sizeof(Node), numElements);
+
+       Node* cur = pHead;
+       while (cur)
+       {
+          Node* next = cur->pNext;
+          node_blocks::block* pBlock = node_blocks::owner(cur);
+          if (pBlock == nullptr)
+             ::operator delete(cur);
+          else
+          {
+             // the run of nodes from this block goes back in one step,
+             // chained into free slots as it goes
+             node_blocks::slot* pLast = node_blocks::toSlot(cur, nullptr);
+             node_blocks::slot* pFirst = pLast;
+             size_t run = 1;
+             while (next && node_blocks::owner(next) == pBlock)
+             {
+                Node* after = next->pNext;
+                pFirst = node_blocks::toSlot(next, pFirst);
+                next = after;
+                run++;
+             }
+             node_blocks::recycle(pBlock, pFirst, pLast, run);
+          }
+          cur = next;
+       }
+
+       pHead = nullptr;
+       pTail = nullptr;
+       numElements = 0;
+    }
+
+    /**********************************************
+     * LIST :: CLEAR - NOT TRIVIAL
+     * Every item is destroyed, one node at a time
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n)
+     *********************************************/
+    template <typename T>
+    CUSTOM_LIST_CONSTEXPR void list <T> ::clear(std::false_type)
     {
        // Start at the head
        Node* cur = pHead;
        while (cur)
        {
           Node* next = cur->pNext;
-          delete cur; // Delete every single node in the list
+          deleteNode(cur); // Delete every single node in the list
           cur = next;
        }
 
@@ -432,9 +1710,9 @@ namespace custom
      *    COST   : O(1)
      *********************************************/
     template <typename T> // copy
-    void list <T> ::push_back(const T& data)
+    CUSTOM_LIST_CONSTEXPR void list <T> ::push_back(const T& data)
     {
-        Node* n = new Node(data); // copy to make a new node
+        Node* n = newNode(data); // copy to make a new node
 
         // empty list
         if (pHead == nullptr)
@@ -452,9 +1730,9 @@ namespace custom
     }
 
     template <typename T> // move
-    void list <T> ::push_back(T&& data)
+    CUSTOM_LIST_CONSTEXPR void list <T> ::push_back(T&& data)
     {
-       Node* n = new Node(std::move(data)); // move to make a new node (value is rvalue/temporary)
+       Node* n = newNode(std::move(data)); // move to make a new node (value is rvalue/temporary)
 
        // empty list
        if (pHead == nullptr)
@@ -480,9 +1758,9 @@ namespace custom
      *     COST   : O(1)
      *********************************************/
     template <typename T>
-    void list <T> ::push_front(const T& data)
+    CUSTOM_LIST_CONSTEXPR void list <T> ::push_front(const T& data)
     {
-       Node* pNew = new Node(data);
+       Node* pNew = newNode(data);
 
        pNew->pNext = pHead;
        if (pHead)
@@ -495,9 +1773,9 @@ namespace custom
     }
 
     template <typename T>
-    void list <T> ::push_front(T&& data)
+    CUSTOM_LIST_CONSTEXPR void list <T> ::push_front(T&& data)
     {
-       Node* pNew = new Node(data);
+       Node* pNew = newNode(data);
 
        pNew->pNext = pHead;
        if (pHead)
@@ -518,7 +1796,7 @@ namespace custom
      *    COST   : O(1)
      *********************************************/
     template <typename T>
-    void list <T> ::pop_back()
+    CUSTOM_LIST_CONSTEXPR void list <T> ::pop_back()
     {
        // empty
        if (pTail == nullptr)
@@ -533,7 +1811,7 @@ namespace custom
        {
           pHead = pTail = nullptr;
           numElements = 0;
-          delete oldTail;
+          deleteNode(oldTail);
           return;
        }
        
@@ -541,7 +1819,7 @@ namespace custom
        pTail = pTail->pPrev;
        pTail->pNext = nullptr;
        --numElements;
-       delete oldTail;
+       deleteNode(oldTail);
     }
 
     /*********************************************
@@ -552,7 +1830,7 @@ namespace custom
      *    COST   : O(1)
      *********************************************/
     template <typename T>
-    void list <T> ::pop_front()
+    CUSTOM_LIST_CONSTEXPR void list <T> ::pop_front()
     {
        // If there is no pHead, don't even bother
        if (!pHead)
@@ -575,7 +1853,7 @@ namespace custom
        }
 
        // Delete the node and decrement
-       delete pToDelete;
+       deleteNode(pToDelete);
        numElements--;
     }
 
@@ -587,7 +1865,7 @@ namespace custom
      *     COST   : O(1)
      *********************************************/
     template <typename T>
-    T& list <T> ::front()
+    CUSTOM_LIST_CONSTEXPR T& list <T> ::front()
     {
         if (empty())
            throw "ERROR: unable to access data from an empty list";
@@ -602,7 +1880,7 @@ namespace custom
      *     COST   : O(1)
      *********************************************/
     template <typename T>
-    T& list <T> ::back()
+    CUSTOM_LIST_CONSTEXPR T& list <T> ::back()
     {
        if (empty())
           throw "ERROR: unable to access data from an empty list";
@@ -618,7 +1896,7 @@ namespace custom
      *     COST   : O(1)
      ******************************************/
     template <typename T>
-    typename list <T> ::iterator  list <T> ::erase(const list <T> ::iterator& it)
+    CUSTOM_LIST_CONSTEXPR typename list <T> ::iterator  list <T> ::erase(const list <T> ::iterator& it)
     {
 
        if (pHead == nullptr || it.p == nullptr)  // end() or empty
@@ -638,7 +1916,7 @@ namespace custom
        else
           pTail = prev;
 
-       delete cur;
+       deleteNode(cur);
        --numElements;
 
        return iterator(next); // if next nullptr -> end()
@@ -653,10 +1931,10 @@ namespace custom
      *     COST   : O(1)
      ******************************************/
     template <typename T>
-    typename list <T> ::iterator list <T> ::insert(list <T> ::iterator it,
+    CUSTOM_LIST_CONSTEXPR typename list <T> ::iterator list <T> ::insert(list <T> ::iterator it,
         const T& data)
     {
-        Node* n = new Node(data);
+        Node* n = newNode(data);
 
         // empty list
         if (pHead == nullptr)
@@ -694,10 +1972,10 @@ namespace custom
     }
 
     template <typename T>
-    typename list <T> ::iterator list <T> ::insert(list <T> ::iterator it,
+    CUSTOM_LIST_CONSTEXPR typename list <T> ::iterator list <T> ::insert(list <T> ::iterator it,
         T&& data)
     {
-        Node* n = new Node(std::move(data));
+        Node* n = newNode(std::move(data));
 
         // empty list
         if (pHead == nullptr)
@@ -742,18 +2020,68 @@ namespace custom
      *********************************************/
 
     template <typename T>
-    void swap(list <T>& lhs, list <T>& rhs)
+    CUSTOM_LIST_CONSTEXPR void swap(list <T>& lhs, list <T>& rhs)
     {
         lhs.swap(rhs);
     }
 
     template <typename T>
-    void list<T>::swap(list <T>& rhs)
+    CUSTOM_LIST_CONSTEXPR void list<T>::swap(list <T>& rhs)
     {
         std::swap(numElements, rhs.numElements);
         std::swap(pHead, rhs.pHead);
         std::swap(pTail, rhs.pTail);
     }
 
+#if CUSTOM_LIST_HAS_CONSTEXPR
+    /**************************************************
+     * FROZEN LIST
+     * The items of a list built at compile time, kept in
+     * an array so they outlive the compile.  Read only;
+     * a constexpr one costs nothing at startup
+     **************************************************/
+    template <typename T, size_t N>
+    struct frozen_list
+    {
+        T items[N == 0 ? 1 : N];
+        size_t num;
+
+        constexpr const T* begin() const { return items; }
+        constexpr const T* end() const { return items + num; }
+        constexpr const T& operator [] (size_t i) const { return items[i]; }
+        constexpr bool empty() const { return num == 0; }
+        constexpr size_t size() const { return num; }
+    };
+
+    /*********************************************
+     * FREEZE
+     * Build a list at compile time and keep its items:
+     *     constexpr auto ports = custom::freeze<3>([] {
+     *         custom::list<int> l{ 80, 443 };
+     *         l.push_front(22);
+     *         return l; });
+     * Compile-time allocations cannot outlive the compile,
+     * so the list itself is gone once freeze() returns.  A
+     * list longer than N will not compile
+     *    INPUT  : the most items, something returning a list
+     *    OUTPUT : the items, in order
+     *    COST   : nothing at run time
+     *********************************************/
+    template <size_t N, class Builder>
+    constexpr auto freeze(Builder build)
+    {
+        auto l = build();
+        typedef typename std::decay<decltype(*l.begin())>::type T;
+        if (l.size() > N)
+            throw "ERROR: too many items to freeze";
+
+        frozen_list<T, N> frozen{};
+        frozen.num = 0;
+        for (auto it = l.begin(); it != l.end(); ++it)
+            frozen.items[frozen.num++] = *it;
+        return frozen;
+    }
+#endif
+
     //#endif
 }; // namespace custom
@@ -0,0 +1,155 @@
+/***********************************************************************
+ * Header:
+ *    MAILBOX
+ * Summary:
+ *    Passes whole batches of items from producer threads to a consumer.
+ *    A producer fills a custom::list of its own with no synchronization
+ *    at all, then posts the entire pHead..pTail chain with one CAS.  The
+ *    consumer takes every pending batch with one exchange and splices
+ *    them onto its list.  One atomic per batch, however long the batch.
+ *
+ *    Pending batches sit on a lock-free stack of small headers.  The
+ *    consumer only ever takes the whole stack, never a single header, so
+ *    there is no ABA problem.  The stack is newest first, so the consumer
+ *    reverses it to hand batches over in the order they were posted.
+ *
+ *    This will contain the class definition of:
+ *        mailbox : A many-producer batch handoff
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <atomic>      // for std::atomic
+
+class TestMailbox;     // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * MAILBOX
+     * post() from any thread, receive() from any thread
+     **************************************************/
+    template <typename T>
+    class mailbox
+    {
+        friend class ::TestMailbox; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        mailbox() : pTop(nullptr) {}
+        mailbox(const mailbox& rhs) = delete;
+        mailbox& operator = (const mailbox& rhs) = delete;
+        ~mailbox();
+
+        //
+        // Producer side
+        //
+
+        void post(list <T>& batch);
+
+        //
+        // Consumer side
+        //
+
+        size_t receive(list <T>& rhs);
+        bool empty() const { return pTop.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        typedef typename list <T> ::Node Node;
+
+        // one posted chain
+        struct Batch
+        {
+            Node* pHead;    // first node of the chain
+            Node* pTail;    // last node of the chain
+            size_t num;     // how many nodes in the chain
+            Batch* pNext;   // the batch posted before this one
+        };
+
+        // member variables
+        std::atomic<Batch*> pTop;  // the newest batch
+    };
+
+    /*****************************************
+     * MAILBOX :: DESTRUCTOR
+     * Anything never received is freed with its list
+     ****************************************/
+    template <typename T>
+    mailbox <T> ::~mailbox()
+    {
+        list <T> lUnread;
+        receive(lUnread);
+    }
+
+    /*********************************************
+     * MAILBOX :: POST
+     * publish a producer's whole list at once.  The list
+     * is left empty and the nodes now belong to the mailbox
+     *    INPUT  : the batch
+     *    OUTPUT :
+     *    COST   : O(1), one CAS expected
+     *********************************************/
+    template <typename T>
+    void mailbox <T> ::post(list <T>& batch)
+    {
+        if (batch.pHead == nullptr)
+            return;
+
+        Batch* pNew = new Batch{ batch.pHead, batch.pTail, batch.numElements, nullptr };
+        batch.pHead = batch.pTail = nullptr;
+        batch.numElements = 0;
+
+        pNew->pNext = pTop.load(std::memory_order_relaxed);
+        while (!pTop.compare_exchange_weak(pNew->pNext, pNew,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed))
+            ;
+    }
+
+    /*********************************************
+     * MAILBOX :: RECEIVE
+     * take every pending batch and append them, oldest
+     * first, to a list.  Only headers are touched, never
+     * the items in the batches
+     *    INPUT  : the list to append to
+     *    OUTPUT : the number of items taken
+     *    COST   : O(number of batches)
+     *********************************************/
+    template <typename T>
+    size_t mailbox <T> ::receive(list <T>& rhs)
+    {
+        Batch* pNewest = pTop.exchange(nullptr, std::memory_order_acquire);
+
+        // newest first to oldest first
+        Batch* pOldest = nullptr;
+        while (pNewest)
+        {
+            Batch* pNext = pNewest->pNext;
+            pNewest->pNext = pOldest;
+            pOldest = pNewest;
+            pNewest = pNext;
+        }
+
+        size_t num = 0;
+        while (pOldest)
+        {
+            list <T> chain;
+            chain.pHead = pOldest->pHead;
+            chain.pTail = pOldest->pTail;
+            chain.numElements = pOldest->num;
+            rhs.splice(rhs.end(), chain);
+            num += pOldest->num;
+
+            Batch* pDone = pOldest;
+            pOldest = pOldest->pNext;
+            delete pDone;
+        }
+        return num;
+    }
+
+}; // namespace custom
@@ -0,0 +1,331 @@
+/***********************************************************************
+ * Header:
+ *    MPSC QUEUE
+ * Summary:
+ *    A lock-free multi-producer/single-consumer queue in the style of
+ *    Dmitry Vyukov's node-based MPSC queue.  Producers never wait on
+ *    each other: a push is one atomic exchange on the tail and one
+ *    store.  The consumer can take items one at a time, or cut off
+ *    everything pushed so far with a single exchange and move the items
+ *    into a custom::list.
+ *
+ *    Nodes are laid out like custom::list's (data, then pNext) with no
+ *    pPrev and an atomic pNext.  That difference means a queue node can
+ *    never become a list node, so draining moves each item into a node
+ *    of the list's own, one at a time.  Spent nodes are recycled rather than
+ *    deleted: the consumer pushes them on a free stack and producers take
+ *    the whole stack at once, so neither side ever pops a single node
+ *    with a CAS (which is where ABA would bite).
+ *
+ *    This will contain the class definition of:
+ *        mpsc_queue : A many-writer, one-reader queue
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <atomic>      // for std::atomic
+#include <thread>      // for std::this_thread::yield
+#include <utility>
+
+class TestMpscQueue;   // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * MPSC QUEUE
+     * push() from any thread; try_pop() and drain_into()
+     * from exactly one consumer thread at a time
+     **************************************************/
+    template <typename T>
+    class mpsc_queue
+    {
+        friend class ::TestMpscQueue; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        mpsc_queue();
+        mpsc_queue(const mpsc_queue& rhs) = delete;
+        mpsc_queue& operator = (const mpsc_queue& rhs) = delete;
+        ~mpsc_queue();
+
+        //
+        // Producer side: any thread
+        //
+
+        void push(const T& data);
+        void push(T&& data);
+
+        //
+        // Consumer side: one thread only
+        //
+
+        bool try_pop(T& data);
+        size_t drain_into(list <T>& rhs);
+        bool empty() const;
+
+    private:
+        // nested linked list class
+        class Node;
+
+        // a producer's private stash of recycled nodes
+        struct Cache
+        {
+            Cache() : pHead(nullptr) {}
+            ~Cache();
+            Node* pHead;
+        };
+        static Cache& cache();
+
+        // get a node for a producer, recycled if at all possible
+        Node* acquire();
+        // hand a spent node back to the producers
+        void recycle(Node* p);
+        // link a filled node onto the tail
+        void enqueue(Node* p);
+
+        // member variables.  The consumer's head and the producers' tail
+        // live on different cache lines so they do not fight over one
+        alignas(64) Node* pHead;               // dummy in front of the first item, consumer only
+        alignas(64) std::atomic<Node*> pTail;  // last node pushed, all producers
+        alignas(64) std::atomic<Node*> pFree;  // spent nodes waiting for a producer
+    };
+
+    /*************************************************
+     * NODE
+     * Same shape as list<T>::Node, minus pPrev, with an
+     * atomic pNext
+     *************************************************/
+    template <typename T>
+    class mpsc_queue <T> ::Node
+    {
+    public:
+        Node() : data(), pNext(nullptr) {}
+        Node(const T& data) : data(data), pNext(nullptr) {}
+        Node(T&& data) : data(std::move(data)), pNext(nullptr) {}
+
+        T data;                    // user data
+        std::atomic<Node*> pNext;  // pointer to next node
+    };
+
+    /*****************************************
+     * MPSC QUEUE :: CACHE
+     * Every producer thread keeps the nodes it grabbed
+     * from a free stack.  The nodes belong to no queue in
+     * particular, so one cache serves every queue of T
+     ****************************************/
+    template <typename T>
+    typename mpsc_queue <T> ::Cache& mpsc_queue <T> ::cache()
+    {
+        static thread_local Cache c;
+        return c;
+    }
+
+    template <typename T>
+    mpsc_queue <T> ::Cache::~Cache()
+    {
+        while (pHead)
+        {
+            Node* pNext = pHead->pNext.load(std::memory_order_relaxed);
+            delete pHead;
+            pHead = pNext;
+        }
+    }
+
+    /*****************************************
+     * MPSC QUEUE :: DEFAULT constructors
+     * The queue starts with a dummy node that is both
+     * the head and the tail
+     ****************************************/
+    template <typename T>
+    mpsc_queue <T> ::mpsc_queue() : pHead(new Node), pTail(nullptr), pFree(nullptr)
+    {
+        pTail.store(pHead, std::memory_order_relaxed);
+    }
+
+    /*****************************************
+     * MPSC QUEUE :: DESTRUCTOR
+     * No producer may still be pushing
+     ****************************************/
+    template <typename T>
+    mpsc_queue <T> ::~mpsc_queue()
+    {
+        Node* p = pHead;
+        while (p)
+        {
+            Node* pNext = p->pNext.load(std::memory_order_acquire);
+            delete p;
+            p = pNext;
+        }
+
+        p = pFree.load(std::memory_order_acquire);
+        while (p)
+        {
+            Node* pNext = p->pNext.load(std::memory_order_relaxed);
+            delete p;
+            p = pNext;
+        }
+    }
+
+    /*****************************************
+     * MPSC QUEUE :: ACQUIRE
+     * Take a node from this thread's cache, refilling
+     * the cache with the entire free stack if it is dry
+     *     COST   : O(1), one exchange at most
+     ****************************************/
+    template <typename T>
+    typename mpsc_queue <T> ::Node* mpsc_queue <T> ::acquire()
+    {
+        Cache& c = cache();
+        if (c.pHead == nullptr && pFree.load(std::memory_order_relaxed) != nullptr)
+            c.pHead = pFree.exchange(nullptr, std::memory_order_acquire);
+
+        Node* p = c.pHead;
+        if (p)
+        {
+            c.pHead = p->pNext.load(std::memory_order_relaxed);
+            p->pNext.store(nullptr, std::memory_order_relaxed);
+        }
+        return p;
+    }
+
+    /*****************************************
+     * MPSC QUEUE :: RECYCLE
+     * Push a spent node on the free stack.  Pushing is
+     * safe from ABA; only whole-stack exchanges take nodes off
+     *     COST   : O(1) expected
+     ****************************************/
+    template <typename T>
+    void mpsc_queue <T> ::recycle(Node* p)
+    {
+        Node* pTop = pFree.load(std::memory_order_relaxed);
+        do
+            p->pNext.store(pTop, std::memory_order_relaxed);
+        while (!pFree.compare_exchange_weak(pTop, p, std::memory_order_release,
+                                            std::memory_order_relaxed));
+    }
+
+    /*****************************************
+     * MPSC QUEUE :: ENQUEUE
+     * Swing the tail to the new node, then link the old
+     * tail to it.  Between those two steps the consumer
+     * simply sees the queue end early
+     *     COST   : O(1), wait-free
+     ****************************************/
+    template <typename T>
+    void mpsc_queue <T> ::enqueue(Node* p)
+    {
+        Node* pPrev = pTail.exchange(p, std::memory_order_acq_rel);
+        pPrev->pNext.store(p, std::memory_order_release);
+    }
+
+    /*********************************************
+     * MPSC QUEUE :: PUSH
+     * add an item to the back of the queue
+     *    INPUT  : data to be added to the queue
+     *    OUTPUT :
+     *    COST   : O(1), no locks
+     *********************************************/
+    template <typename T>
+    void mpsc_queue <T> ::push(const T& data)
+    {
+        Node* p = acquire();
+        if (p)
+            p->data = data;
+        else
+            p = new Node(data);
+        enqueue(p);
+    }
+
+    template <typename T>
+    void mpsc_queue <T> ::push(T&& data)
+    {
+        Node* p = acquire();
+        if (p)
+            p->data = std::move(data);
+        else
+            p = new Node(std::move(data));
+        enqueue(p);
+    }
+
+    /*********************************************
+     * MPSC QUEUE :: TRY POP
+     * remove an item from the front of the queue.  The
+     * node holding it becomes the new dummy and the old
+     * dummy is recycled
+     *    INPUT  : where to put the item
+     *    OUTPUT : false if nothing was ready
+     *    COST   : O(1), consumer only
+     *********************************************/
+    template <typename T>
+    bool mpsc_queue <T> ::try_pop(T& data)
+    {
+        Node* pNext = pHead->pNext.load(std::memory_order_acquire);
+        if (pNext == nullptr)
+            return false;
+
+        data = std::move(pNext->data);
+        recycle(pHead);
+        pHead = pNext;
+        return true;
+    }
+
+    /*********************************************
+     * MPSC QUEUE :: DRAIN INTO
+     * cut off every item pushed so far with one exchange
+     * on the tail, then move them one by one onto the end
+     * of a list and recycle their nodes.  Only the cut is
+     * a single step; the list gets a new node per item.
+     * A producer that swung the tail but has not linked
+     * its node yet is waited for, since its item belongs
+     * to this batch
+     *    INPUT  : the list to append to
+     *    OUTPUT : the number of items taken
+     *    COST   : O(n), consumer only
+     *********************************************/
+    template <typename T>
+    size_t mpsc_queue <T> ::drain_into(list <T>& rhs)
+    {
+        // a fresh dummy closes off everything pushed before now
+        Node* pStub = acquire();
+        if (pStub == nullptr)
+            pStub = new Node;
+        Node* pLast = pTail.exchange(pStub, std::memory_order_acq_rel);
+
+        Node* p = pHead;
+        pHead = pStub;
+
+        size_t num = 0;
+        while (p != pLast)
+        {
+            Node* pNext;
+            while ((pNext = p->pNext.load(std::memory_order_acquire)) == nullptr)
+                std::this_thread::yield();
+
+            recycle(p);
+            p = pNext;
+            rhs.push_back(std::move(p->data));
+            num++;
+        }
+        recycle(p);
+        return num;
+    }
+
+    /*********************************************
+     * MPSC QUEUE :: EMPTY
+     * is anything ready for the consumer?
+     *    INPUT  :
+     *    OUTPUT : true if try_pop() would fail right now
+     *    COST   : O(1), consumer only
+     *********************************************/
+    template <typename T>
+    bool mpsc_queue <T> ::empty() const
+    {
+        return pHead->pNext.load(std::memory_order_acquire) == nullptr;
+    }
+
+}; // namespace custom
@@ -0,0 +1,420 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL LIST
+ * Summary:
+ *    Parallel algorithms over a custom::list.  A linked list cannot be
+ *    cut up by index, so before any thread starts we need split points:
+ *    iterators that divide the list into chunks of roughly equal size.
+ *    There are two ways to get them:
+ *
+ *      - one pointer walk over the list, which touches each node once
+ *        and does nothing else, so it is cheap next to the real work
+ *      - a list_checkpoints, which keeps an iterator every K nodes.  It
+ *        costs one walk to build, and then any number of passes can be
+ *        split without walking again, for as long as the list keeps
+ *        its shape
+ *
+ *    The chunks are then run on a work_stealing_pool, and the calling
+ *    thread helps.
+ *
+ *    Checkpoints also help a single thread.  Walking a scattered list
+ *    stalls on one cache miss after another, since the address of each
+ *    node is only known once the node before it has arrived.  A
+ *    checkpoint is an address known in advance, so a few scouts can walk
+ *    the segments ahead at the same time, and their misses overlap.
+ *
+ *    This will contain the definitions of:
+ *        list_checkpoints  : An iterator every K nodes of a list, and a
+ *                            prefetching walk from them
+ *        split_points      : Chunk boundaries from one walk
+ *        for_each          : Visit every item
+ *        transform_inplace : Replace every item with f(item)
+ *        transform_reduce  : Fold f(item) over the whole list
+ *        parallel_copy     : Deep copy, each chunk copied on its own thread
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include "workStealingPool.h"
+#include <algorithm>   // for std::min
+#include <cassert>     // for assert
+#include <vector>      // for std::vector
+
+class TestParallelList;    // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * LIST CHECKPOINTS
+     * An iterator to every stride-th node.  Inserting or
+     * erasing nodes invalidates it; call refresh() after
+     **************************************************/
+    template <typename T>
+    class list_checkpoints
+    {
+        friend class ::TestParallelList; // give unit tests access to the privates
+    public:
+        typedef typename list <T> ::iterator iterator;
+
+        //
+        // Construct
+        //
+
+        list_checkpoints(list <T>& l, size_t stride = 1024) : l(l), stride(stride ? stride : 1)
+        {
+            refresh();
+        }
+
+        //
+        // Access
+        //
+
+        void refresh();
+        std::vector<iterator> split_points(size_t numChunks) const;
+        list <T>& source() const { return l; }
+
+        //
+        // Traverse
+        //
+
+        template <class Function>
+        void for_each_prefetch(Function f, size_t numScouts = 4) const;
+
+        //
+        // Status
+        //
+
+        size_t size() const { return checkpoints.size(); }
+        size_t get_stride() const { return stride; }
+        // the list grew, shrank, or lost its first node since the last refresh
+        bool stale() const { return numElements != l.size() || first != l.begin(); }
+
+    private:
+        // member variables
+        list <T>& l;
+        size_t stride;                      // nodes between checkpoints
+        std::vector<iterator> checkpoints;  // nodes 0, stride, 2*stride, ...
+        size_t numElements;                 // size at the last refresh
+        iterator first;                     // begin() at the last refresh
+    };
+
+    /*********************************************
+     * LIST CHECKPOINTS :: REFRESH
+     * Walk the list once, keeping every stride-th node
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    void list_checkpoints <T> ::refresh()
+    {
+        checkpoints.clear();
+        checkpoints.reserve(l.size() / stride + 1);
+        size_t i = 0;
+        for (iterator it = l.begin(); it != l.end(); ++it, ++i)
+            if (i % stride == 0)
+                checkpoints.push_back(it);
+        numElements = l.size();
+        first = l.begin();
+    }
+
+    /*********************************************
+     * LIST CHECKPOINTS :: SPLIT POINTS
+     * Group neighboring checkpoints into chunks.  Every
+     * chunk but the last holds a whole number of strides
+     *    INPUT  : how many chunks we would like
+     *    OUTPUT : the boundaries, first begin() and last end()
+     *    COST   : O(numChunks), no walking
+     *********************************************/
+    template <typename T>
+    std::vector<typename list_checkpoints <T> ::iterator>
+    list_checkpoints <T> ::split_points(size_t numChunks) const
+    {
+        assert(!stale());
+        std::vector<iterator> bounds;
+        if (checkpoints.empty())
+            return bounds;
+        numChunks = std::max<size_t>(1, std::min(numChunks, checkpoints.size()));
+
+        size_t per = (checkpoints.size() + numChunks - 1) / numChunks;
+        for (size_t i = 0; i < checkpoints.size(); i += per)
+            bounds.push_back(checkpoints[i]);
+        bounds.push_back(l.end());
+        return bounds;
+    }
+
+    /*********************************************
+     * LIST CHECKPOINTS :: FOR EACH PREFETCH
+     * Call f on every item, in order, on this thread.  The
+     * segments are taken numScouts at a time.  While this
+     * group is visited, one scout per segment of the next
+     * group walks it, starting from its checkpoint.  Each
+     * step, one scout moves to the node it prefetched the
+     * last time its turn came, and prefetches the one
+     * after.  So no scout reads a node until it has had
+     * numScouts steps to arrive, and numScouts misses are
+     * in flight at once.  By the time the walk gets to a
+     * group, its nodes are in the cache.
+     *
+     * This pays off when the nodes are scattered and the
+     * groups fit in the cache.  For a list laid out in
+     * order, as compact() leaves it, the hardware already
+     * does this and plain for_each is as fast.  The first
+     * group is walked cold
+     *    INPUT  : what to call on each item, how many scouts
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Function>
+    void list_checkpoints <T> ::for_each_prefetch(Function f, size_t numScouts) const
+    {
+        assert(!stale());
+        size_t numSegments = checkpoints.size();
+        if (numScouts == 0 || numSegments < 2)
+        {
+            l.for_each(f);
+            return;
+        }
+
+        std::vector<iterator> scouts(numScouts);
+        std::vector<iterator> scoutEnds(numScouts);
+        for (size_t group = 0; group < numSegments; group += numScouts)
+        {
+            // send the scouts into the next group
+            for (size_t k = 0; k < numScouts; k++)
+            {
+                size_t segment = group + numScouts + k;
+                scouts[k] = scoutEnds[k] = l.end();
+                if (segment < numSegments)
+                {
+                    scouts[k] = checkpoints[segment];
+                    scoutEnds[k] = segment + 1 < numSegments ? checkpoints[segment + 1] : l.end();
+                    prefetch(&*scouts[k]);
+                }
+            }
+
+            // walk this group, moving one scout a step each time
+            size_t last = group + numScouts;
+            iterator end = last < numSegments ? checkpoints[last] : l.end();
+            size_t k = 0;
+            for (iterator it = checkpoints[group]; it != end; ++it)
+            {
+                if (scouts[k] != scoutEnds[k] && ++scouts[k] != scoutEnds[k])
+                    prefetch(&*scouts[k]);
+                k = (k + 1 == numScouts) ? 0 : k + 1;
+                f(*it);
+            }
+        }
+    }
+
+    /*********************************************
+     * SPLIT POINTS
+     * Walk the list once to divide it into chunks that
+     * differ in size by at most one
+     *    INPUT  : the list, how many chunks we would like
+     *    OUTPUT : the boundaries, first begin() and last end()
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    std::vector<typename list <T> ::iterator> split_points(list <T>& l, size_t numChunks)
+    {
+        std::vector<typename list <T> ::iterator> bounds;
+        if (l.empty())
+            return bounds;
+        numChunks = std::max<size_t>(1, std::min(numChunks, l.size()));
+
+        size_t base = l.size() / numChunks;
+        size_t extra = l.size() % numChunks;
+        typename list <T> ::iterator it = l.begin();
+        for (size_t c = 0; c < numChunks; c++)
+        {
+            bounds.push_back(it);
+            size_t num = base + (c < extra ? 1 : 0);
+            for (size_t i = 0; i < num; i++)
+                ++it;
+        }
+        bounds.push_back(l.end());
+        return bounds;
+    }
+
+    namespace detail
+    {
+        // a few chunks per worker, so stealing can even out the load
+        inline size_t chunksFor(const work_stealing_pool& pool)
+        {
+            return 4 * pool.size();
+        }
+
+        // run body(chunk, begin, end) for every chunk between the bounds
+        template <typename Iterator, typename Body>
+        void runChunks(work_stealing_pool& pool, const std::vector<Iterator>& bounds, Body body)
+        {
+            if (bounds.size() < 2)
+                return;
+            pool.parallel_for(0, bounds.size() - 1, [&bounds, &body](size_t c)
+            {
+                body(c, bounds[c], bounds[c + 1]);
+            }, 1);
+        }
+
+        template <typename T, typename Function>
+        void forEach(work_stealing_pool& pool,
+                     const std::vector<typename list <T> ::iterator>& bounds, Function& f)
+        {
+            typedef typename list <T> ::iterator iterator;
+            runChunks(pool, bounds, [&f](size_t, iterator it, iterator end)
+            {
+                for (; it != end; ++it)
+                    f(*it);
+            });
+        }
+
+        template <typename T, typename Function>
+        void transformInplace(work_stealing_pool& pool,
+                              const std::vector<typename list <T> ::iterator>& bounds, Function& f)
+        {
+            typedef typename list <T> ::iterator iterator;
+            runChunks(pool, bounds, [&f](size_t, iterator it, iterator end)
+            {
+                for (; it != end; ++it)
+                    *it = f(*it);
+            });
+        }
+
+        template <typename T, typename U, typename Reduce, typename Transform>
+        U transformReduce(work_stealing_pool& pool,
+                          const std::vector<typename list <T> ::iterator>& bounds,
+                          U init, Reduce& reduce, Transform& transform)
+        {
+            typedef typename list <T> ::iterator iterator;
+            if (bounds.size() < 2)
+                return init;
+
+            // every chunk is non-empty, so each starts from its own first item
+            std::vector<U> partials(bounds.size() - 1, init);
+            runChunks(pool, bounds, [&partials, &reduce, &transform](size_t c, iterator it, iterator end)
+            {
+                U sum = transform(*it);
+                for (++it; it != end; ++it)
+                    sum = reduce(sum, transform(*it));
+                partials[c] = sum;
+            });
+
+            // combine in list order, so reduce need not commute
+            for (size_t c = 0; c < partials.size(); c++)
+                init = reduce(init, partials[c]);
+            return init;
+        }
+
+        template <typename T>
+        list <T> parallelCopy(work_stealing_pool& pool,
+                              const std::vector<typename list <T> ::iterator>& bounds)
+        {
+            typedef typename list <T> ::iterator iterator;
+            list <T> lReturn;
+            if (bounds.size() < 2)
+                return lReturn;
+
+            // each chunk allocates its own nodes, then we stitch them together
+            std::vector<list <T>> pieces(bounds.size() - 1);
+            runChunks(pool, bounds, [&pieces](size_t c, iterator it, iterator end)
+            {
+                for (; it != end; ++it)
+                    pieces[c].push_back(*it);
+            });
+            for (size_t c = 0; c < pieces.size(); c++)
+                lReturn.splice(lReturn.end(), pieces[c]);
+            return lReturn;
+        }
+    }
+
+    /*********************************************
+     * FOR EACH
+     * Call f on every item.  Chunks run at the same time,
+     * so f must be safe to call from several threads
+     *    INPUT  : the pool, the list or its checkpoints, f
+     *    OUTPUT :
+     *    COST   : O(n / threads) plus one walk without checkpoints
+     *********************************************/
+    template <typename T, typename Function>
+    void for_each(work_stealing_pool& pool, list <T>& l, Function f)
+    {
+        detail::forEach<T>(pool, split_points(l, detail::chunksFor(pool)), f);
+    }
+
+    template <typename T, typename Function>
+    void for_each(work_stealing_pool& pool, const list_checkpoints <T>& cp, Function f)
+    {
+        detail::forEach<T>(pool, cp.split_points(detail::chunksFor(pool)), f);
+    }
+
+    /*********************************************
+     * TRANSFORM INPLACE
+     * Replace every item with f(item)
+     *    INPUT  : the pool, the list or its checkpoints, f
+     *    OUTPUT :
+     *    COST   : O(n / threads) plus one walk without checkpoints
+     *********************************************/
+    template <typename T, typename Function>
+    void transform_inplace(work_stealing_pool& pool, list <T>& l, Function f)
+    {
+        detail::transformInplace<T>(pool, split_points(l, detail::chunksFor(pool)), f);
+    }
+
+    template <typename T, typename Function>
+    void transform_inplace(work_stealing_pool& pool, const list_checkpoints <T>& cp, Function f)
+    {
+        detail::transformInplace<T>(pool, cp.split_points(detail::chunksFor(pool)), f);
+    }
+
+    /*********************************************
+     * TRANSFORM REDUCE
+     * Fold reduce over transform(item) for every item,
+     * starting from init.  reduce must be associative;
+     * it need not be commutative
+     *    INPUT  : the pool, the list or its checkpoints,
+     *             the starting value, reduce, transform
+     *    OUTPUT : the result
+     *    COST   : O(n / threads) plus one walk without checkpoints
+     *********************************************/
+    template <typename T, typename U, typename Reduce, typename Transform>
+    U transform_reduce(work_stealing_pool& pool, list <T>& l, U init, Reduce reduce, Transform transform)
+    {
+        return detail::transformReduce<T>(pool, split_points(l, detail::chunksFor(pool)),
+                                          init, reduce, transform);
+    }
+
+    template <typename T, typename U, typename Reduce, typename Transform>
+    U transform_reduce(work_stealing_pool& pool, const list_checkpoints <T>& cp,
+                       U init, Reduce reduce, Transform transform)
+    {
+        return detail::transformReduce<T>(pool, cp.split_points(detail::chunksFor(pool)),
+                                          init, reduce, transform);
+    }
+
+    /*********************************************
+     * PARALLEL COPY
+     * What the copy constructor does, but every chunk
+     * is copied into its own list on its own thread and
+     * the pieces are spliced together in order
+     *    INPUT  : the pool, the list or its checkpoints
+     *    OUTPUT : a deep copy
+     *    COST   : O(n / threads + chunks) plus one walk without checkpoints
+     *********************************************/
+    template <typename T>
+    list <T> parallel_copy(work_stealing_pool& pool, list <T>& rhs)
+    {
+        return detail::parallelCopy<T>(pool, split_points(rhs, detail::chunksFor(pool)));
+    }
+
+    template <typename T>
+    list <T> parallel_copy(work_stealing_pool& pool, const list_checkpoints <T>& cp)
+    {
+        return detail::parallelCopy<T>(pool, cp.split_points(detail::chunksFor(pool)));
+    }
+
+}; // namespace custom
@@ -0,0 +1,503 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT LIST
+ * Summary:
+ *    An immutable singly linked list.  Every "change" returns a new
+ *    version that shares the unchanged tail with the old one, so a
+ *    snapshot is just another reference to the same first node.  Nodes
+ *    are reference counted and freed when the last version that can
+ *    reach them goes away.
+ *
+ *    Because nodes never change once built, any number of threads can
+ *    walk their own version while another thread builds newer ones, with
+ *    no locks.  Only the reference counts are shared, and they are atomic.
+ *
+ *    A persistent_list object itself is not atomic: one thread must not
+ *    copy it while another assigns to it.  To publish the current version
+ *    to other threads, keep it in an atomic_persistent_list.  Readers
+ *    load() a snapshot from it while a writer store()s newer versions.
+ *
+ *    This will contain the class definition of:
+ *        persistent_list        : A class that represents an immutable list
+ *        const_iterator         : A read-only iterator through a version
+ *        atomic_persistent_list : The current version, shared between threads
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <initializer_list>
+#include <utility>
+#include <vector>      // for std::vector
+#include "epoch.h"     // for epoch_domain
+
+class TestPersistentList;  // forward declaration for unit tests
+
+namespace custom
+{
+    template <typename T>
+    class atomic_persistent_list;
+};
+
+namespace custom
+{
+
+    /**************************************************
+     * PERSISTENT LIST
+     * A list whose versions never change
+     **************************************************/
+    template <typename T>
+    class persistent_list
+    {
+        friend class ::TestPersistentList; // give unit tests access to the privates
+        friend class atomic_persistent_list <T>;
+    public:
+        //
+        // Construct
+        //
+
+        persistent_list() : numElements(0), pHead(nullptr) {}
+        persistent_list(const persistent_list& rhs);
+        persistent_list(persistent_list&& rhs);
+        persistent_list(const std::initializer_list<T>& il);
+        ~persistent_list()
+        {
+            release(pHead);
+        }
+
+        //
+        // Assign
+        //
+
+        persistent_list& operator = (const persistent_list& rhs);
+        persistent_list& operator = (persistent_list&& rhs);
+        void swap(persistent_list& rhs);
+
+        //
+        // Iterator
+        //
+
+        class const_iterator;
+        const_iterator begin() const { return const_iterator(pHead); }
+        const_iterator end() const { return const_iterator(nullptr); }
+
+        //
+        // Access
+        //
+
+        const T& front() const;
+
+        //
+        // New versions
+        //
+
+        persistent_list push_front(const T& data) const;
+        persistent_list push_front(T&& data) const;
+        persistent_list pop_front() const;
+        persistent_list insert(const_iterator it, const T& data) const;
+        persistent_list erase(const_iterator it) const;
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return numElements == 0; }
+        size_t size() const { return numElements; }
+
+    private:
+        // nested linked list class
+        class Node;
+
+        // adopt a chain we already hold a reference to
+        persistent_list(size_t num, Node* pHead) : numElements(num), pHead(pHead) {}
+
+        // copy the nodes in front of pStop, ending the copy with pTail
+        static Node* copyPrefix(Node* pFirst, Node* pStop, Node* pTail);
+
+        // reference counting on a chain
+        static Node* retain(Node* p);
+        static void release(Node* p);
+
+        // member variables
+        size_t numElements; // number of nodes reachable from pHead
+        Node* pHead;        // first node of this version
+    };
+
+    /*************************************************
+     * NODE
+     * the node class.  data and pNext are fixed at
+     * construction; only the reference count changes
+     *************************************************/
+    template <typename T>
+    class persistent_list <T> ::Node
+    {
+    public:
+        Node(const T& data, Node* pNext) : data(data), pNext(pNext), refs(1) {}
+        Node(T&& data, Node* pNext) : data(std::move(data)), pNext(pNext), refs(1) {}
+
+        const T data;              // user data
+        Node* const pNext;         // pointer to next node, shared with other versions
+        std::atomic<size_t> refs;  // number of versions and nodes pointing here
+    };
+
+    /*************************************************
+     * PERSISTENT LIST CONST ITERATOR
+     * Read through one version
+     ************************************************/
+    template <typename T>
+    class persistent_list <T> ::const_iterator
+    {
+        friend class ::TestPersistentList; // give unit tests access to the privates
+        friend class persistent_list <T>;
+    public:
+        const_iterator() : p(nullptr) {}
+        const_iterator(Node* p) : p(p) {}
+
+        // equals, not equals operator
+        bool operator == (const const_iterator& rhs) const { return p == rhs.p; }
+        bool operator != (const const_iterator& rhs) const { return p != rhs.p; }
+
+        // dereference operator, read only
+        const T& operator * () const
+        {
+            assert(p != nullptr);
+            return p->data;
+        }
+
+        // prefix increment
+        const_iterator& operator ++ ()
+        {
+            p = p->pNext;
+            return *this;
+        }
+
+        // postfix increment
+        const_iterator operator ++ (int postfix)
+        {
+            const_iterator temp(*this);
+            p = p->pNext;
+            return temp;
+        }
+
+    private:
+        Node* p;
+    };
+
+    /*****************************************
+     * PERSISTENT LIST :: RETAIN
+     * Add a reference to a node
+     ****************************************/
+    template <typename T>
+    typename persistent_list <T> ::Node* persistent_list <T> ::retain(Node* p)
+    {
+        if (p)
+            p->refs.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+
+    /*****************************************
+     * PERSISTENT LIST :: RELEASE
+     * Drop a reference to a node.  When it was the last,
+     * the node goes and so does its reference to the next
+     * one.  This is a loop, not recursion, so a long
+     * unshared chain cannot overflow the stack
+     ****************************************/
+    template <typename T>
+    void persistent_list <T> ::release(Node* p)
+    {
+        while (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Node* pNext = p->pNext;
+            delete p;
+            p = pNext;
+        }
+    }
+
+    /*****************************************
+     * PERSISTENT LIST :: COPY PREFIX
+     * Build fresh copies of the nodes from pFirst up to
+     * (not including) pStop, with the last copy pointing
+     * at pTail.  pTail's reference is handed to the copy.
+     * If a copy throws, the copies made so far and the
+     * reference to pTail are released
+     *     COST   : O(k) in the length of the prefix
+     ****************************************/
+    template <typename T>
+    typename persistent_list <T> ::Node* persistent_list <T> ::copyPrefix(Node* pFirst,
+        Node* pStop, Node* pTail)
+    {
+        Node* pResult = pTail;
+        try
+        {
+            // the nodes are singly linked, so remember the prefix to build it back to front
+            std::vector<Node*> prefix;
+            for (Node* p = pFirst; p != pStop; p = p->pNext)
+                prefix.push_back(p);
+
+            for (size_t i = prefix.size(); i > 0; i--)
+                pResult = new Node(prefix[i - 1]->data, pResult);
+        }
+        catch (...)
+        {
+            release(pResult);
+            throw;
+        }
+        return pResult;
+    }
+
+    /*****************************************
+     * PERSISTENT LIST :: COPY constructors
+     * A snapshot: O(1)
+     ****************************************/
+    template <typename T>
+    persistent_list <T> ::persistent_list(const persistent_list& rhs)
+        : numElements(rhs.numElements), pHead(retain(rhs.pHead))
+    {
+    }
+
+    /*****************************************
+     * PERSISTENT LIST :: MOVE constructors
+     ****************************************/
+    template <typename T>
+    persistent_list <T> ::persistent_list(persistent_list&& rhs)
+        : numElements(rhs.numElements), pHead(rhs.pHead)
+    {
+        rhs.numElements = 0;
+        rhs.pHead = nullptr;
+    }
+
+    /*****************************************
+     * PERSISTENT LIST :: INITIALIZER constructors
+     * Build the chain back to front
+     ****************************************/
+    template <typename T>
+    persistent_list <T> ::persistent_list(const std::initializer_list<T>& il)
+        : numElements(il.size()), pHead(nullptr)
+    {
+        for (const T* p = il.end(); p != il.begin(); )
+            pHead = new Node(*--p, pHead);
+    }
+
+    /**********************************************
+     * PERSISTENT LIST :: assignment operator
+     * Take a snapshot of another version
+     *     INPUT  : the version to share
+     *     OUTPUT :
+     *     COST   : O(1), plus freeing nodes only we could reach
+     *********************************************/
+    template <typename T>
+    persistent_list <T>& persistent_list <T> :: operator = (const persistent_list& rhs)
+    {
+        Node* pOld = pHead;
+        pHead = retain(rhs.pHead);
+        numElements = rhs.numElements;
+        release(pOld);
+        return *this;
+    }
+
+    template <typename T>
+    persistent_list <T>& persistent_list <T> :: operator = (persistent_list&& rhs)
+    {
+        if (this != &rhs)
+        {
+            release(pHead);
+            pHead = rhs.pHead;
+            numElements = rhs.numElements;
+            rhs.pHead = nullptr;
+            rhs.numElements = 0;
+        }
+        return *this;
+    }
+
+    template <typename T>
+    void persistent_list <T> ::swap(persistent_list& rhs)
+    {
+        std::swap(numElements, rhs.numElements);
+        std::swap(pHead, rhs.pHead);
+    }
+
+    /*********************************************
+     * PERSISTENT LIST :: PUSH FRONT
+     * a new version with one more item in front
+     *     INPUT  : data to be added
+     *     OUTPUT : the new version
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    persistent_list <T> persistent_list <T> ::push_front(const T& data) const
+    {
+        return persistent_list(numElements + 1, new Node(data, retain(pHead)));
+    }
+
+    template <typename T>
+    persistent_list <T> persistent_list <T> ::push_front(T&& data) const
+    {
+        return persistent_list(numElements + 1, new Node(std::move(data), retain(pHead)));
+    }
+
+    /*********************************************
+     * PERSISTENT LIST :: POP FRONT
+     * a new version without the first item
+     *     INPUT  :
+     *     OUTPUT : the new version, sharing every node but one
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    persistent_list <T> persistent_list <T> ::pop_front() const
+    {
+        if (pHead == nullptr)
+            return persistent_list();
+        return persistent_list(numElements - 1, retain(pHead->pNext));
+    }
+
+    /******************************************
+     * PERSISTENT LIST :: INSERT
+     * a new version with an item in front of it
+     *     INPUT  : an iterator into this version
+     *              data to be added
+     *     OUTPUT : the new version.  Everything from it
+     *              onward is shared
+     *     COST   : O(k) where k is the position of it
+     ******************************************/
+    template <typename T>
+    persistent_list <T> persistent_list <T> ::insert(const_iterator it, const T& data) const
+    {
+        Node* pNew = new Node(data, retain(it.p));
+        return persistent_list(numElements + 1, copyPrefix(pHead, it.p, pNew));
+    }
+
+    /******************************************
+     * PERSISTENT LIST :: ERASE
+     * a new version without the item at it
+     *     INPUT  : an iterator into this version
+     *     OUTPUT : the new version.  Everything after it
+     *              is shared
+     *     COST   : O(k) where k is the position of it
+     ******************************************/
+    template <typename T>
+    persistent_list <T> persistent_list <T> ::erase(const_iterator it) const
+    {
+        if (it.p == nullptr)
+            return *this;
+        return persistent_list(numElements - 1,
+                               copyPrefix(pHead, it.p, retain(it.p->pNext)));
+    }
+
+    /*********************************************
+     * PERSISTENT LIST :: FRONT
+     * retrieves the first element in the list
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    const T& persistent_list <T> ::front() const
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return pHead->data;
+    }
+
+    /**************************************************
+     * ATOMIC PERSISTENT LIST
+     * One version, swapped as a whole, that any thread
+     * can take a snapshot of at any time.  Replaced
+     * versions are retired to an epoch domain, so a
+     * reader that has just read the pointer can still
+     * take its reference before the old version goes
+     **************************************************/
+    template <typename T>
+    class atomic_persistent_list
+    {
+        friend class ::TestPersistentList; // give unit tests access to the privates
+    public:
+        typedef persistent_list <T> version;
+
+        atomic_persistent_list(const version& v = version(),
+                               epoch_domain& domain = epoch_domain::global()) :
+            pCurrent(new version(v)), domain(domain) {}
+        atomic_persistent_list(const atomic_persistent_list& rhs) = delete;
+        atomic_persistent_list& operator = (const atomic_persistent_list& rhs) = delete;
+        ~atomic_persistent_list()
+        {
+            delete pCurrent.load(std::memory_order_relaxed);
+        }
+
+        version load() const;
+        void store(const version& v) { exchange(v); }
+        version exchange(const version& v);
+        bool compare_exchange_strong(version& expected, const version& desired);
+
+    private:
+        std::atomic<version*> pCurrent;  // never nullptr
+        epoch_domain& domain;            // where replaced versions wait
+    };
+
+    /*********************************************
+     * ATOMIC PERSISTENT LIST :: LOAD
+     * take a snapshot of the current version
+     *     INPUT  :
+     *     OUTPUT : the version, ours to keep
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    persistent_list <T> atomic_persistent_list <T> ::load() const
+    {
+        epoch_domain::guard g(domain);
+        return *pCurrent.load(std::memory_order_acquire);
+    }
+
+    /*********************************************
+     * ATOMIC PERSISTENT LIST :: EXCHANGE
+     * make a version the current one
+     *     INPUT  : the new version
+     *     OUTPUT : the version it replaced
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    persistent_list <T> atomic_persistent_list <T> ::exchange(const version& v)
+    {
+        version* pNew = new version(v);
+        version* pOld = pCurrent.exchange(pNew, std::memory_order_acq_rel);
+        version old(*pOld);
+        domain.retire(pOld);
+        return old;
+    }
+
+    /*********************************************
+     * ATOMIC PERSISTENT LIST :: COMPARE EXCHANGE
+     * make desired the current version, but only if
+     * expected still is.  Versions are the same when
+     * they start at the same node
+     *     INPUT  : the version we think is current,
+     *              the one to replace it with
+     *     OUTPUT : true if replaced.  If not, expected
+     *              is now the current version
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T>
+    bool atomic_persistent_list <T> ::compare_exchange_strong(version& expected,
+                                                             const version& desired)
+    {
+        version* pNew = new version(desired);
+        for (;;)
+        {
+            epoch_domain::guard g(domain);
+            version* pOld = pCurrent.load(std::memory_order_acquire);
+            if (pOld->pHead != expected.pHead)
+            {
+                expected = *pOld;
+                delete pNew;
+                return false;
+            }
+            if (pCurrent.compare_exchange_strong(pOld, pNew, std::memory_order_acq_rel))
+            {
+                domain.retire(pOld);
+                return true;
+            }
+        }
+    }
+
+}; // namespace custom
@@ -0,0 +1,819 @@
+/***********************************************************************
+ * Header:
+ *    POLICY LIST
+ * Summary:
+ *    A singly or doubly linked list whose trade-offs are chosen at
+ *    compile time.  Each is a policy, listed in any order after T:
+ *
+ *        size   : counted_size (O(1) size)     or uncounted_size
+ *        tail   : with_tail (O(1) push_back)   or no_tail
+ *        links  : double_links (O(1) pop_back) or single_links
+ *        lock   : no_lock, mutex_lock, or spin_lock
+ *        access : checked (throws when empty)  or unchecked (asserts)
+ *
+ *    Anything not listed gets the first choice, which is how
+ *    custom::list behaves.  The interface is a subset of custom::list's:
+ *    push and pop at either end, insert() and erase() at an iterator,
+ *    remove_if(), for_each(), copy and move.  The iterator is forward
+ *    only, since a singly linked list cannot go back, so there is no
+ *    rbegin() or operator --.  Each policy is a base class of the list.
+ *    One that keeps nothing is an empty class and, thanks to the empty
+ *    base optimization, takes no room at all: the leanest list is one
+ *    pointer, and its nodes are an item and one pointer.
+ *
+ *    This will contain the class definition of:
+ *        policy_list        : The list
+ *        policy::*          : The policies to choose from
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <atomic>        // for std::atomic
+#include <cassert>       // for assert
+#include <mutex>         // for std::mutex
+#include <thread>        // for std::this_thread::yield
+#include <type_traits>   // for std::conditional
+#include <utility>       // for std::swap
+
+class TestPolicyList;    // forward declaration for unit tests
+
+// MSVC only lays out the first empty base in zero bytes unless asked
+#if defined(_MSC_VER)
+#define CUSTOM_EMPTY_BASES __declspec(empty_bases)
+#else
+#define CUSTOM_EMPTY_BASES
+#endif
+
+namespace custom
+{
+    namespace policy
+    {
+        // what each policy decides
+        struct size_category {};
+        struct tail_category {};
+        struct link_category {};
+        struct lock_category {};
+        struct access_category {};
+
+        /**************************************************
+         * SIZE POLICIES
+         * Keep a count, or walk the list when asked
+         **************************************************/
+        struct counted_size
+        {
+            typedef size_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                size_t count(const Node*) const { return numElements; }
+                void grew()   { numElements++; }
+                void shrank() { numElements--; }
+                void zero()   { numElements = 0; }
+                void swap(holder& rhs) { std::swap(numElements, rhs.numElements); }
+            private:
+                size_t numElements = 0;
+            };
+        };
+
+        struct uncounted_size
+        {
+            typedef size_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                size_t count(const Node* p) const
+                {
+                    size_t num = 0;
+                    for (; p != nullptr; p = p->pNext)
+                        num++;
+                    return num;
+                }
+                void grew()   {}
+                void shrank() {}
+                void zero()   {}
+                void swap(holder&) {}
+            };
+        };
+
+        /**************************************************
+         * TAIL POLICIES
+         * Remember the last node, or walk to it
+         **************************************************/
+        struct with_tail
+        {
+            typedef tail_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                Node* tail(Node*) const { return pTail; }
+                void setTail(Node* p) { pTail = p; }
+                void swap(holder& rhs) { std::swap(pTail, rhs.pTail); }
+            private:
+                Node* pTail = nullptr;
+            };
+        };
+
+        struct no_tail
+        {
+            typedef tail_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                Node* tail(Node* p) const
+                {
+                    if (p != nullptr)
+                        while (p->pNext != nullptr)
+                            p = p->pNext;
+                    return p;
+                }
+                void setTail(Node*) {}
+                void swap(holder&) {}
+            };
+        };
+
+        /**************************************************
+         * LINK POLICIES
+         * Whether a node knows the one before it
+         **************************************************/
+        struct double_links
+        {
+            typedef link_category category;
+            static const bool doubly = true;
+            template <typename Node>
+            class holder {};
+        };
+
+        struct single_links
+        {
+            typedef link_category category;
+            static const bool doubly = false;
+            template <typename Node>
+            class holder {};
+        };
+
+        /**************************************************
+         * LOCK POLICIES
+         * Every operation on the list takes the lock
+         **************************************************/
+        struct no_lock
+        {
+            typedef lock_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                void lock() const   {}
+                void unlock() const {}
+            };
+        };
+
+        struct mutex_lock
+        {
+            typedef lock_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                void lock() const   { m.lock(); }
+                void unlock() const { m.unlock(); }
+            private:
+                mutable std::mutex m;
+            };
+        };
+
+        // for critical sections only a few instructions long
+        struct spin_lock
+        {
+            typedef lock_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                void lock() const
+                {
+                    while (locked.exchange(true, std::memory_order_acquire))
+                        while (locked.load(std::memory_order_relaxed))
+                            std::this_thread::yield();
+                }
+                void unlock() const { locked.store(false, std::memory_order_release); }
+            private:
+                mutable std::atomic<bool> locked{ false };
+            };
+        };
+
+        /**************************************************
+         * ACCESS POLICIES
+         * What front() and back() do on an empty list
+         **************************************************/
+        struct checked
+        {
+            typedef access_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                static void check(bool empty)
+                {
+                    if (empty)
+                        throw "ERROR: unable to access data from an empty list";
+                }
+            };
+        };
+
+        struct unchecked
+        {
+            typedef access_category category;
+            template <typename Node>
+            class holder
+            {
+            protected:
+                static void check(bool empty) { assert(!empty); }
+            };
+        };
+
+        /**************************************************
+         * SELECT
+         * The policy in the list with this category, or
+         * the default if there is none
+         **************************************************/
+        template <typename Category, typename Default, typename... Policies>
+        struct select
+        {
+            typedef Default type;
+        };
+
+        template <typename Category, typename Default, typename Policy, typename... Policies>
+        struct select <Category, Default, Policy, Policies...>
+        {
+            typedef typename std::conditional<
+                std::is_same<typename Policy::category, Category>::value,
+                Policy,
+                typename select<Category, Default, Policies...>::type>::type type;
+        };
+    }
+
+    /**************************************************
+     * POLICY NODE
+     * An item and its links; pPrev only if doubly linked
+     **************************************************/
+    template <typename T, bool doubly>
+    struct policy_node
+    {
+        policy_node(const T& data) : data(data), pNext(nullptr), pPrev(nullptr) {}
+        T data;
+        policy_node* pNext;
+        policy_node* pPrev;
+    };
+
+    template <typename T>
+    struct policy_node <T, false>
+    {
+        policy_node(const T& data) : data(data), pNext(nullptr) {}
+        T data;
+        policy_node* pNext;
+    };
+
+    /**************************************************
+     * POLICY TRAITS
+     * The chosen policies, and the node they imply
+     **************************************************/
+    template <typename T, typename... Policies>
+    struct policy_traits
+    {
+        typedef typename policy::select<policy::size_category, policy::counted_size, Policies...>::type size_policy;
+        typedef typename policy::select<policy::tail_category, policy::with_tail, Policies...>::type tail_policy;
+        typedef typename policy::select<policy::link_category, policy::double_links, Policies...>::type link_policy;
+        typedef typename policy::select<policy::lock_category, policy::no_lock, Policies...>::type lock_policy;
+        typedef typename policy::select<policy::access_category, policy::checked, Policies...>::type access_policy;
+        typedef policy_node<T, link_policy::doubly> Node;
+    };
+
+    /**************************************************
+     * POLICY LIST
+     * Just like list, with the trade-offs chosen by you
+     **************************************************/
+    template <typename T, typename... Policies>
+    class CUSTOM_EMPTY_BASES policy_list :
+        private policy_traits<T, Policies...>::size_policy::template holder<typename policy_traits<T, Policies...>::Node>,
+        private policy_traits<T, Policies...>::tail_policy::template holder<typename policy_traits<T, Policies...>::Node>,
+        private policy_traits<T, Policies...>::lock_policy::template holder<typename policy_traits<T, Policies...>::Node>,
+        private policy_traits<T, Policies...>::access_policy::template holder<typename policy_traits<T, Policies...>::Node>
+    {
+        friend class ::TestPolicyList; // give unit tests access to the privates
+    public:
+        typedef policy_traits<T, Policies...> traits;
+        typedef typename traits::Node Node;
+        class iterator;
+
+        //
+        // Construct
+        //
+
+        policy_list() : pHead(nullptr) {}
+        policy_list(const policy_list& rhs);
+        policy_list(policy_list&& rhs);
+        ~policy_list() { clearNodes(); }
+        policy_list& operator = (const policy_list& rhs);
+        policy_list& operator = (policy_list&& rhs);
+
+        //
+        // Access
+        //
+
+        T& front();
+        T& back();
+        iterator begin() { return iterator(pHead); }
+        iterator end()   { return iterator(nullptr); }
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_back(const T& data);
+        iterator insert(iterator it, const T& data);
+
+        //
+        // Remove
+        //
+
+        void pop_front();
+        void pop_back();
+        iterator erase(iterator it);
+        template <class Predicate>
+        size_t remove_if(Predicate pred);
+        void clear();
+
+        //
+        // Traverse
+        //
+
+        template <class Function>
+        void for_each(Function f);
+
+        //
+        // Status
+        //
+
+        size_t size() const;
+        bool empty() const;
+
+    private:
+        typedef typename traits::size_policy::template holder<Node> size_base;
+        typedef typename traits::tail_policy::template holder<Node> tail_base;
+        typedef typename traits::lock_policy::template holder<Node> lock_base;
+        typedef typename traits::access_policy::template holder<Node> access_base;
+
+        // holds the list's lock for a scope
+        class Guard
+        {
+        public:
+            Guard(const policy_list& l) : l(l) { l.lock_base::lock(); }
+            ~Guard() { l.lock_base::unlock(); }
+        private:
+            const policy_list& l;
+        };
+
+        // set pPrev, if there is one
+        static void setPrev(Node* p, Node* pPrev, std::true_type)  { p->pPrev = pPrev; }
+        static void setPrev(Node*, Node*, std::false_type)         {}
+        static void setPrev(Node* p, Node* pPrev)
+        {
+            setPrev(p, pPrev, std::integral_constant<bool, traits::link_policy::doubly>());
+        }
+
+        // the node before p: one step back, or a walk from the front
+        Node* before(Node* p, std::true_type) const  { return p->pPrev; }
+        Node* before(Node* p, std::false_type) const
+        {
+            Node* pBefore = nullptr;
+            for (Node* pWalk = pHead; pWalk != p; pWalk = pWalk->pNext)
+                pBefore = pWalk;
+            return pBefore;
+        }
+        Node* before(Node* p) const
+        {
+            return before(p, std::integral_constant<bool, traits::link_policy::doubly>());
+        }
+
+        void append(const T& data);
+        void clearNodes();
+        void swapState(policy_list& rhs);
+
+        // member variables
+        Node* pHead;
+    };
+
+    /*************************************************
+     * POLICY LIST ITERATOR
+     * Forward only.  Takes no lock, so iterate a locked
+     * list with for_each() instead
+     ************************************************/
+    template <typename T, typename... Policies>
+    class policy_list <T, Policies...> ::iterator
+    {
+        friend class policy_list <T, Policies...>;
+    public:
+        iterator(Node* p = nullptr) : p(p) {}
+        bool operator == (const iterator& rhs) const { return p == rhs.p; }
+        bool operator != (const iterator& rhs) const { return p != rhs.p; }
+        T& operator * () const
+        {
+            assert(p != nullptr);
+            return p->data;
+        }
+        iterator& operator ++ ()
+        {
+            p = p->pNext;
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            p = p->pNext;
+            return temp;
+        }
+    private:
+        Node* p;
+    };
+
+    /*****************************************
+     * POLICY LIST :: COPY and MOVE
+     * The bases are not copied: a copy gets a lock of
+     * its own and counts its own items. Assignment
+     * copies once and swaps the copy in.  A move takes
+     * the nodes, the count and the tail, but not the lock
+     ****************************************/
+    template <typename T, typename... Policies>
+    policy_list <T, Policies...> ::policy_list(const policy_list& rhs) :
+        size_base(), tail_base(), lock_base(), access_base(), pHead(nullptr)
+    {
+        Guard guard(rhs);
+        try
+        {
+            for (Node* p = rhs.pHead; p != nullptr; p = p->pNext)
+                append(p->data);
+        }
+        catch (...)
+        {
+            // no destructor runs for a half-built list
+            clearNodes();
+            throw;
+        }
+    }
+
+    template <typename T, typename... Policies>
+    policy_list <T, Policies...>& policy_list <T, Policies...> ::operator = (const policy_list& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        // if the copy throws, nothing here has changed; the old
+        // nodes leave with the copy, after the lock is released
+        policy_list copy(rhs);
+        Guard guard(*this);
+        swapState(copy);
+        return *this;
+    }
+
+    template <typename T, typename... Policies>
+    policy_list <T, Policies...> ::policy_list(policy_list&& rhs) :
+        size_base(), tail_base(), lock_base(), access_base(), pHead(nullptr)
+    {
+        Guard guard(rhs);
+        swapState(rhs);
+    }
+
+    template <typename T, typename... Policies>
+    policy_list <T, Policies...>& policy_list <T, Policies...> ::operator = (policy_list&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        // the old nodes leave with the temporary, after the lock is released
+        policy_list temp(std::move(rhs));
+        Guard guard(*this);
+        swapState(temp);
+        return *this;
+    }
+
+    // trade nodes, count and tail; the caller holds the locks it needs
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::swapState(policy_list& rhs)
+    {
+        std::swap(pHead, rhs.pHead);
+        size_base::swap(rhs);
+        tail_base::swap(rhs);
+    }
+
+    /*********************************************
+     * POLICY LIST :: FRONT and BACK
+     * The first and last items
+     *    INPUT  :
+     *    OUTPUT : the item
+     *    COST   : O(1), back() is O(n) with no_tail
+     *********************************************/
+    template <typename T, typename... Policies>
+    T& policy_list <T, Policies...> ::front()
+    {
+        Guard guard(*this);
+        access_base::check(pHead == nullptr);
+        return pHead->data;
+    }
+
+    template <typename T, typename... Policies>
+    T& policy_list <T, Policies...> ::back()
+    {
+        Guard guard(*this);
+        access_base::check(pHead == nullptr);
+        return tail_base::tail(pHead)->data;
+    }
+
+    /*********************************************
+     * POLICY LIST :: PUSH FRONT
+     * Add an item to the front
+     *    INPUT  : the item
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::push_front(const T& data)
+    {
+        Node* pNew = new Node(data);
+        Guard guard(*this);
+        pNew->pNext = pHead;
+        if (pHead != nullptr)
+            setPrev(pHead, pNew);
+        else
+            tail_base::setTail(pNew);
+        pHead = pNew;
+        size_base::grew();
+    }
+
+    /*********************************************
+     * POLICY LIST :: PUSH BACK
+     * Add an item to the back
+     *    INPUT  : the item
+     *    OUTPUT :
+     *    COST   : O(1), O(n) with no_tail
+     *********************************************/
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::push_back(const T& data)
+    {
+        Node* pNew = new Node(data);
+        Guard guard(*this);
+        Node* pLast = tail_base::tail(pHead);
+        if (pLast != nullptr)
+        {
+            pLast->pNext = pNew;
+            setPrev(pNew, pLast);
+        }
+        else
+            pHead = pNew;
+        tail_base::setTail(pNew);
+        size_base::grew();
+    }
+
+    // push_back for someone already holding the lock
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::append(const T& data)
+    {
+        Node* pNew = new Node(data);
+        Node* pLast = tail_base::tail(pHead);
+        if (pLast != nullptr)
+        {
+            pLast->pNext = pNew;
+            setPrev(pNew, pLast);
+        }
+        else
+            pHead = pNew;
+        tail_base::setTail(pNew);
+        size_base::grew();
+    }
+
+    /*********************************************
+     * POLICY LIST :: INSERT
+     * Add an item in front of it, or at the back if it
+     * is end()
+     *    INPUT  : where, and the item
+     *    OUTPUT : an iterator to the new item
+     *    COST   : O(1), O(n) with single_links, or at
+     *             end() with no_tail
+     *********************************************/
+    template <typename T, typename... Policies>
+    typename policy_list <T, Policies...> ::iterator
+    policy_list <T, Policies...> ::insert(iterator it, const T& data)
+    {
+        Node* pNew = new Node(data);
+        Guard guard(*this);
+        Node* pNext = it.p;
+        Node* pBefore = (pNext != nullptr) ? before(pNext) : tail_base::tail(pHead);
+        pNew->pNext = pNext;
+        setPrev(pNew, pBefore);
+        if (pBefore != nullptr)
+            pBefore->pNext = pNew;
+        else
+            pHead = pNew;
+        if (pNext != nullptr)
+            setPrev(pNext, pNew);
+        else
+            tail_base::setTail(pNew);
+        size_base::grew();
+        return iterator(pNew);
+    }
+
+    /*********************************************
+     * POLICY LIST :: POP FRONT
+     * Remove the first item, if there is one
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::pop_front()
+    {
+        Node* pOld;
+        {
+            Guard guard(*this);
+            pOld = pHead;
+            if (pOld == nullptr)
+                return;
+            pHead = pOld->pNext;
+            if (pHead != nullptr)
+                setPrev(pHead, nullptr);
+            else
+                tail_base::setTail(nullptr);
+            size_base::shrank();
+        }
+        delete pOld;
+    }
+
+    /*********************************************
+     * POLICY LIST :: POP BACK
+     * Remove the last item, if there is one
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1), O(n) with no_tail or single_links
+     *********************************************/
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::pop_back()
+    {
+        Node* pOld;
+        {
+            Guard guard(*this);
+            pOld = tail_base::tail(pHead);
+            if (pOld == nullptr)
+                return;
+            Node* pBefore = before(pOld);
+            if (pBefore != nullptr)
+                pBefore->pNext = nullptr;
+            else
+                pHead = nullptr;
+            tail_base::setTail(pBefore);
+            size_base::shrank();
+        }
+        delete pOld;
+    }
+
+    /*********************************************
+     * POLICY LIST :: ERASE
+     * Remove the item it refers to
+     *    INPUT  : the item, which must be in this list
+     *    OUTPUT : an iterator to the item after it
+     *    COST   : O(1), O(n) with single_links
+     *********************************************/
+    template <typename T, typename... Policies>
+    typename policy_list <T, Policies...> ::iterator
+    policy_list <T, Policies...> ::erase(iterator it)
+    {
+        Node* pOld = it.p;
+        if (pOld == nullptr)
+            return end();
+
+        Node* pNext;
+        {
+            Guard guard(*this);
+            pNext = pOld->pNext;
+            Node* pBefore = before(pOld);
+            if (pBefore != nullptr)
+                pBefore->pNext = pNext;
+            else
+                pHead = pNext;
+            if (pNext != nullptr)
+                setPrev(pNext, pBefore);
+            else
+                tail_base::setTail(pBefore);
+            size_base::shrank();
+        }
+        delete pOld;
+        return iterator(pNext);
+    }
+
+    /*********************************************
+     * POLICY LIST :: REMOVE IF
+     * Remove every item the predicate picks out
+     *    INPUT  : the predicate
+     *    OUTPUT : how many were removed
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T, typename... Policies>
+    template <class Predicate>
+    size_t policy_list <T, Policies...> ::remove_if(Predicate pred)
+    {
+        Guard guard(*this);
+        size_t num = 0;
+        Node* pBefore = nullptr;
+        Node* p = pHead;
+        while (p != nullptr)
+        {
+            Node* pNext = p->pNext;
+            if (pred(p->data))
+            {
+                if (pBefore != nullptr)
+                    pBefore->pNext = pNext;
+                else
+                    pHead = pNext;
+                if (pNext != nullptr)
+                    setPrev(pNext, pBefore);
+                else
+                    tail_base::setTail(pBefore);
+                delete p;
+                size_base::shrank();
+                num++;
+            }
+            else
+                pBefore = p;
+            p = pNext;
+        }
+        return num;
+    }
+
+    /*********************************************
+     * POLICY LIST :: CLEAR
+     * Remove every item
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::clear()
+    {
+        Guard guard(*this);
+        clearNodes();
+    }
+
+    template <typename T, typename... Policies>
+    void policy_list <T, Policies...> ::clearNodes()
+    {
+        while (pHead != nullptr)
+        {
+            Node* pNext = pHead->pNext;
+            delete pHead;
+            pHead = pNext;
+        }
+        tail_base::setTail(nullptr);
+        size_base::zero();
+    }
+
+    /*********************************************
+     * POLICY LIST :: FOR EACH
+     * Call f on every item, front to back, holding the lock
+     *    INPUT  : what to call
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T, typename... Policies>
+    template <class Function>
+    void policy_list <T, Policies...> ::for_each(Function f)
+    {
+        Guard guard(*this);
+        for (Node* p = pHead; p != nullptr; p = p->pNext)
+            f(p->data);
+    }
+
+    /*********************************************
+     * POLICY LIST :: SIZE and EMPTY
+     *    INPUT  :
+     *    OUTPUT : how many items, or whether there are none
+     *    COST   : O(1), size() is O(n) with uncounted_size
+     *********************************************/
+    template <typename T, typename... Policies>
+    size_t policy_list <T, Policies...> ::size() const
+    {
+        Guard guard(*this);
+        return size_base::count(pHead);
+    }
+
+    template <typename T, typename... Policies>
+    bool policy_list <T, Policies...> ::empty() const
+    {
+        Guard guard(*this);
+        return pHead == nullptr;
+    }
+
+}; // namespace custom
@@ -0,0 +1,278 @@
+/***********************************************************************
+ * Header:
+ *    SHARDED LIST
+ * Summary:
+ *    A write-optimized list for many threads appending at once.  It is
+ *    really one custom::list per shard, and each thread always appends
+ *    to the same shard, so threads never fight over one tail pointer.
+ *    Shards are padded apart so they never share a cache line, and a
+ *    shard's lock is uncontended as long as there are no more threads
+ *    than shards.
+ *
+ *    collect() hands everything back as one list by splicing the shards
+ *    together, which costs O(#shards) no matter how many items there
+ *    are.  collect(comp) merges the shards by an ordering key instead,
+ *    and needs every shard to be in that order already.  Ties go to the
+ *    lower-numbered shard.
+ *
+ *    push_back() picks a shard by thread.  Threads are numbered in the
+ *    order they first push to any sharded_list of the same T in the
+ *    process, so which shard a thread gets, and so the order collect()
+ *    returns, can change from run to run.  push_back_to() takes the
+ *    shard from a key the caller chooses instead, such as a producer's
+ *    id, and then the result is the same on every run.
+ *
+ *    This will contain the class definition of:
+ *        sharded_list : A list of per-thread lists
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <cassert>     // for ASSERT
+#include <atomic>      // for std::atomic
+#include <mutex>       // for std::mutex
+#include <thread>      // for std::thread::hardware_concurrency
+#include <vector>      // for std::vector
+
+class TestShardedList; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * SHARDED LIST
+     * push_back() from any thread, collect() from any thread
+     **************************************************/
+    template <typename T>
+    class sharded_list
+    {
+        friend class ::TestShardedList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        sharded_list(size_t numShards = defaultShards());
+        sharded_list(const sharded_list& rhs) = delete;
+        sharded_list& operator = (const sharded_list& rhs) = delete;
+
+        //
+        // Insert
+        //
+
+        void push_back(const T& data);
+        void push_back(T&& data);
+        void push_back_to(size_t key, const T& data);
+        void push_back_to(size_t key, T&& data);
+
+        //
+        // Remove
+        //
+
+        list <T> collect();
+        template <class Compare>
+        list <T> collect(Compare comp);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return size() == 0; }
+        size_t size() const;
+        size_t shards() const { return vShards.size(); }
+        // the shard this thread's push_back() goes to, which depends on
+        // when the thread first pushed, not on anything stable
+        size_t shard()  const { return threadIndex() % vShards.size(); }
+
+    private:
+        // one thread's list.  The padding keeps the next shard's lock
+        // and list off our cache line, however the vector is aligned
+        struct Shard
+        {
+            mutable std::mutex lock;  // only contended when threads outnumber shards
+            list <T> data;
+            char padding[64];
+        };
+
+        // a small number that stays with a thread for life
+        static size_t threadIndex();
+        static size_t defaultShards();
+
+        // is every item no less than the one before it?
+        template <class Compare>
+        static bool isSorted(list <T>& l, Compare comp);
+
+        // member variables
+        std::vector<Shard> vShards;
+    };
+
+    /*****************************************
+     * SHARDED LIST :: DEFAULT constructors
+     * One shard per core unless told otherwise
+     ****************************************/
+    template <typename T>
+    sharded_list <T> ::sharded_list(size_t numShards) : vShards(numShards ? numShards : 1)
+    {
+    }
+
+    template <typename T>
+    size_t sharded_list <T> ::defaultShards()
+    {
+        size_t num = std::thread::hardware_concurrency();
+        return num ? num : 1;
+    }
+
+    /*****************************************
+     * SHARDED LIST :: THREAD INDEX
+     * Threads are numbered in the order they first push
+     ****************************************/
+    template <typename T>
+    size_t sharded_list <T> ::threadIndex()
+    {
+        static std::atomic<size_t> numThreads(0);
+        static thread_local size_t index = numThreads.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    /*********************************************
+     * SHARDED LIST :: PUSH BACK
+     * add an item to the end of this thread's shard
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void sharded_list <T> ::push_back(const T& data)
+    {
+        Shard& s = vShards[shard()];
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.data.push_back(data);
+    }
+
+    template <typename T>
+    void sharded_list <T> ::push_back(T&& data)
+    {
+        Shard& s = vShards[shard()];
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.data.push_back(std::move(data));
+    }
+
+    /*********************************************
+     * SHARDED LIST :: PUSH BACK TO
+     * add an item to the end of the shard a key picks.
+     * The same key always picks the same shard
+     *    INPUT  : the key, data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T>
+    void sharded_list <T> ::push_back_to(size_t key, const T& data)
+    {
+        Shard& s = vShards[key % vShards.size()];
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.data.push_back(data);
+    }
+
+    template <typename T>
+    void sharded_list <T> ::push_back_to(size_t key, T&& data)
+    {
+        Shard& s = vShards[key % vShards.size()];
+        std::lock_guard<std::mutex> lock(s.lock);
+        s.data.push_back(std::move(data));
+    }
+
+    /*********************************************
+     * SHARDED LIST :: COLLECT
+     * take everything, shard 0 first.  Within a shard the
+     * order is the order it was pushed
+     *    INPUT  :
+     *    OUTPUT : every item, the shards left empty
+     *    COST   : O(#shards)
+     *********************************************/
+    template <typename T>
+    list <T> sharded_list <T> ::collect()
+    {
+        list <T> lReturn;
+        for (auto& s : vShards)
+        {
+            std::lock_guard<std::mutex> lock(s.lock);
+            lReturn.splice(lReturn.end(), s.data);
+        }
+        return lReturn;
+    }
+
+    /*********************************************
+     * SHARDED LIST :: COLLECT
+     * take everything, merged by an ordering key.  Each
+     * shard must already be in order, as it is when
+     * everything pushed to one shard has keys that only go
+     * up; this is asserted, not fixed.  Two threads that
+     * share a shard interleave their pushes, so use
+     * push_back_to() when that matters.  Neighboring
+     * shards are merged pairwise, lower shard on the left,
+     * so equal keys always come out in shard order
+     *    INPUT  : the ordering
+     *    OUTPUT : every item in order, the shards left empty
+     *    COST   : O(n log #shards)
+     *********************************************/
+    template <typename T>
+    template <class Compare>
+    list <T> sharded_list <T> ::collect(Compare comp)
+    {
+        std::vector<list <T>> runs(vShards.size());
+        for (size_t i = 0; i < vShards.size(); i++)
+        {
+            std::lock_guard<std::mutex> lock(vShards[i].lock);
+            runs[i].swap(vShards[i].data);
+            assert(isSorted(runs[i], comp));
+        }
+
+        for (size_t width = 1; width < runs.size(); width *= 2)
+            for (size_t i = 0; i + width < runs.size(); i += 2 * width)
+                runs[i].merge(runs[i + width], comp);
+
+        return std::move(runs[0]);
+    }
+
+    /*********************************************
+     * SHARDED LIST :: IS SORTED
+     * check collect(comp)'s precondition on one shard
+     *    INPUT  : the shard's list, the ordering
+     *    OUTPUT : true if no item is less than the one before it
+     *    COST   : O(n)
+     *********************************************/
+    template <typename T>
+    template <class Compare>
+    bool sharded_list <T> ::isSorted(list <T>& l, Compare comp)
+    {
+        typename list <T> ::iterator it = l.begin();
+        if (it == l.end())
+            return true;
+        for (typename list <T> ::iterator prev = it++; it != l.end(); prev = it++)
+            if (comp(*it, *prev))
+                return false;
+        return true;
+    }
+
+    /*********************************************
+     * SHARDED LIST :: SIZE
+     * how many items are in all the shards right now
+     *    INPUT  :
+     *    OUTPUT : the total
+     *    COST   : O(#shards)
+     *********************************************/
+    template <typename T>
+    size_t sharded_list <T> ::size() const
+    {
+        size_t num = 0;
+        for (auto& s : vShards)
+        {
+            std::lock_guard<std::mutex> lock(s.lock);
+            num += s.data.size();
+        }
+        return num;
+    }
+
+}; // namespace custom
@@ -0,0 +1,365 @@
+/***********************************************************************
+ * Header:
+ *    SOA LIST
+ * Summary:
+ *    A doubly linked list of records whose fields are stored apart.
+ *    Each field has its own column, an array holding that field for
+ *    every record, and the links are two more columns of indices.  A
+ *    pass that reads one field only pulls that field's column through
+ *    the cache, rather than whole records.
+ *
+ *    The columns are kept dense: erasing a record moves the last one
+ *    into its slot and fixes up the links.  So column<I>() is always a
+ *    plain array of size() items that a compiler can vectorize a loop
+ *    over.  The order of a column is storage order, not list order;
+ *    walk the list with the iterators when order matters.
+ *
+ *    Because a record is not one object, dereferencing an iterator gives
+ *    a small proxy, reference, whose get<I>() reaches into column I.
+ *
+ *    This will contain the class definition of:
+ *        soa_list            : A list of records, one column per field
+ *        soa_list::reference : One record, spread over the columns
+ *        soa_list::iterator  : Walks the records in list order
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for assert
+#include <tuple>       // for std::tuple
+#include <utility>     // for std::index_sequence
+#include <vector>      // for std::vector
+
+class TestSoaList;     // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * SOA LIST
+     * Like list<std::tuple<Fields...>>, stored by column
+     **************************************************/
+    template <typename... Fields>
+    class soa_list
+    {
+        friend class ::TestSoaList; // give unit tests access to the privates
+    public:
+        typedef std::tuple<Fields...> value_type;
+        template <size_t I>
+        using field_type = typename std::tuple_element<I, value_type>::type;
+
+        class reference;
+        class iterator;
+
+        //
+        // Construct
+        //
+
+        soa_list() : head(npos), tail(npos) {}
+
+        //
+        // Access
+        //
+
+        iterator begin() { return iterator(this, head); }
+        iterator rbegin() { return iterator(this, tail); }
+        iterator end() { return iterator(this, npos); }
+        reference front() { assert(head != npos); return reference(this, head); }
+        reference back() { assert(tail != npos); return reference(this, tail); }
+
+        // one field of every record, in storage order
+        template <size_t I>
+        field_type<I>* column() { return std::get<I>(columns).data(); }
+        template <size_t I>
+        const field_type<I>* column() const { return std::get<I>(columns).data(); }
+
+        //
+        // Insert
+        //
+
+        void push_back(const Fields&... fields) { insert(end(), fields...); }
+        void push_front(const Fields&... fields) { insert(begin(), fields...); }
+        iterator insert(iterator it, const Fields&... fields);
+
+        //
+        // Remove
+        //
+
+        void pop_back() { if (tail != npos) erase(rbegin()); }
+        void pop_front() { if (head != npos) erase(begin()); }
+        iterator erase(iterator it);
+        void clear();
+
+        //
+        // Status
+        //
+
+        size_t size() const { return vNext.size(); }
+        bool empty() const { return vNext.empty(); }
+
+    private:
+        static const size_t npos = (size_t)-1;
+
+        template <size_t... I>
+        void append(std::index_sequence<I...>, const Fields&... fields);
+        template <size_t... I>
+        void moveSlot(std::index_sequence<I...>, size_t from, size_t to);
+        template <size_t... I>
+        void shrink(std::index_sequence<I...>, size_t num);
+        template <size_t... I>
+        value_type gather(std::index_sequence<I...>, size_t i) const;
+        template <size_t... I>
+        void scatter(std::index_sequence<I...>, size_t i, const value_type& t);
+
+        // member variables
+        std::tuple<std::vector<Fields>...> columns;  // one per field, all size()
+        std::vector<size_t> vNext;                   // slot of the next record, or npos
+        std::vector<size_t> vPrev;                   // slot of the previous record, or npos
+        size_t head;                                 // slot of the first record
+        size_t tail;                                 // slot of the last record
+    };
+
+    /*************************************************
+     * SOA LIST REFERENCE
+     * Stands in for a record.  Holds the slot, so
+     * erasing another record can move it
+     ************************************************/
+    template <typename... Fields>
+    class soa_list <Fields...> ::reference
+    {
+        friend class soa_list <Fields...>;
+        friend class ::TestSoaList;
+    public:
+        template <size_t I>
+        field_type<I>& get() const { return std::get<I>(pList->columns)[slot]; }
+
+        // the whole record, copied out or in
+        operator value_type() const
+        {
+            return pList->gather(std::index_sequence_for<Fields...>(), slot);
+        }
+        const reference& operator = (const value_type& t) const
+        {
+            pList->scatter(std::index_sequence_for<Fields...>(), slot, t);
+            return *this;
+        }
+
+    private:
+        reference(soa_list* pList, size_t slot) : pList(pList), slot(slot) {}
+
+        soa_list* pList;
+        size_t slot;
+    };
+
+    /*************************************************
+     * SOA LIST ITERATOR
+     * Follows the index links in list order
+     ************************************************/
+    template <typename... Fields>
+    class soa_list <Fields...> ::iterator
+    {
+        friend class soa_list <Fields...>;
+        friend class ::TestSoaList;
+    public:
+        iterator() : pList(nullptr), slot(npos) {}
+
+        bool operator == (const iterator& rhs) const { return slot == rhs.slot; }
+        bool operator != (const iterator& rhs) const { return slot != rhs.slot; }
+
+        reference operator * () const
+        {
+            assert(slot != npos);
+            return reference(pList, slot);
+        }
+
+        iterator& operator ++ ()
+        {
+            slot = pList->vNext[slot];
+            return *this;
+        }
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        // from end() back onto the last record
+        iterator& operator -- ()
+        {
+            slot = (slot == npos) ? pList->tail : pList->vPrev[slot];
+            return *this;
+        }
+        iterator operator -- (int postfix)
+        {
+            iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+    private:
+        iterator(soa_list* pList, size_t slot) : pList(pList), slot(slot) {}
+
+        soa_list* pList;
+        size_t slot;
+    };
+
+    /*********************************************
+     * SOA LIST :: COLUMN HELPERS
+     * Do the same thing to every column
+     *********************************************/
+    template <typename... Fields>
+    template <size_t... I>
+    void soa_list <Fields...> ::append(std::index_sequence<I...>, const Fields&... fields)
+    {
+        int dummy[] = { 0, (std::get<I>(columns).push_back(fields), 0)... };
+        (void)dummy;
+    }
+
+    template <typename... Fields>
+    template <size_t... I>
+    void soa_list <Fields...> ::moveSlot(std::index_sequence<I...>, size_t from, size_t to)
+    {
+        int dummy[] = { 0, (std::get<I>(columns)[to] = std::move(std::get<I>(columns)[from]), 0)... };
+        (void)dummy;
+    }
+
+    template <typename... Fields>
+    template <size_t... I>
+    void soa_list <Fields...> ::shrink(std::index_sequence<I...>, size_t num)
+    {
+        int dummy[] = { 0, (std::get<I>(columns).erase(std::get<I>(columns).begin() + num,
+                                                       std::get<I>(columns).end()), 0)... };
+        (void)dummy;
+    }
+
+    template <typename... Fields>
+    template <size_t... I>
+    typename soa_list <Fields...> ::value_type
+    soa_list <Fields...> ::gather(std::index_sequence<I...>, size_t i) const
+    {
+        return value_type(std::get<I>(columns)[i]...);
+    }
+
+    template <typename... Fields>
+    template <size_t... I>
+    void soa_list <Fields...> ::scatter(std::index_sequence<I...>, size_t i, const value_type& t)
+    {
+        int dummy[] = { 0, (std::get<I>(columns)[i] = std::get<I>(t), 0)... };
+        (void)dummy;
+    }
+
+    /*********************************************
+     * SOA LIST :: INSERT
+     * Add a record before it.  The record goes in a new
+     * slot at the end of every column; only the links
+     * put it in its place.  If copying a field throws,
+     * the list is left as it was
+     *    INPUT  : where, and the fields of the record
+     *    OUTPUT : an iterator to the new record
+     *    COST   : O(1) amortized
+     *********************************************/
+    template <typename... Fields>
+    typename soa_list <Fields...> ::iterator
+    soa_list <Fields...> ::insert(iterator it, const Fields&... fields)
+    {
+        size_t slot = size();
+        vNext.reserve(slot + 1);
+        vPrev.reserve(slot + 1);
+        try
+        {
+            append(std::index_sequence_for<Fields...>(), fields...);
+        }
+        catch (...)
+        {
+            shrink(std::index_sequence_for<Fields...>(), slot);
+            throw;
+        }
+
+        size_t next = it.slot;
+        size_t prev = (next == npos) ? tail : vPrev[next];
+        vNext.push_back(next);
+        vPrev.push_back(prev);
+        if (prev == npos)
+            head = slot;
+        else
+            vNext[prev] = slot;
+        if (next == npos)
+            tail = slot;
+        else
+            vPrev[next] = slot;
+        return iterator(this, slot);
+    }
+
+    /*********************************************
+     * SOA LIST :: ERASE
+     * Unlink a record, then move the last slot into
+     * the hole to keep the columns dense.  Iterators and
+     * references to the erased record and to the record
+     * in the last slot are invalidated
+     *    INPUT  : the record to go
+     *    OUTPUT : an iterator to the record after it
+     *    COST   : O(1)
+     *********************************************/
+    template <typename... Fields>
+    typename soa_list <Fields...> ::iterator
+    soa_list <Fields...> ::erase(iterator it)
+    {
+        size_t slot = it.slot;
+        assert(slot != npos && slot < size());
+
+        // unlink
+        size_t next = vNext[slot];
+        size_t prev = vPrev[slot];
+        if (prev == npos)
+            head = next;
+        else
+            vNext[prev] = next;
+        if (next == npos)
+            tail = prev;
+        else
+            vPrev[next] = prev;
+
+        // fill the hole with the last slot
+        size_t last = size() - 1;
+        if (slot != last)
+        {
+            moveSlot(std::index_sequence_for<Fields...>(), last, slot);
+            vNext[slot] = vNext[last];
+            vPrev[slot] = vPrev[last];
+            if (vPrev[slot] == npos)
+                head = slot;
+            else
+                vNext[vPrev[slot]] = slot;
+            if (vNext[slot] == npos)
+                tail = slot;
+            else
+                vPrev[vNext[slot]] = slot;
+            if (next == last)
+                next = slot;
+        }
+
+        shrink(std::index_sequence_for<Fields...>(), last);
+        vNext.pop_back();
+        vPrev.pop_back();
+        return iterator(this, next);
+    }
+
+    /*********************************************
+     * SOA LIST :: CLEAR
+     * Remove every record
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(n)
+     *********************************************/
+    template <typename... Fields>
+    void soa_list <Fields...> ::clear()
+    {
+        shrink(std::index_sequence_for<Fields...>(), 0);
+        vNext.clear();
+        vPrev.clear();
+        head = tail = npos;
+    }
+
+}; // namespace custom
@@ -0,0 +1,634 @@
+/***********************************************************************
+ * Header:
+ *    STATIC LIST
+ * Summary:
+ *    A fixed-capacity version of custom::list.  All N nodes live inline
+ *    in the list object itself and are linked together by index, so no
+ *    operation ever calls operator new.  Going past N throws.
+ *
+ *    This will contain the class definition of:
+ *        static_list  : A class that represents a fixed-capacity List
+ *        iterator     : An iterator through static_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include <cassert>     // for ASSERT
+#include <array>       // for std::array
+#include <new>         // for placement new
+#include <initializer_list>
+#include <utility>
+
+class TestStaticList;  // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * STATIC LIST
+     * Just like custom::list, but with room for at most
+     * N elements and no heap allocation
+     **************************************************/
+    template <typename T, size_t N>
+    class static_list
+    {
+        friend class ::TestStaticList; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+
+        static_list();
+        static_list(static_list& rhs);
+        static_list(static_list&& rhs);
+        static_list(size_t num, const T& t);
+        static_list(size_t num);
+        static_list(const std::initializer_list<T>& il);
+        template <class Iterator>
+        static_list(Iterator first, Iterator last);
+        ~static_list()
+        {
+            clear();
+        }
+
+        //
+        // Assign
+        //
+
+        static_list& operator = (static_list& rhs);
+        static_list& operator = (static_list&& rhs);
+        static_list& operator = (const std::initializer_list<T>& il);
+        void swap(static_list& rhs);
+
+        //
+        // Iterator
+        //
+
+        class  iterator;
+        iterator begin() { return iterator(this, iHead); }
+        iterator rbegin() { return iterator(this, iTail); }
+        iterator end() { return iterator(this, npos); }
+
+        //
+        // Access
+        //
+
+        T& front();
+        T& back();
+
+        //
+        // Insert
+        //
+
+        void push_front(const T& data);
+        void push_front(T&& data);
+        void push_back(const T& data);
+        void push_back(T&& data);
+        iterator insert(iterator it, const T& data);
+        iterator insert(iterator it, T&& data);
+
+        //
+        // Remove
+        //
+
+        void pop_back();
+        void pop_front();
+        void clear();
+        iterator erase(const iterator& it);
+
+        //
+        // Status
+        //
+
+        bool empty()  const { return numElements == 0; }
+        bool full()   const { return numElements == N; }
+        size_t size() const { return numElements; }
+        static size_t capacity() { return N; }
+
+    private:
+        // nested linked list class
+        class Node;
+
+        // the "null pointer" of an index-linked list
+        static const size_t npos = N;
+
+        // take a slot off the free chain, or throw when there is none
+        size_t allocate();
+        // put a slot back on the free chain
+        void release(size_t i);
+        // hook the (already constructed) slot i in front of iNext
+        iterator link(size_t i, size_t iNext);
+
+        // member variables
+        size_t numElements;          // number of slots in use
+        size_t iHead;                // index of the first node
+        size_t iTail;                // index of the last node
+        size_t iFree;                // head of the chain of released slots
+        size_t iUnused;              // slots at or past this were never used
+        std::array<Node, N> nodes;   // the storage for every node
+    };
+
+    /*************************************************
+     * NODE
+     * the node class.  The data lives in a union so a
+     * slot on the free chain holds no constructed T
+     *************************************************/
+    template <typename T, size_t N>
+    class static_list <T, N> ::Node
+    {
+    public:
+        Node() {}
+        ~Node() {}
+
+        union
+        {
+            T data;         // user data, only alive while the slot is linked
+        };
+        size_t iNext;       // index of next node, or the next free slot
+        size_t iPrev;       // index of previous node
+    };
+
+    /*************************************************
+     * STATIC LIST ITERATOR
+     * Iterate through a static list.  Since links are
+     * indices, the iterator needs to know its list
+     ************************************************/
+    template <typename T, size_t N>
+    class static_list <T, N> ::iterator
+    {
+        friend class ::TestStaticList; // give unit tests access to the privates
+        friend class static_list <T, N>;
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : pList(nullptr), i(npos) {}
+        iterator(static_list* pList, size_t i) : pList(pList), i(i) {}
+        iterator(const iterator& rhs) : pList(rhs.pList), i(rhs.i) {}
+        iterator& operator = (const iterator& rhs)
+        {
+            pList = rhs.pList;
+            i = rhs.i;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator == (const iterator& rhs) const { return i == rhs.i; }
+        bool operator != (const iterator& rhs) const { return i != rhs.i; }
+
+        // dereference operator, fetch a node
+        T& operator * ()
+        {
+            assert(pList != nullptr && i != npos);
+            return pList->nodes[i].data;
+        }
+
+        // postfix increment
+        iterator operator ++ (int postfix)
+        {
+            iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            i = pList->nodes[i].iNext;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int postfix)
+        {
+            iterator temp(*this);
+            --(*this);
+            return temp;
+        }
+
+        // prefix decrement.  Unlike a pointer, end() knows where the tail is
+        iterator& operator -- ()
+        {
+            i = (i == npos) ? pList->iTail : pList->nodes[i].iPrev;
+            return *this;
+        }
+
+    private:
+
+        static_list* pList;
+        size_t i;
+    };
+
+    /*****************************************
+     * STATIC LIST :: DEFAULT constructors
+     ****************************************/
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list()
+    {
+        numElements = 0;
+        iHead = iTail = iFree = npos;
+        iUnused = 0;
+    }
+
+    /*****************************************
+     * STATIC LIST :: NON-DEFAULT constructors
+     * Create a list initialized to a value
+     ****************************************/
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list(size_t num, const T& t) : static_list()
+    {
+        for (size_t i = 0; i < num; ++i)
+            push_back(t);
+    }
+
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list(size_t num) : static_list()
+    {
+        for (size_t i = 0; i < num; ++i)
+            push_back(T());
+    }
+
+    /*****************************************
+     * STATIC LIST :: ITERATOR constructors
+     * Create a list initialized to a set of values
+     ****************************************/
+    template <typename T, size_t N>
+    template <class Iterator>
+    static_list <T, N> ::static_list(Iterator first, Iterator last) : static_list()
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    /*****************************************
+     * STATIC LIST :: INITIALIZER constructors
+     * Create a list initialized to a set of values
+     ****************************************/
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list(const std::initializer_list<T>& il) : static_list()
+    {
+        for (const auto& x : il)
+            push_back(x);
+    }
+
+    /*****************************************
+     * STATIC LIST :: COPY constructors
+     ****************************************/
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list(static_list& rhs) : static_list()
+    {
+        for (size_t i = rhs.iHead; i != npos; i = rhs.nodes[i].iNext)
+            push_back(rhs.nodes[i].data);
+    }
+
+    /*****************************************
+     * STATIC LIST :: MOVE constructors
+     * The nodes live inside the object so they cannot be
+     * stolen; the elements are moved one at a time instead
+     ****************************************/
+    template <typename T, size_t N>
+    static_list <T, N> ::static_list(static_list&& rhs) : static_list()
+    {
+        for (size_t i = rhs.iHead; i != npos; i = rhs.nodes[i].iNext)
+            push_back(std::move(rhs.nodes[i].data));
+        rhs.clear();
+    }
+
+    /**********************************************
+     * STATIC LIST :: assignment operator
+     * Copy one list onto another
+     *     INPUT  : a list to be copied
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, size_t N>
+    static_list <T, N>& static_list <T, N> :: operator = (static_list& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        for (size_t i = rhs.iHead; i != npos; i = rhs.nodes[i].iNext)
+            push_back(rhs.nodes[i].data);
+        return *this;
+    }
+
+    /**********************************************
+     * STATIC LIST :: assignment operator - MOVE
+     * Move one list onto another
+     *     INPUT  : a list to be moved
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, size_t N>
+    static_list <T, N>& static_list <T, N> :: operator = (static_list&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        for (size_t i = rhs.iHead; i != npos; i = rhs.nodes[i].iNext)
+            push_back(std::move(rhs.nodes[i].data));
+        rhs.clear();
+        return *this;
+    }
+
+    /**********************************************
+     * STATIC LIST :: assignment operator
+     * Copy an initializer list onto the list
+     *     INPUT  : the values to be copied
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, size_t N>
+    static_list <T, N>& static_list <T, N> :: operator = (const std::initializer_list<T>& il)
+    {
+        if (il.size() > N)
+            throw "ERROR: static_list capacity exceeded";
+
+        clear();
+        for (const auto& x : il)
+            push_back(x);
+        return *this;
+    }
+
+    /**********************************************
+     * STATIC LIST :: SWAP
+     * Exchange the contents of two lists
+     *     INPUT  : the list to swap with
+     *     OUTPUT :
+     *     COST   : O(n) since the nodes live inside each list
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::swap(static_list& rhs)
+    {
+        static_list tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    template <typename T, size_t N>
+    void swap(static_list <T, N>& lhs, static_list <T, N>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /**********************************************
+     * STATIC LIST :: ALLOCATE
+     * Find a slot for a new node: a released one if there
+     * is one, otherwise the next one never used
+     *     INPUT  :
+     *     OUTPUT : index of an unconstructed slot
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    size_t static_list <T, N> ::allocate()
+    {
+        if (iFree != npos)
+        {
+            size_t i = iFree;
+            iFree = nodes[i].iNext;
+            return i;
+        }
+        if (iUnused < N)
+            return iUnused++;
+        throw "ERROR: static_list capacity exceeded";
+    }
+
+    /**********************************************
+     * STATIC LIST :: RELEASE
+     * Destroy the data in a slot and put it on the free chain
+     *     INPUT  : index of an unlinked slot
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::release(size_t i)
+    {
+        nodes[i].data.~T();
+        nodes[i].iNext = iFree;
+        iFree = i;
+        --numElements;
+    }
+
+    /**********************************************
+     * STATIC LIST :: LINK
+     * Hook slot i in directly before iNext (npos means
+     * at the end)
+     *     INPUT  : the slot to link, the slot to link before
+     *     OUTPUT : iterator to the new node
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    typename static_list <T, N> ::iterator static_list <T, N> ::link(size_t i, size_t iNext)
+    {
+        size_t iPrev = (iNext == npos) ? iTail : nodes[iNext].iPrev;
+
+        nodes[i].iNext = iNext;
+        nodes[i].iPrev = iPrev;
+
+        if (iPrev == npos)
+            iHead = i;
+        else
+            nodes[iPrev].iNext = i;
+
+        if (iNext == npos)
+            iTail = i;
+        else
+            nodes[iNext].iPrev = i;
+
+        ++numElements;
+        return iterator(this, i);
+    }
+
+    /**********************************************
+     * STATIC LIST :: CLEAR
+     * Remove all the items currently in the linked list
+     *     INPUT  :
+     *     OUTPUT :
+     *     COST   : O(n) with respect to the number of nodes
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::clear()
+    {
+        for (size_t i = iHead; i != npos; i = nodes[i].iNext)
+            nodes[i].data.~T();
+
+        numElements = 0;
+        iHead = iTail = iFree = npos;
+        iUnused = 0;
+    }
+
+    /*********************************************
+     * STATIC LIST :: PUSH BACK
+     * add an item to the end of the list
+     *    INPUT  : data to be added to the list
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::push_back(const T& data)
+    {
+        insert(end(), data);
+    }
+
+    template <typename T, size_t N>
+    void static_list <T, N> ::push_back(T&& data)
+    {
+        insert(end(), std::move(data));
+    }
+
+    /*********************************************
+     * STATIC LIST :: PUSH FRONT
+     * add an item to the head of the list
+     *     INPUT  : data to be added to the list
+     *     OUTPUT :
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::push_front(const T& data)
+    {
+        insert(begin(), data);
+    }
+
+    template <typename T, size_t N>
+    void static_list <T, N> ::push_front(T&& data)
+    {
+        insert(begin(), std::move(data));
+    }
+
+    /******************************************
+     * STATIC LIST :: INSERT
+     * add an item to the middle of the list
+     *     INPUT  : data to be added to the list
+     *              an iterator to the location where it is to be inserted
+     *     OUTPUT : iterator to the new item
+     *     COST   : O(1)
+     * If the item throws while being copied, the slot is
+     * given back and the list is left as it was
+     ******************************************/
+    template <typename T, size_t N>
+    typename static_list <T, N> ::iterator static_list <T, N> ::insert(iterator it,
+        const T& data)
+    {
+        size_t i = allocate();
+        try
+        {
+            new (&nodes[i].data) T(data);
+        }
+        catch (...)
+        {
+            // nothing was built there, so it goes back without ~T()
+            nodes[i].iNext = iFree;
+            iFree = i;
+            throw;
+        }
+        return link(i, it.i);
+    }
+
+    template <typename T, size_t N>
+    typename static_list <T, N> ::iterator static_list <T, N> ::insert(iterator it,
+        T&& data)
+    {
+        size_t i = allocate();
+        try
+        {
+            new (&nodes[i].data) T(std::move(data));
+        }
+        catch (...)
+        {
+            // nothing was built there, so it goes back without ~T()
+            nodes[i].iNext = iFree;
+            iFree = i;
+            throw;
+        }
+        return link(i, it.i);
+    }
+
+    /*********************************************
+     * STATIC LIST :: POP BACK
+     * remove an item from the end of the list
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::pop_back()
+    {
+        erase(rbegin());
+    }
+
+    /*********************************************
+     * STATIC LIST :: POP FRONT
+     * remove an item from the front of the list
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    void static_list <T, N> ::pop_front()
+    {
+        erase(begin());
+    }
+
+    /******************************************
+     * STATIC LIST :: REMOVE
+     * remove an item from the middle of the list
+     *     INPUT  : an iterator to the item being removed
+     *     OUTPUT : iterator to the new location
+     *     COST   : O(1)
+     ******************************************/
+    template <typename T, size_t N>
+    typename static_list <T, N> ::iterator static_list <T, N> ::erase(const iterator& it)
+    {
+        if (iHead == npos || it.i == npos)  // end() or empty
+            return end();
+
+        size_t i = it.i;
+        size_t iNext = nodes[i].iNext;
+        size_t iPrev = nodes[i].iPrev;
+
+        if (iPrev != npos)
+            nodes[iPrev].iNext = iNext;
+        else
+            iHead = iNext;
+
+        if (iNext != npos)
+            nodes[iNext].iPrev = iPrev;
+        else
+            iTail = iPrev;
+
+        release(i);
+        return iterator(this, iNext);
+    }
+
+    /*********************************************
+     * STATIC LIST :: FRONT
+     * retrieves the first element in the list
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    T& static_list <T, N> ::front()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return nodes[iHead].data;
+    }
+
+    /*********************************************
+     * STATIC LIST :: BACK
+     * retrieves the last element in the list
+     *     INPUT  :
+     *     OUTPUT : data to be displayed
+     *     COST   : O(1)
+     *********************************************/
+    template <typename T, size_t N>
+    T& static_list <T, N> ::back()
+    {
+        if (empty())
+            throw "ERROR: unable to access data from an empty list";
+        return nodes[iTail].data;
+    }
+
+}; // namespace custom
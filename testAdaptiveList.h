@@ -0,0 +1,280 @@
+/***********************************************************************
+ * Header:
+ *    TEST ADAPTIVE LIST
+ * Summary:
+ *    Unit tests for adaptive_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "adaptiveList.h"
+#include "unitTest.h"
+
+#include <string>
+#include <vector>
+
+class TestAdaptiveList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializer();
+      test_construct_copyLinked();
+
+      // Insert
+      test_pushBack_staysContiguous();
+      test_pushFront_converts();
+      test_insert_endStaysContiguous();
+      test_insert_middleConverts();
+
+      // Remove
+      test_erase_lastStaysContiguous();
+      test_erase_middleConverts();
+      test_popFront_converts();
+      test_clear_contiguousAgain();
+
+      // Layout
+      test_compact_backToContiguous();
+      test_forEach_both();
+
+      // Access
+      test_front_emptyThrows();
+
+      report("AdaptiveList");
+   }
+
+   // the items, front to back
+   static std::vector<int> items(custom::adaptive_list<int>& l)
+   {
+      std::vector<int> v;
+      for (custom::adaptive_list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing there, and contiguous
+   void test_construct_default()
+   {  // exercise
+      custom::adaptive_list<int> l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.is_contiguous());
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // the items go straight into the buffer
+   void test_construct_initializer()
+   {  // exercise
+      custom::adaptive_list<int> l{ 11, 26, 31 };
+      // verify
+      assertUnit(l.is_contiguous());
+      assertUnit(l.size() == 3);
+      assertUnit(l.data() != nullptr && l.data()[1] == 26);
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // a copy of a linked list is contiguous
+   void test_construct_copyLinked()
+   {  // setup
+      custom::adaptive_list<int> l{ 26, 31 };
+      l.push_front(11);
+      // exercise
+      custom::adaptive_list<int> copy(l);
+      // verify
+      assertUnit(!l.is_contiguous());
+      assertUnit(copy.is_contiguous());
+      assertUnit(items(copy) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // appending never leaves the buffer
+   void test_pushBack_staysContiguous()
+   {  // setup
+      custom::adaptive_list<std::string> l;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         l.push_back(std::to_string(i));
+      // verify
+      assertUnit(l.is_contiguous());
+      assertUnit(l.size() == 100);
+      assertUnit(&l.front() == l.data());
+      assertUnit(l.back() == "99");
+      assertUnit(l.nodes.empty());
+   }  // teardown
+
+   // adding at the front makes it linked, in the same order
+   void test_pushFront_converts()
+   {  // setup
+      custom::adaptive_list<int> l{ 26, 31 };
+      // exercise
+      l.push_front(11);
+      // verify
+      assertUnit(!l.is_contiguous());
+      assertUnit(l.data() == nullptr);
+      assertUnit(l.buffer.capacity() == 0);
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.size() == 3);
+   }  // teardown
+
+   // the first push_front into an empty list has nothing to move
+   void test_insert_endStaysContiguous()
+   {  // setup
+      custom::adaptive_list<int> l;
+      l.push_front(11);
+      // exercise
+      custom::adaptive_list<int>::iterator it = l.insert(l.end(), 26);
+      // verify
+      assertUnit(l.is_contiguous());
+      assertUnit(*it == 26);
+      assertUnit(items(l) == std::vector<int>({ 11, 26 }));
+   }  // teardown
+
+   // the iterator returned is to the new item, in its place
+   void test_insert_middleConverts()
+   {  // setup
+      custom::adaptive_list<int> l{ 11, 31 };
+      custom::adaptive_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.insert(it, 26);
+      // verify
+      assertUnit(!l.is_contiguous());
+      assertUnit(*it == 26);
+      assertUnit(*++it == 31);
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // the last item comes off the buffer
+   void test_erase_lastStaysContiguous()
+   {  // setup
+      custom::adaptive_list<int> l{ 11, 26, 31 };
+      // exercise
+      custom::adaptive_list<int>::iterator it = l.erase(l.rbegin());
+      bool atEnd = it == l.end();
+      l.pop_back();
+      // verify
+      assertUnit(atEnd);
+      assertUnit(l.is_contiguous());
+      assertUnit(items(l) == std::vector<int>({ 11 }));
+   }  // teardown
+
+   // the iterator returned is to the item after
+   void test_erase_middleConverts()
+   {  // setup
+      custom::adaptive_list<int> l{ 11, 99, 26, 31 };
+      custom::adaptive_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(!l.is_contiguous());
+      assertUnit(*it == 26);
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // taking from the front makes it linked, unless it was the last one
+   void test_popFront_converts()
+   {  // setup
+      custom::adaptive_list<int> one{ 11 };
+      custom::adaptive_list<int> l{ 11, 26, 31 };
+      // exercise
+      one.pop_front();
+      l.pop_front();
+      // verify
+      assertUnit(one.empty() && one.is_contiguous());
+      assertUnit(!l.is_contiguous());
+      assertUnit(items(l) == std::vector<int>({ 26, 31 }));
+   }  // teardown
+
+   // clearing starts over as a buffer
+   void test_clear_contiguousAgain()
+   {  // setup
+      custom::adaptive_list<int> l{ 26, 31 };
+      l.push_front(11);
+      // exercise
+      l.clear();
+      l.push_back(42);
+      // verify
+      assertUnit(l.is_contiguous());
+      assertUnit(l.nodes.empty());
+      assertUnit(items(l) == std::vector<int>({ 42 }));
+   }  // teardown
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // compact() moves the items back into one buffer, in order
+   void test_compact_backToContiguous()
+   {  // setup
+      custom::adaptive_list<std::string> l{ "b", "c" };
+      l.push_front("a");
+      // exercise
+      l.compact();
+      l.push_back("d");
+      // verify
+      assertUnit(l.is_contiguous());
+      assertUnit(l.nodes.empty());
+      assertUnit(l.size() == 4);
+      assertUnit(l.data()[0] == "a");
+      assertUnit(l.data()[3] == "d");
+   }  // teardown
+
+   // for_each sees the same items either way
+   void test_forEach_both()
+   {  // setup
+      custom::adaptive_list<int> l{ 2, 3, 4 };
+      int contiguous = 0;
+      int linked = 0;
+      // exercise
+      l.for_each([&contiguous](int& x) { contiguous = contiguous * 10 + x; });
+      l.push_front(1);
+      l.for_each([&linked](int& x) { linked = linked * 10 + x; });
+      // verify
+      assertUnit(contiguous == 234);
+      assertUnit(linked == 1234);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // same as list: an empty list throws
+   void test_front_emptyThrows()
+   {  // setup
+      custom::adaptive_list<int> l;
+      const char* error = nullptr;
+      // exercise
+      try
+      {
+         l.back();
+      }
+      catch (const char* e)
+      {
+         error = e;
+      }
+      // verify
+      assertUnit(error != nullptr);
+   }  // teardown
+};
+
+#endif // DEBUG
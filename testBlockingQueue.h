@@ -0,0 +1,369 @@
+/***********************************************************************
+ * Header:
+ *    TEST BLOCKING QUEUE
+ * Summary:
+ *    Unit tests for blocking_queue
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "blockingQueue.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define assertStandardList(x) assertStandardListParameters(x, __LINE__, __FUNCTION__)
+
+class TestBlockingQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_zeroCapacity();
+
+      // Single thread
+      test_push_fifo();
+      test_tryPop_empty();
+      test_tryPop_timeout();
+      test_tryPush_full();
+      test_tryPush_giveBack();
+      test_popN_some();
+      test_popN_all();
+      test_popN_appends();
+
+      // Many threads
+      test_push_backpressure();
+      test_pop_waitsForPush();
+      test_mpmc_sum();
+      test_popN_wakesProducerFilling();
+
+      report("BlockingQueue");
+   }
+
+   typedef custom::blocking_queue<int> Queue;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new queue is just its dummy node
+   void test_construct_default()
+   {  // exercise
+      Queue q;
+      // verify
+      assertUnit(q.pHead != nullptr);
+      assertUnit(q.pHead == q.pTail);
+      assertUnit(q.empty());
+      assertUnit(q.capacity() == std::numeric_limits<size_t>::max());
+   }  // teardown
+
+   // a queue has room for at least one item
+   void test_construct_zeroCapacity()
+   {  // exercise
+      Queue q(0);
+      // verify
+      assertUnit(q.capacity() == 1);
+   }  // teardown
+
+   /***************************************
+    * SINGLE THREAD
+    ***************************************/
+
+   // items come out in the order they went in
+   void test_push_fifo()
+   {  // setup
+      Queue q;
+      // exercise
+      q.push_back(11);
+      q.push_back(26);
+      q.push_back(31);
+      // verify
+      assertUnit(q.size() == 3);
+      assertUnit(q.pop_front() == 11);
+      assertUnit(q.pop_front() == 26);
+      assertUnit(q.pop_front() == 31);
+      assertUnit(q.empty());
+      assertUnit(q.pHead == q.pTail);
+   }  // teardown
+
+   // nothing to pop
+   void test_tryPop_empty()
+   {  // setup
+      Queue q;
+      int value = 99;
+      // exercise
+      bool popped = q.try_pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // nothing to pop, even after waiting
+   void test_tryPop_timeout()
+   {  // setup
+      Queue q;
+      int value = 99;
+      // exercise
+      bool popped = q.try_pop(value, std::chrono::milliseconds(5));
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // no room for another
+   void test_tryPush_full()
+   {  // setup
+      Queue q(2);
+      q.push_back(11);
+      q.push_back(26);
+      // exercise
+      bool pushed = q.try_push(31);
+      bool pushedLater = q.try_push(31, std::chrono::milliseconds(5));
+      // verify
+      assertUnit(pushed == false);
+      assertUnit(pushedLater == false);
+      assertUnit(q.size() == 2);
+   }  // teardown
+
+   // an item moved into a push that times out is handed back
+   void test_tryPush_giveBack()
+   {  // setup
+      custom::blocking_queue<std::string> q(1);
+      q.push_back(std::string("full"));
+      std::string s("keep me");
+      // exercise
+      bool pushed = q.try_push(std::move(s), std::chrono::milliseconds(1));
+      // verify
+      assertUnit(pushed == false);
+      assertUnit(s == "keep me");
+   }  // teardown
+
+   // take fewer than are queued
+   void test_popN_some()
+   {  // setup
+      Queue q;
+      q.push_back(11);
+      q.push_back(26);
+      q.push_back(31);
+      q.push_back(99);
+      custom::list<int> l;
+      // exercise
+      size_t num = q.pop_n(l, 3);
+      // verify
+      assertUnit(num == 3);
+      assertStandardList(l);
+      assertUnit(q.size() == 1);
+      assertUnit(q.pop_front() == 99);
+   }  // teardown
+
+   // ask for more than are queued
+   void test_popN_all()
+   {  // setup
+      Queue q;
+      q.push_back(11);
+      q.push_back(26);
+      q.push_back(31);
+      custom::list<int> l;
+      // exercise
+      size_t num = q.pop_n(l, 10);
+      // verify
+      assertUnit(num == 3);
+      assertStandardList(l);
+      assertUnit(q.empty());
+      assertUnit(q.pHead == q.pTail);
+      q.push_back(1);
+      assertUnit(q.pop_front() == 1);
+   }  // teardown
+
+   // pop_n appends to what is already in the list
+   void test_popN_appends()
+   {  // setup
+      Queue q;
+      q.push_back(26);
+      q.push_back(31);
+      custom::list<int> l{ 11 };
+      // exercise
+      q.pop_n(l, 1);
+      q.pop_n(l, 1);
+      // verify
+      assertStandardList(l);
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // a producer waits for room
+   void test_push_backpressure()
+   {  // setup
+      Queue q(1);
+      q.push_back(11);
+      std::atomic<bool> done(false);
+      // exercise
+      std::thread producer([&q, &done]()
+      {
+         q.push_back(26);
+         done = true;
+      });
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      bool doneEarly = done;
+      int first = q.pop_front();
+      int second = q.pop_front();
+      producer.join();
+      // verify
+      assertUnit(doneEarly == false);
+      assertUnit(first == 11);
+      assertUnit(second == 26);
+   }  // teardown
+
+   // a consumer waits for an item
+   void test_pop_waitsForPush()
+   {  // setup
+      Queue q;
+      int value = 0;
+      // exercise
+      std::thread consumer([&q, &value]()
+      {
+         value = q.pop_front();
+      });
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      q.push_back(99);
+      consumer.join();
+      // verify
+      assertUnit(value == 99);
+   }  // teardown
+
+   // many producers and consumers through a small queue lose nothing
+   void test_mpmc_sum()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 5000;
+      Queue q(16);
+      std::atomic<long long> sum(0);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+      {
+         threads.push_back(std::thread([&q, numEach]()
+         {
+            for (int i = 1; i <= numEach; i++)
+               q.push_back(i);
+         }));
+         threads.push_back(std::thread([&q, &sum, numEach, t]()
+         {
+            if (t % 2)
+            {
+               for (int i = 0; i < numEach; i++)
+                  sum += q.pop_front();
+               return;
+            }
+            int taken = 0;
+            while (taken < numEach)
+            {
+               custom::list<int> l;
+               taken += (int)q.pop_n(l, numEach - taken);
+               for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+                  sum += *it;
+            }
+         }));
+      }
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(sum == (long long)numThreads * numEach * (numEach + 1) / 2);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // an item whose move-assignment can be made slow on purpose
+   struct Slow
+   {
+      Slow(int value = 0) : value(value) {}
+      Slow(const Slow& rhs) = default;
+      Slow(Slow&& rhs) : value(rhs.value) {}
+      Slow& operator = (const Slow& rhs) = default;
+      Slow& operator = (Slow&& rhs)
+      {
+         if (delay())
+            std::this_thread::sleep_for(std::chrono::milliseconds(40));
+         value = rhs.value;
+         return *this;
+      }
+      static std::atomic<bool>& delay()
+      {
+         static std::atomic<bool> on(false);
+         return on;
+      }
+      int value;
+   };
+
+   // producers that fill the queue while pop_n is working are still woken
+   void test_popN_wakesProducerFilling()
+   {  // setup
+      custom::blocking_queue<Slow> q(4);
+      Slow item(11);
+      q.push_back(item);
+      q.push_back(item);
+      std::atomic<bool> done(false);
+      Slow::delay() = true;
+      // exercise
+      std::thread producer([&q, &done, item]()
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         q.push_back(item);
+         q.push_back(item);
+         q.push_back(item);   // the queue is full: this one waits for pop_n
+         done = true;
+      });
+      custom::list<Slow> l;
+      size_t num = q.pop_n(l, 2);
+      Slow::delay() = false;
+      for (int i = 0; i < 100 && !done; i++)
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      bool woken = done;
+      while (!done)           // never leave the producer stuck
+      {
+         std::lock_guard<std::mutex> lock(q.tailLock);
+         q.notFull.notify_all();
+      }
+      producer.join();
+      // verify
+      assertUnit(num == 2);
+      assertUnit(woken);
+      assertUnit(q.size() == 3);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard List
+    *        pHead             pTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardListParameters(custom::list<int>& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      custom::list<int>::iterator it = l.begin();
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3 && it != l.end(); i++, ++it)
+         assertIndirect(*it == expected[i]);
+      // walk it backwards too, to check the pPrev links
+      it = l.rbegin();
+      for (int i = 2; i >= 0 && it != l.end(); i--, --it)
+         assertIndirect(*it == expected[i]);
+      assertIndirect(l.back() == 31);
+   }
+};
+
+#endif // DEBUG
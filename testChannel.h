@@ -0,0 +1,371 @@
+/***********************************************************************
+ * Header:
+ *    TEST CHANNEL
+ * Summary:
+ *    Unit tests for channel and the executors.  These only exist when
+ *    the compiler supports coroutines
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __cpp_impl_coroutine
+
+#include "channel.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class TestChannel : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Executor
+      test_singleThread_schedule();
+      test_threadPool_schedule();
+
+      // Single thread
+      test_push_room();
+      test_pop_ready();
+      test_pop_parks();
+      test_push_handsOver();
+      test_push_parksWhenFull();
+      test_pop_wakesPusher();
+      test_rendezvous();
+      test_close_wakesEveryone();
+      test_close_drains();
+      test_pipeline_fifo();
+
+      // Many threads
+      test_threadPool_mpmc();
+
+      report("Channel");
+   }
+
+   typedef custom::channel<int> Channel;
+
+   /***************************************
+    * COROUTINES
+    * The coroutines the tests run
+    ***************************************/
+
+   // move onto an executor, then count
+   static custom::detached_task hop(custom::executor& ex, std::atomic<int>& count)
+   {
+      co_await ex.schedule();
+      count++;
+   }
+
+   // push one item and note how it went
+   static custom::detached_task pushOne(Channel& ch, int value, int& result)
+   {
+      result = (co_await ch.push(value)) ? 1 : 0;
+   }
+
+   // pop one item, or -1 if closed
+   static custom::detached_task popOne(Channel& ch, int& result)
+   {
+      std::optional<int> value = co_await ch.pop();
+      result = value ? *value : -1;
+   }
+
+   // push first..last, then close
+   static custom::detached_task produce(custom::executor& ex, Channel& ch, int first, int last)
+   {
+      co_await ex.schedule();
+      for (int i = first; i <= last; i++)
+         co_await ch.push(i);
+   }
+
+   // pop until closed, keeping everything
+   static custom::detached_task consume(custom::executor& ex, Channel& ch, std::vector<int>& v)
+   {
+      co_await ex.schedule();
+      while (std::optional<int> value = co_await ch.pop())
+         v.push_back(*value);
+   }
+
+   // pop until closed, adding everything up
+   static custom::detached_task sum(custom::executor& ex, Channel& ch,
+                                    std::atomic<long long>& total, std::atomic<int>& done)
+   {
+      co_await ex.schedule();
+      while (std::optional<int> value = co_await ch.pop())
+         total += *value;
+      done++;
+   }
+
+   // push first..last on the pool, then report in
+   static custom::detached_task produceAndReport(custom::executor& ex, Channel& ch,
+                                                 int first, int last, std::atomic<int>& done)
+   {
+      co_await ex.schedule();
+      for (int i = first; i <= last; i++)
+         co_await ch.push(i);
+      done++;
+   }
+
+   /***************************************
+    * EXECUTOR
+    ***************************************/
+
+   // scheduled coroutines only run inside run()
+   void test_singleThread_schedule()
+   {  // setup
+      custom::single_thread_executor ex;
+      std::atomic<int> count(0);
+      hop(ex, count);
+      hop(ex, count);
+      bool waited = (count == 0);
+      // exercise
+      size_t num = ex.run();
+      // verify
+      assertUnit(waited);
+      assertUnit(num == 2);
+      assertUnit(count == 2);
+      assertUnit(ex.ready.empty());
+   }  // teardown
+
+   // the pool runs everything it was given before it goes away
+   void test_threadPool_schedule()
+   {  // setup
+      std::atomic<int> count(0);
+      // exercise
+      {
+         custom::thread_pool_executor ex(3);
+         for (int i = 0; i < 100; i++)
+            hop(ex, count);
+      }
+      // verify
+      assertUnit(count == 100);
+   }  // teardown
+
+   /***************************************
+    * SINGLE THREAD
+    ***************************************/
+
+   // a push with room never suspends
+   void test_push_room()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 2);
+      int result = -1;
+      // exercise
+      pushOne(ch, 99, result);
+      // verify
+      assertUnit(result == 1);
+      assertUnit(ch.size() == 1);
+      assertUnit(ch.items.front() == 99);
+   }  // teardown
+
+   // a pop with an item waiting never suspends
+   void test_pop_ready()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 2);
+      int pushed = -1;
+      int result = 0;
+      pushOne(ch, 99, pushed);
+      // exercise
+      popOne(ch, result);
+      // verify
+      assertUnit(result == 99);
+      assertUnit(ch.empty());
+   }  // teardown
+
+   // a pop on an empty channel parks in the waiter list
+   void test_pop_parks()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 2);
+      int result = 0;
+      // exercise
+      popOne(ch, result);
+      // verify
+      assertUnit(result == 0);
+      assertUnit(!ch.poppers.empty());
+      assertUnit(ch.poppers.pHead == ch.poppers.pTail);
+      ch.close();
+      ex.run();
+      assertUnit(result == -1);
+   }  // teardown
+
+   // a push with a pop parked hands the item straight over
+   void test_push_handsOver()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 2);
+      int result = 0;
+      int pushed = -1;
+      popOne(ch, result);
+      // exercise
+      pushOne(ch, 99, pushed);
+      // verify
+      assertUnit(pushed == 1);
+      assertUnit(ch.items.empty());
+      assertUnit(ch.poppers.empty());
+      assertUnit(result == 0);       // not resumed yet
+      ex.run();
+      assertUnit(result == 99);
+   }  // teardown
+
+   // a push into a full channel parks
+   void test_push_parksWhenFull()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 1);
+      int first = -1;
+      int second = -1;
+      // exercise
+      pushOne(ch, 11, first);
+      pushOne(ch, 26, second);
+      // verify
+      assertUnit(first == 1);
+      assertUnit(second == -1);
+      assertUnit(!ch.pushers.empty());
+      assertUnit(ch.size() == 1);
+      ch.close();
+      ex.run();
+      assertUnit(second == 0);
+   }  // teardown
+
+   // popping from a full channel lets a parked push in behind
+   void test_pop_wakesPusher()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 1);
+      int first = -1;
+      int second = -1;
+      int result = 0;
+      pushOne(ch, 11, first);
+      pushOne(ch, 26, second);
+      // exercise
+      popOne(ch, result);
+      ex.run();
+      // verify
+      assertUnit(result == 11);
+      assertUnit(second == 1);
+      assertUnit(ch.pushers.empty());
+      assertUnit(ch.items.front() == 26);
+   }  // teardown
+
+   // with no capacity a push waits for a pop, which takes it directly
+   void test_rendezvous()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 0);
+      int pushed = -1;
+      int result = 0;
+      pushOne(ch, 99, pushed);
+      bool parked = !ch.pushers.empty();
+      // exercise
+      popOne(ch, result);
+      ex.run();
+      // verify
+      assertUnit(parked);
+      assertUnit(result == 99);
+      assertUnit(pushed == 1);
+      assertUnit(ch.items.empty());
+   }  // teardown
+
+   // closing wakes every parked pop with nothing
+   void test_close_wakesEveryone()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 1);
+      int a = 0;
+      int b = 0;
+      popOne(ch, a);
+      popOne(ch, b);
+      // exercise
+      ch.close();
+      ex.run();
+      // verify
+      assertUnit(a == -1);
+      assertUnit(b == -1);
+      assertUnit(ch.poppers.empty());
+      assertUnit(ch.is_closed());
+   }  // teardown
+
+   // items pushed before the close can still be popped, but no more pushed
+   void test_close_drains()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 2);
+      int pushed = -1;
+      int result = 0;
+      pushOne(ch, 99, pushed);
+      ch.close();
+      // exercise
+      popOne(ch, result);
+      int late = -1;
+      pushOne(ch, 11, late);
+      int after = 0;
+      popOne(ch, after);
+      // verify
+      assertUnit(result == 99);
+      assertUnit(late == 0);
+      assertUnit(after == -1);
+   }  // teardown
+
+   // a producer and consumer through a small channel keep the order
+   void test_pipeline_fifo()
+   {  // setup
+      custom::single_thread_executor ex;
+      Channel ch(ex, 3);
+      std::vector<int> v;
+      consume(ex, ch, v);
+      produce(ex, ch, 1, 100);
+      // exercise
+      ex.run();
+      ch.close();
+      ex.run();
+      // verify
+      bool inOrder = (v.size() == 100);
+      for (size_t i = 0; inOrder && i < v.size(); i++)
+         inOrder = v[i] == int(i + 1);
+      assertUnit(inOrder);
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // producers and consumers on a pool lose nothing
+   void test_threadPool_mpmc()
+   {  // setup
+      const int numProducers = 4;
+      const int numConsumers = 3;
+      const int numEach = 5000;
+      std::atomic<long long> total(0);
+      std::atomic<int> producersDone(0);
+      std::atomic<int> consumersDone(0);
+      // exercise
+      {
+         custom::thread_pool_executor ex(4);
+         Channel ch(ex, 8);
+         for (int c = 0; c < numConsumers; c++)
+            sum(ex, ch, total, consumersDone);
+         for (int p = 0; p < numProducers; p++)
+            produceAndReport(ex, ch, 1, numEach, producersDone);
+         while (producersDone < numProducers)
+            std::this_thread::yield();
+         ch.close();
+         while (consumersDone < numConsumers)
+            std::this_thread::yield();
+      }
+      // verify
+      assertUnit(total == (long long)numProducers * numEach * (numEach + 1) / 2);
+   }  // teardown
+};
+
+#endif // __cpp_impl_coroutine
+#endif // DEBUG
@@ -0,0 +1,424 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT LIST
+ * Summary:
+ *    Unit tests for concurrent_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentList.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <vector>
+
+class TestConcurrentList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+
+      // Iterator
+      test_iterator_beginEmpty();
+      test_iterator_walk();
+      test_iterator_locks();
+      test_iterator_move();
+
+      // Insert
+      test_pushFront_standard();
+      test_pushBack_standard();
+      test_insert_middle();
+      test_insert_end();
+
+      // Remove
+      test_erase_middle();
+      test_erase_end();
+      test_removeIf_standard();
+      test_clear_standard();
+
+      // Search
+      test_findIf_found();
+      test_findIf_missing();
+
+      // Many threads
+      test_insert_disjoint();
+      test_erase_disjoint();
+      test_mixed_walkers();
+
+      report("ConcurrentList");
+   }
+
+   typedef custom::concurrent_list<int> List;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // an empty list is just its sentinel
+   void test_construct_default()
+   {  // exercise
+      List l;
+      // verify
+      assertUnit(l.head.pNext == nullptr);
+      assertUnit(l.size() == 0);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // build the standard list
+   void test_construct_initializerList()
+   {  // exercise
+      List l{ 11, 26, 31 };
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // an empty list starts at the end
+   void test_iterator_beginEmpty()
+   {  // setup
+      List l;
+      // exercise
+      List::iterator it = l.begin();
+      // verify
+      assertUnit(it.done());
+      assertUnit(it.pPrev == &l.head);
+   }  // teardown
+
+   // walk the list, and change an item on the way
+   void test_iterator_walk()
+   {  // setup
+      List l{ 11, 99, 31 };
+      // exercise
+      {
+         List::iterator it = l.begin();
+         ++it;
+         *it = 26;
+      }
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // the cursor holds the locks on its node and the one in front
+   void test_iterator_locks()
+   {  // setup
+      List l{ 11, 26, 31 };
+      List::Node* p11 = l.head.pNext;
+      List::Node* p26 = p11->pNext;
+      List::Node* p31 = p26->pNext;
+      // exercise
+      List::iterator it = l.begin();
+      ++it;
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(l.head.lock.try_lock());
+      l.head.lock.unlock();
+      assertUnit(!p11->lock.try_lock());
+      assertUnit(!p26->lock.try_lock());
+      assertUnit(p31->lock.try_lock());
+      p31->lock.unlock();
+      it.release();
+      assertUnit(p11->lock.try_lock());
+      assertUnit(p26->lock.try_lock());
+      p11->lock.unlock();
+      p26->lock.unlock();
+   }  // teardown
+
+   // moving a cursor moves its locks
+   void test_iterator_move()
+   {  // setup
+      List l{ 11, 26, 31 };
+      List::iterator it = l.begin();
+      // exercise
+      List::iterator itMoved(std::move(it));
+      // verify
+      assertUnit(it.p == nullptr);
+      assertUnit(it.pPrev == nullptr);
+      assertUnit(*itMoved == 11);
+      assertUnit(!l.head.lock.try_lock());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // add to the front
+   void test_pushFront_standard()
+   {  // setup
+      List l;
+      // exercise
+      l.push_front(31);
+      l.push_front(26);
+      l.push_front(11);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // add to the back
+   void test_pushBack_standard()
+   {  // setup
+      List l;
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert in front of the cursor, which then sits on the new item
+   void test_insert_middle()
+   {  // setup
+      List l{ 11, 31 };
+      // exercise
+      {
+         List::iterator it = l.begin();
+         ++it;
+         l.insert(it, 26);
+         assertUnit(*it == 26);
+      }
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert at the end
+   void test_insert_end()
+   {  // setup
+      List l{ 11, 26 };
+      // exercise
+      {
+         List::iterator it = l.begin();
+         ++it;
+         ++it;
+         l.insert(it, 31);
+      }
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase under the cursor, which then sits on the next item
+   void test_erase_middle()
+   {  // setup
+      List l{ 11, 99, 26, 31 };
+      // exercise
+      {
+         List::iterator it = l.begin();
+         ++it;
+         l.erase(it);
+         assertUnit(*it == 26);
+      }
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // erasing at the end does nothing
+   void test_erase_end()
+   {  // setup
+      List l{ 11, 26, 31 };
+      // exercise
+      {
+         List::iterator it = l.begin();
+         ++it;
+         ++it;
+         ++it;
+         l.erase(it);
+      }
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // remove all the odd items
+   void test_removeIf_standard()
+   {  // setup
+      List l{ 1, 11, 26, 3, 31, 5 };
+      // exercise
+      size_t num = l.remove_if([](int x) { return x < 10; });
+      // verify
+      assertUnit(num == 3);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // clear everything
+   void test_clear_standard()
+   {  // setup
+      List l{ 11, 26, 31 };
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.head.pNext == nullptr);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // find leaves the cursor locked on the item
+   void test_findIf_found()
+   {  // setup
+      List l{ 11, 26, 31 };
+      // exercise
+      List::iterator it = l.find_if([](int x) { return x == 26; });
+      // verify
+      assertUnit(!it.done());
+      assertUnit(*it == 26);
+   }  // teardown
+
+   // nothing matches
+   void test_findIf_missing()
+   {  // setup
+      List l{ 11, 26, 31 };
+      // exercise
+      List::iterator it = l.find_if([](int x) { return x == 99; });
+      // verify
+      assertUnit(it.done());
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // each thread inserts behind its own marker
+   void test_insert_disjoint()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 2000;
+      List l;
+      for (int t = numThreads - 1; t >= 0; t--)
+         l.push_front(-t - 1);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+            {
+               List::iterator it = l.find_if([t](int x) { return x == -t - 1; });
+               ++it;
+               l.insert(it, t);
+            }
+         }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(l.size() == size_t(numThreads * (numEach + 1)));
+      bool grouped = true;
+      int marker = 0;
+      l.for_each([&grouped, &marker](int x)
+      {
+         if (x < 0)
+            marker = -x - 1;
+         else
+            grouped = grouped && (x == marker);
+      });
+      assertUnit(grouped);
+   }  // teardown
+
+   // each thread erases the items in its own stretch
+   void test_erase_disjoint()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 2000;
+      List l;
+      for (int t = numThreads - 1; t >= 0; t--)
+         for (int i = 0; i < numEach; i++)
+            l.push_front(t);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t]()
+         {
+            List::iterator it = l.find_if([t](int x) { return x == t; });
+            while (!it.done() && *it == t)
+               l.erase(it);
+         }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.head.pNext == nullptr);
+   }  // teardown
+
+   // inserters, erasers and readers all in the list at once
+   void test_mixed_walkers()
+   {  // setup
+      const int numEach = 2000;
+      List l{ 0, 0, 0, 0 };
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 2; t++)
+      {
+         threads.push_back(std::thread([&l, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back(1);
+         }));
+         threads.push_back(std::thread([&l, numEach]()
+         {
+            int erased = 0;
+            while (erased < numEach)
+            {
+               List::iterator it = l.find_if([](int x) { return x == 1; });
+               if (!it.done())
+               {
+                  l.erase(it);
+                  erased++;
+               }
+            }
+         }));
+      }
+      threads.push_back(std::thread([&l]()
+      {
+         for (int i = 0; i < 200; i++)
+            l.for_each([](int& x) { x += 0; });
+      }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(l.size() == 4);
+      int sum = 99;
+      l.for_each([&sum](int x) { sum += x; });
+      assertUnit(sum == 99);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *      head
+    *     +----+   +----+   +----+   +----+
+    *     |    | > | 11 | > | 26 | > | 31 |
+    *     +----+   +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      const List::Node* p = l.head.pNext;
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3; i++)
+      {
+         assertIndirect(p != nullptr);
+         if (p == nullptr)
+            return;
+         assertIndirect(p->data == expected[i]);
+         p = p->pNext;
+      }
+      assertIndirect(p == nullptr);
+   }
+};
+
+#endif // DEBUG
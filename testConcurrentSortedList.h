@@ -0,0 +1,381 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT SORTED LIST
+ * Summary:
+ *    Unit tests for concurrent_sorted_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrentSortedList.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <vector>
+
+class TestConcurrentSortedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_insert_sorted();
+      test_insert_duplicate();
+
+      // Erase
+      test_erase_standard();
+      test_erase_missing();
+      test_erase_retires();
+      test_erase_deferred();
+
+      // Search
+      test_contains_standard();
+      test_contains_marked();
+      test_search_snipsChain();
+
+      // Many threads
+      test_insert_disjoint();
+      test_stress_linearizable();
+      test_stress_reclaimsUnderTraffic();
+
+      report("ConcurrentSortedList");
+   }
+
+   typedef custom::concurrent_sorted_list<int> List;
+
+   // let the epoch move on far enough to free whatever can be freed
+   static void reclaimAll(custom::epoch_domain& domain)
+   {
+      for (int i = 0; i < 3; i++)
+         domain.try_reclaim();
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // an empty list is the head linked to the tail
+   void test_construct_default()
+   {  // exercise
+      custom::epoch_domain domain;
+      List l(domain);
+      // verify
+      assertUnit(List::pointer(l.head.pNext.load()) == &l.tail);
+      assertUnit(&l.domain == &domain);
+      assertUnit(domain.retired() == 0);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // items land in order no matter the order they arrive
+   void test_insert_sorted()
+   {  // setup
+      List l;
+      // exercise
+      bool a = l.insert(26);
+      bool b = l.insert(31);
+      bool c = l.insert(11);
+      // verify
+      assertUnit(a && b && c);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a set holds each item once
+   void test_insert_duplicate()
+   {  // setup
+      List l;
+      l.insert(11);
+      l.insert(26);
+      l.insert(31);
+      // exercise
+      bool inserted = l.insert(26);
+      // verify
+      assertUnit(inserted == false);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // erase from the middle
+   void test_erase_standard()
+   {  // setup
+      List l;
+      l.insert(11);
+      l.insert(26);
+      l.insert(99);
+      l.insert(31);
+      // exercise
+      bool erased = l.erase(99);
+      // verify
+      assertUnit(erased);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // nothing to erase
+   void test_erase_missing()
+   {  // setup
+      List l;
+      l.insert(11);
+      l.insert(26);
+      l.insert(31);
+      // exercise
+      bool erased = l.erase(99);
+      // verify
+      assertUnit(erased == false);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // an erased node goes to the domain, which frees it once the epoch moves on
+   void test_erase_retires()
+   {  // setup
+      custom::epoch_domain domain;
+      List l(domain);
+      l.insert(11);
+      // exercise
+      l.erase(11);
+      size_t numRetired = domain.retired();
+      reclaimAll(domain);
+      // verify
+      assertUnit(numRetired == 1);
+      assertUnit(domain.retired() == 0);
+      assertUnit(List::pointer(l.head.pNext.load()) == &l.tail);
+   }  // teardown
+
+   // while another operation runs, the erased node is kept around
+   void test_erase_deferred()
+   {  // setup
+      custom::epoch_domain domain;
+      List l(domain);
+      l.insert(11);
+      l.insert(26);
+      size_t numKept;
+      {
+         custom::epoch_domain::guard g(domain);  // somebody else is in the list
+         // exercise
+         l.erase(11);
+         reclaimAll(domain);
+         numKept = domain.retired();
+         assertUnit(l.contains(26));
+      }  // they are done
+      reclaimAll(domain);
+      // verify
+      assertUnit(numKept == 1);
+      assertUnit(domain.retired() == 0);
+      assertUnit(l.contains(26));
+      assertUnit(!l.contains(11));
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // find what is there, and only that
+   void test_contains_standard()
+   {  // setup
+      List l;
+      l.insert(11);
+      l.insert(26);
+      l.insert(31);
+      // exercise and verify
+      assertUnit(l.contains(11));
+      assertUnit(l.contains(26));
+      assertUnit(l.contains(31));
+      assertUnit(!l.contains(10));
+      assertUnit(!l.contains(27));
+      assertUnit(!l.contains(99));
+   }  // teardown
+
+   // a marked node is already gone, even while still linked
+   void test_contains_marked()
+   {  // setup
+      List l;
+      l.insert(11);
+      l.insert(26);
+      List::Link* p26 = List::pointer(List::pointer(l.head.pNext.load())->pNext.load());
+      p26->pNext |= 1;
+      // exercise
+      bool found = l.contains(26);
+      // verify
+      assertUnit(found == false);
+      assertUnit(l.contains(11));
+   }  // teardown
+
+   // a search snips every marked node in a row with one CAS
+   void test_search_snipsChain()
+   {  // setup
+      custom::epoch_domain domain;
+      List l(domain);
+      l.insert(11);
+      l.insert(50);
+      l.insert(60);
+      l.insert(26);
+      l.insert(31);
+      List::Link* p26 = List::pointer(List::pointer(l.head.pNext.load())->pNext.load());
+      List::Link* p50 = List::pointer(List::pointer(p26->pNext.load())->pNext.load());
+      List::Link* p60 = List::pointer(p50->pNext.load());
+      p50->pNext |= 1;
+      p60->pNext |= 1;
+      l.numElements -= 2;
+      // exercise
+      List::Link* pLeft = nullptr;
+      List::Link* pRight = l.search(99, pLeft);
+      // verify
+      assertUnit(pRight == &l.tail);
+      assertUnit(List::value(pLeft) == 31);
+      assertUnit(List::pointer(pLeft->pNext.load()) == &l.tail);
+      assertUnit(domain.retired() == 2);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // threads filling interleaved keys build one sorted list
+   void test_insert_disjoint()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 2000;
+      List l;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t, numThreads, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.insert(i * numThreads + t);
+         }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(l.size() == size_t(numThreads * numEach));
+      int expected = 0;
+      bool sorted = true;
+      for (List::Link* p = List::pointer(l.head.pNext.load()); p != &l.tail;
+           p = List::pointer(p->pNext.load()))
+         sorted = sorted && List::value(p) == expected++;
+      assertUnit(sorted);
+      assertUnit(expected == numThreads * numEach);
+   }  // teardown
+
+   // threads fight over a few keys.  In any linearizable history each
+   // key's successful inserts and erases alternate, so their difference
+   // must be 0 or 1 and must match whether the key is there at the end
+   void test_stress_linearizable()
+   {  // setup
+      const int numThreads = 4;
+      const int numKeys = 16;
+      const int numEach = 20000;
+      custom::epoch_domain domain;
+      List l(domain);
+      std::vector<std::atomic<int>> balance(numKeys);
+      for (auto& b : balance)
+         b = 0;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, &balance, t, numKeys, numEach]()
+         {
+            unsigned int seed = 2654435761u * (t + 1);
+            for (int i = 0; i < numEach; i++)
+            {
+               seed = seed * 1103515245u + 12345u;
+               int key = (seed >> 8) % numKeys;
+               switch ((seed >> 20) % 3)
+               {
+                  case 0:
+                     if (l.insert(key))
+                        balance[key]++;
+                     break;
+                  case 1:
+                     if (l.erase(key))
+                        balance[key]--;
+                     break;
+                  default:
+                     l.contains(key);
+               }
+            }
+         }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      bool consistent = true;
+      size_t numPresent = 0;
+      for (int key = 0; key < numKeys; key++)
+      {
+         bool present = l.contains(key);
+         numPresent += present;
+         consistent = consistent && balance[key] == (present ? 1 : 0);
+      }
+      assertUnit(consistent);
+      assertUnit(l.size() == numPresent);
+      reclaimAll(domain);
+      assertUnit(domain.retired() == 0);
+   }  // teardown
+
+   // with operations always overlapping, erased nodes are still freed
+   // as the threads go, not piled up until the list falls quiet
+   void test_stress_reclaimsUnderTraffic()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 10000;
+      custom::epoch_domain domain;
+      List l(domain);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t]()
+         {
+            for (int i = 0; i < numEach; i++)
+            {
+               l.insert(t);
+               l.erase(t);
+            }
+         }));
+      for (auto& th : threads)
+         th.join();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(domain.retired() < size_t(numThreads * numEach) / 10);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *      head                                 tail
+    *     +----+   +----+   +----+   +----+   +----+
+    *     |    | > | 11 | > | 26 | > | 31 | > |    |
+    *     +----+   +----+   +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      List::Link* p = List::pointer(l.head.pNext.load());
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3; i++)
+      {
+         assertIndirect(p != &l.tail);
+         if (p == &l.tail)
+            return;
+         assertIndirect(!List::isMarked(p->pNext.load()));
+         assertIndirect(List::value(p) == expected[i]);
+         p = List::pointer(p->pNext.load());
+      }
+      assertIndirect(p == &l.tail);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,351 @@
+/***********************************************************************
+ * Header:
+ *    TEST COW LIST
+ * Summary:
+ *    Unit tests for cow_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "cowList.h"
+#include "unitTest.h"
+
+#include <string>
+
+class TestCowList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_empty();
+      test_constructCopy_shares();
+      test_constructMove_standard();
+      test_constructList_standard();
+
+      // Assign
+      test_assign_shares();
+      test_assign_lastOwnerFrees();
+
+      // Read
+      test_constIterator_noDetach();
+      test_constFront_noDetach();
+      test_front_empty();
+
+      // Write
+      test_pushback_detaches();
+      test_pushback_unsharedInPlace();
+      test_front_nonConstDetaches();
+      test_begin_nonConstDetaches();
+      test_copy_afterWritableAccessIsDeep();
+      test_insert_sharedTranslates();
+      test_erase_sharedTranslates();
+      test_popfront_shared();
+      test_clear_shared();
+
+      report("CowList");
+   }
+
+   typedef custom::cow_list<int> List;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // exercise
+      List l;
+      // verify
+      assertUnit(l.pBody == nullptr);
+      assertUnit(l.size() == 0);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // copying an empty list allocates nothing
+   void test_constructCopy_empty()
+   {  // setup
+      List lSrc;
+      // exercise
+      List lDest(lSrc);
+      // verify
+      assertUnit(lDest.pBody == nullptr);
+      assertUnit(lSrc.pBody == nullptr);
+   }  // teardown
+
+   // copying shares the nodes rather than duplicating them
+   void test_constructCopy_shares()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      // exercise
+      List lDest(lSrc);
+      // verify
+      assertUnit(lDest.pBody == lSrc.pBody);
+      assertUnit(lSrc.use_count() == 2);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // moving steals the reference without touching the count
+   void test_constructMove_standard()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      // exercise
+      List lDest(std::move(lSrc));
+      // verify
+      assertUnit(lSrc.pBody == nullptr);
+      assertUnit(lDest.use_count() == 1);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // adopt the nodes of an existing custom::list
+   void test_constructList_standard()
+   {  // setup
+      custom::list<int> l{ 11, 26, 31 };
+      // exercise
+      List lDest(std::move(l));
+      // verify
+      assertUnit(l.empty());
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assignment shares the nodes
+   void test_assign_shares()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      List lDes{ 99 };
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(lDes.pBody == lSrc.pBody);
+      assertUnit(lSrc.use_count() == 2);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // when the last owner lets go, the other body is untouched
+   void test_assign_lastOwnerFrees()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      List lDes(lSrc);
+      // exercise
+      lSrc = { 99 };
+      // verify
+      assertUnit(lDes.use_count() == 1);
+      assertUnit(lSrc.use_count() == 1);
+      assertUnit(lSrc.front() == 99);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   /***************************************
+    * READ
+    ***************************************/
+
+   // reading through a const iterator never copies
+   void test_constIterator_noDetach()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      const List lDest(lSrc);
+      int sum = 0;
+      // exercise
+      for (List::const_iterator it = lDest.begin(); it != lDest.end(); ++it)
+         sum += *it;
+      // verify
+      assertUnit(sum == 11 + 26 + 31);
+      assertUnit(lDest.pBody == lSrc.pBody);
+   }  // teardown
+
+   // reading the front through a const list never copies
+   void test_constFront_noDetach()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      const List lDest(lSrc);
+      // exercise
+      int front = lDest.front();
+      int back = lDest.back();
+      // verify
+      assertUnit(front == 11);
+      assertUnit(back == 31);
+      assertUnit(lDest.pBody == lSrc.pBody);
+   }  // teardown
+
+   // attempt to access the front of an empty list
+   void test_front_empty()
+   {  // setup
+      const List l;
+      // exercise
+      try
+      {
+         l.front();
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: unable to access data from an empty list") ==
+                    std::string(sError));
+      }
+   }  // teardown
+
+   /***************************************
+    * WRITE
+    ***************************************/
+
+   // the first write to a shared list gives it its own nodes
+   void test_pushback_detaches()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      List lDest(lSrc);
+      // exercise
+      lDest.push_back(99);
+      // verify
+      assertUnit(lDest.pBody != lSrc.pBody);
+      assertUnit(lSrc.use_count() == 1);
+      assertUnit(lDest.use_count() == 1);
+      assertUnit(lDest.size() == 4);
+      assertStandardFixture(lSrc);
+   }  // teardown
+
+   // writing to an unshared list does not copy
+   void test_pushback_unsharedInPlace()
+   {  // setup
+      List l{ 11, 26 };
+      void* pBody = l.pBody;
+      // exercise
+      l.push_back(31);
+      // verify
+      assertUnit(l.pBody == pBody);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // the non-const front could be written through, so it detaches
+   void test_front_nonConstDetaches()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      List lDest(lSrc);
+      // exercise
+      lDest.front() = 99;
+      // verify
+      assertUnit(lDest.pBody != lSrc.pBody);
+      assertUnit(lDest.front() == 99);
+      assertStandardFixture(lSrc);
+   }  // teardown
+
+   // the non-const begin could be written through, so it detaches
+   void test_begin_nonConstDetaches()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      List lDest(lSrc);
+      // exercise
+      List::iterator it = lDest.begin();
+      *it = 99;
+      // verify
+      assertUnit(lDest.pBody != lSrc.pBody);
+      assertStandardFixture(lSrc);
+   }  // teardown
+
+   // once an iterator or reference that can write is out, copies are deep
+   void test_copy_afterWritableAccessIsDeep()
+   {  // setup
+      List a{ 1, 2, 3 };
+      List::iterator it = a.begin();
+      int& f = a.front();
+      List b;
+      // exercise
+      b = a;
+      *it = 99;
+      f = 77;
+      // verify
+      assertUnit(a.pBody != b.pBody);
+      assertUnit(a.front() == 77);
+      assertUnit(b.front() == 1);
+      assertUnit(b.size() == 3);
+      assertUnit(b.back() == 3);
+      List c(a);
+      assertUnit(c.pBody != a.pBody);
+   }  // teardown
+
+   // an iterator taken before sharing still lands in the right spot
+   void test_insert_sharedTranslates()
+   {  // setup
+      List l{ 11, 31 };
+      List::iterator it = l.begin();
+      ++it;
+      List lOther(l);
+      // exercise
+      List::iterator itNew = l.insert(it, 26);
+      // verify
+      assertUnit(*itNew == 26);
+      assertUnit(l.pBody != lOther.pBody);
+      assertStandardFixture(l);
+      assertUnit(lOther.size() == 2);
+   }  // teardown
+
+   // erase through an iterator taken before sharing
+   void test_erase_sharedTranslates()
+   {  // setup
+      List l{ 11, 99, 26, 31 };
+      List::iterator it = l.begin();
+      ++it;
+      List lOther(l);
+      // exercise
+      List::iterator itNext = l.erase(it);
+      // verify
+      assertUnit(*itNext == 26);
+      assertStandardFixture(l);
+      assertUnit(lOther.size() == 4);
+   }  // teardown
+
+   // pop the front of a shared list
+   void test_popfront_shared()
+   {  // setup
+      List l{ 99, 11, 26, 31 };
+      List lOther(l);
+      // exercise
+      l.pop_front();
+      // verify
+      assertStandardFixture(l);
+      assertUnit(lOther.front() == 99);
+   }  // teardown
+
+   // clearing a shared list leaves the other owner alone
+   void test_clear_shared()
+   {  // setup
+      List lOther{ 11, 26, 31 };
+      List l(lOther);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.pBody == nullptr);
+      assertUnit(lOther.use_count() == 1);
+      assertStandardFixture(lOther);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      List::const_iterator it = l.begin();
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3 && it != l.end(); i++, ++it)
+         assertIndirect(*it == expected[i]);
+   }
+};
+
+#endif // DEBUG
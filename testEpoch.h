@@ -0,0 +1,319 @@
+/***********************************************************************
+ * Header:
+ *    TEST EPOCH
+ * Summary:
+ *    Unit tests for epoch_domain
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "epoch.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class TestEpoch : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Guard
+      test_guard_pins();
+      test_guard_releases();
+      test_guard_move();
+      test_guard_nested();
+      test_guard_twoDomains();
+      test_guard_manyThreadsGrow();
+
+      // Reclaim
+      test_advance_unpinned();
+      test_advance_blocked();
+      test_reclaim_afterTwoEpochs();
+      test_reclaim_waitsForReader();
+      test_retire_typed();
+      test_retire_manyThreads();
+      test_destructor_frees();
+
+      report("Epoch");
+   }
+
+   typedef custom::epoch_domain Domain;
+
+   // how many things the counting deleter has freed
+   static int& numFreed()
+   {
+      static int num = 0;
+      return num;
+   }
+   static void countFree(void*)
+   {
+      numFreed()++;
+   }
+
+   // how many slots are pinned
+   static int numPinned(Domain& d)
+   {
+      int num = 0;
+      for (Domain::SlotBlock* p = &d.slots; p != nullptr; p = p->pNext.load())
+         for (auto& slot : p->slots)
+            num += slot.pinned.load() != 0;
+      return num;
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nobody pinned, nothing retired
+   void test_construct_default()
+   {  // exercise
+      Domain d;
+      // verify
+      assertUnit(d.current() == 1);
+      assertUnit(d.retired() == 0);
+      assertUnit(numPinned(d) == 0);
+   }  // teardown
+
+   /***************************************
+    * GUARD
+    ***************************************/
+
+   // a guard stamps a slot with the current epoch
+   void test_guard_pins()
+   {  // setup
+      Domain d;
+      // exercise
+      Domain::guard g(d);
+      // verify
+      assertUnit(numPinned(d) == 1);
+      assertUnit(g.pSlot->pinned.load() == 1);
+   }  // teardown
+
+   // the slot is free again once the guard is gone
+   void test_guard_releases()
+   {  // setup
+      Domain d;
+      // exercise
+      {
+         Domain::guard g(d);
+      }
+      // verify
+      assertUnit(numPinned(d) == 0);
+   }  // teardown
+
+   // moving a guard moves the pin
+   void test_guard_move()
+   {  // setup
+      Domain d;
+      Domain::guard g(d);
+      // exercise
+      {
+         Domain::guard gMoved(std::move(g));
+         assertUnit(numPinned(d) == 1);
+         assertUnit(g.pDomain == nullptr);
+      }
+      // verify
+      assertUnit(numPinned(d) == 0);
+   }  // teardown
+
+   // a thread's guards share one slot, freed with the last of them
+   void test_guard_nested()
+   {  // setup
+      Domain d;
+      Domain::guard gOuter(d);
+      // exercise
+      bool shared;
+      {
+         Domain::guard gInner(d);
+         shared = gInner.pSlot == gOuter.pSlot && numPinned(d) == 1;
+      }
+      // verify
+      assertUnit(shared);
+      assertUnit(numPinned(d) == 1);
+      assertUnit(gOuter.pSlot->pinned.load() == 1);
+   }  // teardown
+
+   // guards in two domains take a slot in each
+   void test_guard_twoDomains()
+   {  // setup
+      Domain d1;
+      Domain d2;
+      // exercise
+      Domain::guard g1(d1);
+      Domain::guard g2(d2);
+      // verify
+      assertUnit(numPinned(d1) == 1);
+      assertUnit(numPinned(d2) == 1);
+   }  // teardown
+
+   // more threads than a block has slots: another block is added
+   void test_guard_manyThreadsGrow()
+   {  // setup
+      Domain d;
+      const int numThreads = (int)Domain::numSlots + 6;
+      std::atomic<int> numIn(0);
+      std::atomic<bool> leave(false);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&d, &numIn, &leave]()
+         {
+            Domain::guard g(d);
+            numIn++;
+            while (!leave.load())
+               std::this_thread::yield();
+         }));
+      while (numIn.load() < numThreads)
+         std::this_thread::yield();
+      int numHeld = numPinned(d);
+      bool grew = d.slots.pNext.load() != nullptr;
+      leave = true;
+      for (auto& t : threads)
+         t.join();
+      // verify
+      assertUnit(numHeld == numThreads);
+      assertUnit(grew);
+      assertUnit(numPinned(d) == 0);
+   }  // teardown
+
+   /***************************************
+    * RECLAIM
+    ***************************************/
+
+   // with no readers the epoch moves every time
+   void test_advance_unpinned()
+   {  // setup
+      Domain d;
+      // exercise
+      d.try_reclaim();
+      d.try_reclaim();
+      // verify
+      assertUnit(d.current() == 3);
+   }  // teardown
+
+   // a reader in an old epoch holds everybody back
+   void test_advance_blocked()
+   {  // setup
+      Domain d;
+      Domain::guard g(d);
+      // exercise
+      d.try_reclaim();   // the reader is in epoch 1, so this moves to 2
+      d.try_reclaim();   // but not to 3
+      // verify
+      assertUnit(d.current() == 2);
+   }  // teardown
+
+   // something retired is freed two epochs later
+   void test_reclaim_afterTwoEpochs()
+   {  // setup
+      Domain d;
+      numFreed() = 0;
+      d.retire(nullptr, countFree);
+      // exercise
+      size_t first = d.try_reclaim();
+      size_t second = d.try_reclaim();
+      // verify
+      assertUnit(first == 0);
+      assertUnit(second == 1);
+      assertUnit(numFreed() == 1);
+      assertUnit(d.retired() == 0);
+   }  // teardown
+
+   // nothing a reader might hold is freed until the reader is done
+   void test_reclaim_waitsForReader()
+   {  // setup
+      Domain d;
+      numFreed() = 0;
+      // exercise
+      {
+         Domain::guard g(d);
+         d.retire(nullptr, countFree);
+         for (int i = 0; i < 5; i++)
+            d.try_reclaim();
+         assertUnit(numFreed() == 0);
+         assertUnit(d.retired() == 1);
+      }
+      d.try_reclaim();
+      d.try_reclaim();
+      // verify
+      assertUnit(numFreed() == 1);
+   }  // teardown
+
+   // retire a typed pointer and it is deleted as that type
+   void test_retire_typed()
+   {  // setup
+      Domain d;
+      // exercise
+      d.retire(new int(99));
+      d.try_reclaim();
+      d.try_reclaim();
+      // verify
+      assertUnit(d.retired() == 0);
+   }  // teardown
+
+   // the count the concurrent test's deleter keeps
+   static std::atomic<int>& numFreedShared()
+   {
+      static std::atomic<int> num(0);
+      return num;
+   }
+   static void countFreeShared(void*)
+   {
+      numFreedShared()++;
+   }
+
+   // threads retiring and reclaiming at once lose nothing and free nothing twice
+   void test_retire_manyThreads()
+   {  // setup
+      const int numThreads = 8;
+      const int numEach = 1000;
+      numFreedShared() = 0;
+      {
+         Domain d;
+         std::vector<std::thread> threads;
+         // exercise
+         for (int t = 0; t < numThreads; t++)
+            threads.push_back(std::thread([&d]()
+            {
+               for (int i = 0; i < numEach; i++)
+               {
+                  Domain::guard g(d);
+                  d.retire(nullptr, countFreeShared);
+               }
+            }));
+         for (auto& th : threads)
+            th.join();
+         // verify
+         assertUnit(numFreedShared() + (int)d.retired() == numThreads * numEach);
+         assertUnit(numFreedShared() > 0);
+      }
+      assertUnit(numFreedShared() == numThreads * numEach);
+   }  // teardown
+
+   // whatever is left over goes with the domain
+   void test_destructor_frees()
+   {  // setup
+      numFreed() = 0;
+      {
+         Domain d;
+         d.retire(nullptr, countFree);
+         d.retire(nullptr, countFree);
+      // exercise
+      }
+      // verify
+      assertUnit(numFreed() == 2);
+   }  // teardown
+};
+
+#endif // DEBUG
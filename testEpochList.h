@@ -0,0 +1,304 @@
+/***********************************************************************
+ * Header:
+ *    TEST EPOCH LIST
+ * Summary:
+ *    Unit tests for epoch_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "epochList.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class TestEpochList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+
+      // Writer
+      test_pushFront_standard();
+      test_pushBack_standard();
+      test_popFront_retires();
+      test_popBack_standard();
+      test_erase_standard();
+      test_erase_twice();
+      test_removeIf_standard();
+      test_clear_standard();
+
+      // Reader
+      test_reader_standsOnErased();
+
+      // Many threads
+      test_readers_whileErasing();
+
+      report("EpochList");
+   }
+
+   typedef custom::epoch_list<int> List;
+   typedef custom::epoch_domain Domain;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in it
+   void test_construct_default()
+   {  // exercise
+      Domain d;
+      List l(d);
+      // verify
+      assertUnit(l.pHead.load() == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.empty());
+      assertUnit(&l.domain == &d);
+   }  // teardown
+
+   // build the standard list
+   void test_construct_initializerList()
+   {  // exercise
+      Domain d;
+      List l({ 11, 26, 31 }, d);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * WRITER
+    ***************************************/
+
+   // add to the front
+   void test_pushFront_standard()
+   {  // setup
+      Domain d;
+      List l(d);
+      // exercise
+      l.push_front(31);
+      l.push_front(26);
+      l.push_front(11);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // add to the back
+   void test_pushBack_standard()
+   {  // setup
+      Domain d;
+      List l(d);
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // a popped node is retired, not deleted
+   void test_popFront_retires()
+   {  // setup
+      Domain d;
+      List l({ 99, 11, 26, 31 }, d);
+      // exercise
+      l.pop_front();
+      // verify
+      assertStandardFixture(l);
+      assertUnit(d.retired() == 1);
+      d.try_reclaim();
+      d.try_reclaim();
+      assertUnit(d.retired() == 0);
+   }  // teardown
+
+   // pop the last one
+   void test_popBack_standard()
+   {  // setup
+      Domain d;
+      List l({ 11, 26, 31, 99 }, d);
+      // exercise
+      l.pop_back();
+      // verify
+      assertStandardFixture(l);
+      l.pop_back();
+      l.pop_back();
+      l.pop_back();
+      l.pop_back();
+      assertUnit(l.empty());
+      assertUnit(l.pHead.load() == nullptr);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   // erase what a reader found
+   void test_erase_standard()
+   {  // setup
+      Domain d;
+      List l({ 11, 99, 26, 31 }, d);
+      List::guard g = l.pin();
+      List::const_iterator it = l.begin();
+      ++it;
+      // exercise
+      bool erased = l.erase(it);
+      // verify
+      assertUnit(erased);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // the second erase of one node does nothing
+   void test_erase_twice()
+   {  // setup
+      Domain d;
+      List l({ 11, 26, 31, 99 }, d);
+      List::guard g = l.pin();
+      List::const_iterator it = l.begin();
+      ++it;
+      ++it;
+      ++it;
+      l.erase(it);
+      // exercise
+      bool erased = l.erase(it);
+      // verify
+      assertUnit(erased == false);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // remove everything matching
+   void test_removeIf_standard()
+   {  // setup
+      Domain d;
+      List l({ 1, 11, 2, 26, 31, 3 }, d);
+      // exercise
+      size_t num = l.remove_if([](int x) { return x < 10; });
+      // verify
+      assertUnit(num == 3);
+      assertStandardFixture(l);
+      assertUnit(d.retired() == 3);
+   }  // teardown
+
+   // remove everything
+   void test_clear_standard()
+   {  // setup
+      Domain d;
+      List l({ 11, 26, 31 }, d);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.pHead.load() == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(d.retired() == 3);
+   }  // teardown
+
+   /***************************************
+    * READER
+    ***************************************/
+
+   // a reader on an erased node still reads it, then walks on
+   void test_reader_standsOnErased()
+   {  // setup
+      Domain d;
+      List l({ 11, 99, 26, 31 }, d);
+      List::guard g = l.pin();
+      List::const_iterator it = l.begin();
+      ++it;
+      // exercise
+      l.remove_if([](int x) { return x == 99; });
+      for (int i = 0; i < 4; i++)
+         d.try_reclaim();
+      // verify
+      assertUnit(*it == 99);
+      ++it;
+      assertUnit(*it == 26);
+      assertUnit(d.retired() == 1);
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // readers walk with no lock while a writer churns the list
+   void test_readers_whileErasing()
+   {  // setup
+      const int numReaders = 3;
+      const int numRounds = 3000;
+      Domain d;
+      List l({ 1, 2, 3, 4, 5 }, d);
+      std::atomic<bool> done(false);
+      std::atomic<bool> sane(true);
+      std::vector<std::thread> readers;
+      // exercise
+      for (int t = 0; t < numReaders; t++)
+         readers.push_back(std::thread([&l, &done, &sane]()
+         {
+            while (!done)
+            {
+               List::guard g = l.pin();
+               for (List::const_iterator it = l.begin(); it != l.end(); ++it)
+                  if (*it < 1 || *it > 5)
+                     sane = false;
+            }
+         }));
+      for (int i = 0; i < numRounds; i++)
+      {
+         int value = i % 5 + 1;
+         l.remove_if([value](int x) { return x == value; });
+         l.push_back(value);
+         if (i % 2)
+         {
+            int front;
+            {
+               List::guard g = l.pin();
+               front = *l.begin();
+            }
+            l.pop_front();
+            l.push_front(front);
+         }
+      }
+      done = true;
+      for (auto& th : readers)
+         th.join();
+      // verify
+      assertUnit(sane);
+      assertUnit(l.size() == 5);
+      d.try_reclaim();
+      d.try_reclaim();
+      assertUnit(d.retired() == 0);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *      pHead             pTail
+    *     +----+   +----+   +----+
+    *     | 11 | > | 26 | > | 31 |
+    *     +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      List::guard g = l.pin();
+      List::const_iterator it = l.begin();
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3; i++, ++it)
+      {
+         assertIndirect(it != l.end());
+         if (it == l.end())
+            return;
+         assertIndirect(*it == expected[i]);
+      }
+      assertIndirect(it == l.end());
+      assertIndirect(l.pTail != nullptr && l.pTail->data == 31);
+      assertIndirect(l.pTail != nullptr && l.pTail->pPrev != nullptr && l.pTail->pPrev->data == 26);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,507 @@
+/***********************************************************************
+ * Header:
+ *    TEST FORWARD LIST
+ * Summary:
+ *    Unit tests for forward_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "forwardList.h"
+#include "unitTest.h"
+
+#include <string>
+
+class TestForwardList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeThreeFill();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInit_standard();
+      test_node_noPrev();
+
+      // Iterator
+      test_iterator_beforeBegin();
+      test_iterator_walk();
+
+      // Insert
+      test_pushfront_empty();
+      test_pushfront_standard();
+      test_pushback_tail();
+      test_insertAfter_beforeBegin();
+      test_insertAfter_middle();
+      test_insertAfter_end();
+
+      // Remove
+      test_popfront_standard();
+      test_eraseAfter_front();
+      test_eraseAfter_last();
+      test_eraseAfter_nothing();
+      test_clear_standard();
+
+      // Splice
+      test_spliceAfter_empty();
+      test_spliceAfter_standard();
+      test_spliceAfter_tail();
+      test_spliceAfter_single();
+
+      // Access
+      test_front_empty();
+      test_back_tail();
+
+      report("ForwardList");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // exercise
+      custom::forward_list<int> l;
+      // verify
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // construct with a size of three and fill
+   void test_construct_sizeThreeFill()
+   {  // exercise
+      custom::forward_list<int, true> l(size_t(3), int(99));
+      // verify
+      //    +----+   +----+   +----+
+      //    | 99 | - | 99 | - | 99 |
+      //    +----+   +----+   +----+
+      assertUnit(l.numElements == 3);
+      assertUnit(l.head.pNext != nullptr);
+      if (l.head.pNext && l.head.pNext->pNext && l.head.pNext->pNext->pNext)
+      {
+         assertUnit(l.head.pNext->data == 99);
+         assertUnit(l.head.pNext->pNext->data == 99);
+         assertUnit(l.head.pNext->pNext->pNext->data == 99);
+         assertUnit(l.head.pNext->pNext->pNext->pNext == nullptr);
+         assertUnit(l.pTail == l.head.pNext->pNext->pNext);
+      }
+   }  // teardown
+
+   // copy constructor of a 3-element collection
+   void test_constructCopy_standard()
+   {  // setup
+      custom::forward_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      // exercise
+      custom::forward_list<int> lDest(lSrc);
+      // verify
+      assertUnit(lSrc.head.pNext != lDest.head.pNext);
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // move constructor of a 3-element collection
+   void test_constructMove_standard()
+   {  // setup
+      custom::forward_list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::forward_list<int>::Node* p = lSrc.head.pNext;
+      // exercise
+      custom::forward_list<int> lDest(std::move(lSrc));
+      // verify
+      assertEmptyFixture(lSrc);
+      assertStandardFixture(lDest);
+      assertUnit(p == lDest.head.pNext);
+   }  // teardown
+
+   // use the initialization list to create the standard fixture
+   void test_constructInit_standard()
+   {  // exercise
+      custom::forward_list<int, true> l{ int(11), int(26), int(31) };
+      // verify
+      assertStandardFixture(l);
+      assertUnit(l.pTail != nullptr);
+      if (l.pTail)
+         assertUnit(l.pTail->data == 31);
+   }  // teardown
+
+   // the node is one pointer smaller than a doubly linked node
+   void test_node_noPrev()
+   {  // verify
+      assertUnit(sizeof(custom::forward_list<int>::Node) <=
+                 sizeof(int*) + sizeof(int*));
+      assertUnit(sizeof(custom::forward_list<int, true>::Node) ==
+                 sizeof(custom::forward_list<int>::Node));
+   }
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // before_begin() is the sentinel in front of the first node
+   void test_iterator_beforeBegin()
+   {  // setup
+      custom::forward_list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      custom::forward_list<int>::iterator it = l.before_begin();
+      ++it;
+      // verify
+      assertUnit(l.before_begin().p == &l.head);
+      assertUnit(it == l.begin());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // walk from begin() to end()
+   void test_iterator_walk()
+   {  // setup
+      custom::forward_list<int> l;
+      setupStandardFixture(l);
+      int sum = 0;
+      int count = 0;
+      // exercise
+      for (custom::forward_list<int>::iterator it = l.begin(); it != l.end(); it++)
+      {
+         sum += *it;
+         count++;
+      }
+      // verify
+      assertUnit(count == 3);
+      assertUnit(sum == 11 + 26 + 31);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty list
+   void test_pushfront_empty()
+   {  // setup
+      custom::forward_list<int, true> l;
+      // exercise
+      l.push_front(99);
+      // verify
+      assertUnit(l.numElements == 1);
+      assertUnit(l.head.pNext != nullptr);
+      assertUnit(l.pTail == l.head.pNext);
+      if (l.head.pNext)
+      {
+         assertUnit(l.head.pNext->data == 99);
+         assertUnit(l.head.pNext->pNext == nullptr);
+      }
+   }  // teardown
+
+   // push in front of the standard fixture
+   void test_pushfront_standard()
+   {  // setup
+      custom::forward_list<int> l;
+      setupStandardFixture(l);
+      custom::forward_list<int>::Node* pOld = l.head.pNext;
+      // exercise
+      l.push_front(99);
+      // verify
+      assertUnit(l.numElements == 4);
+      assertUnit(l.head.pNext->data == 99);
+      assertUnit(l.head.pNext->pNext == pOld);
+   }  // teardown
+
+   // push_back follows the tail pointer
+   void test_pushback_tail()
+   {  // setup
+      custom::forward_list<int, true> l;
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // verify
+      assertStandardFixture(l);
+      assertUnit(l.pTail != nullptr);
+      if (l.pTail)
+      {
+         assertUnit(l.pTail->data == 31);
+         assertUnit(l.pTail->pNext == nullptr);
+      }
+   }  // teardown
+
+   // insert after before_begin() is a push_front
+   void test_insertAfter_beforeBegin()
+   {  // setup
+      custom::forward_list<int> l{ int(26), int(31) };
+      // exercise
+      custom::forward_list<int>::iterator it = l.insert_after(l.before_begin(), 11);
+      // verify
+      assertUnit(it == l.begin());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert in the middle
+   void test_insertAfter_middle()
+   {  // setup
+      custom::forward_list<int> l{ int(11), int(31) };
+      // exercise
+      custom::forward_list<int>::iterator it = l.insert_after(l.begin(), 26);
+      // verify
+      assertUnit(*it == 26);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // insert after the last node moves the tail
+   void test_insertAfter_end()
+   {  // setup
+      custom::forward_list<int, true> l{ int(11), int(26) };
+      custom::forward_list<int, true>::iterator itLast = l.begin();
+      ++itLast;
+      // exercise
+      custom::forward_list<int, true>::iterator it = l.insert_after(itLast, 31);
+      // verify
+      assertUnit(it.p == l.pTail);
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // pop the front of the standard fixture
+   void test_popfront_standard()
+   {  // setup
+      custom::forward_list<int, true> l;
+      setupStandardFixture(l);
+      custom::forward_list<int, true>::Node* pTail = l.pTail;
+      // exercise
+      l.pop_front();
+      // verify
+      assertUnit(l.numElements == 2);
+      assertUnit(l.head.pNext->data == 26);
+      assertUnit(l.pTail == pTail);
+   }  // teardown
+
+   // erase after before_begin() removes the front
+   void test_eraseAfter_front()
+   {  // setup
+      custom::forward_list<int> l{ int(99), int(11), int(26), int(31) };
+      // exercise
+      custom::forward_list<int>::iterator it = l.erase_after(l.before_begin());
+      // verify
+      assertUnit(it == l.begin());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // erase the last node, the tail backs up one
+   void test_eraseAfter_last()
+   {  // setup
+      custom::forward_list<int, true> l{ int(11), int(26), int(31), int(99) };
+      custom::forward_list<int, true>::iterator it = l.begin();
+      ++it;
+      ++it;
+      // exercise
+      custom::forward_list<int, true>::iterator itReturn = l.erase_after(it);
+      // verify
+      assertUnit(itReturn == l.end());
+      assertUnit(l.pTail == it.p);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // erase after the last node does nothing
+   void test_eraseAfter_nothing()
+   {  // setup
+      custom::forward_list<int> l;
+      setupStandardFixture(l);
+      custom::forward_list<int>::iterator it = l.begin();
+      ++it;
+      ++it;
+      // exercise
+      custom::forward_list<int>::iterator itReturn = l.erase_after(it);
+      // verify
+      assertUnit(itReturn == l.end());
+      assertStandardFixture(l);
+   }  // teardown
+
+   // clear the standard fixture
+   void test_clear_standard()
+   {  // setup
+      custom::forward_list<int, true> l;
+      setupStandardFixture(l);
+      // exercise
+      l.clear();
+      // verify
+      assertEmptyFixture(l);
+      assertUnit(l.pTail == nullptr);
+   }  // teardown
+
+   /***************************************
+    * SPLICE
+    ***************************************/
+
+   // splicing an empty list changes nothing
+   void test_spliceAfter_empty()
+   {  // setup
+      custom::forward_list<int> l;
+      setupStandardFixture(l);
+      custom::forward_list<int> lEmpty;
+      // exercise
+      l.splice_after(l.before_begin(), lEmpty);
+      // verify
+      assertStandardFixture(l);
+      assertEmptyFixture(lEmpty);
+   }  // teardown
+
+   // splice into the middle without a tail pointer
+   void test_spliceAfter_standard()
+   {  // setup
+      custom::forward_list<int> l{ int(11), int(31) };
+      custom::forward_list<int> lSrc{ int(26) };
+      custom::forward_list<int>::Node* p = lSrc.head.pNext;
+      // exercise
+      l.splice_after(l.begin(), lSrc);
+      // verify
+      assertUnit(l.head.pNext->pNext == p);
+      assertStandardFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // splice onto the end, the tail moves to the end of the source
+   void test_spliceAfter_tail()
+   {  // setup
+      custom::forward_list<int, true> l{ int(11) };
+      custom::forward_list<int, true> lSrc{ int(26), int(31) };
+      custom::forward_list<int, true>::Node* pTail = lSrc.pTail;
+      // exercise
+      l.splice_after(l.begin(), lSrc);
+      // verify
+      assertUnit(l.pTail == pTail);
+      assertUnit(lSrc.pTail == nullptr);
+      assertStandardFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // move one node from one list to another
+   void test_spliceAfter_single()
+   {  // setup
+      custom::forward_list<int, true> l{ int(11), int(31) };
+      custom::forward_list<int, true> lSrc{ int(99), int(26) };
+      custom::forward_list<int, true>::Node* p = lSrc.pTail;
+      // exercise
+      l.splice_after(l.begin(), lSrc, lSrc.begin());
+      // verify
+      assertUnit(l.head.pNext->pNext == p);
+      assertStandardFixture(l);
+      assertUnit(lSrc.numElements == 1);
+      assertUnit(lSrc.pTail == lSrc.head.pNext);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // attempt to access the front of an empty list
+   void test_front_empty()
+   {  // setup
+      custom::forward_list<int> l;
+      // exercise
+      try
+      {
+         l.front();
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: unable to access data from an empty list") ==
+                    std::string(sError));
+      }
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // back reads the tail
+   void test_back_tail()
+   {  // setup
+      custom::forward_list<int, true> l;
+      setupStandardFixture(l);
+      // exercise
+      l.back() = 99;
+      // verify
+      assertUnit(l.pTail->data == 99);
+      l.pTail->data = 31;
+      assertStandardFixture(l);
+   }  // teardown
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *        head.pNext        pTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   template <bool hasTail>
+   void setupStandardFixture(custom::forward_list<int, hasTail>& l)
+   {
+      typedef typename custom::forward_list<int, hasTail>::Node Node;
+      Node* p1 = new Node(int(11));
+      Node* p2 = new Node(int(26));
+      Node* p3 = new Node(int(31));
+
+      // hook up pointers
+      p1->pNext = p2;
+      p2->pNext = p3;
+
+      // set up the list
+      l.head.pNext = p1;
+      l.pTail = hasTail ? p3 : nullptr;
+      l.numElements = 3;
+   }
+
+   /****************************************************************
+    * Verify Empty Fixture
+    ****************************************************************/
+   template <bool hasTail>
+   void assertEmptyFixtureParameters(const custom::forward_list<int, hasTail>& l,
+                                     int line, const char* function)
+   {
+      assertIndirect(l.numElements == 0);
+      assertIndirect(l.head.pNext == nullptr);
+      assertIndirect(l.pTail == nullptr);
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *        head.pNext        pTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   template <bool hasTail>
+   void assertStandardFixtureParameters(const custom::forward_list<int, hasTail>& l,
+                                        int line, const char* function)
+   {
+      assertIndirect(l.numElements == 3);
+      assertIndirect(l.head.pNext != nullptr);
+      if (l.head.pNext)
+      {
+         assertIndirect(l.head.pNext->data == int(11));
+         assertIndirect(l.head.pNext->pNext != nullptr);
+         if (l.head.pNext->pNext)
+         {
+            assertIndirect(l.head.pNext->pNext->data == int(26));
+            assertIndirect(l.head.pNext->pNext->pNext != nullptr);
+            if (l.head.pNext->pNext->pNext)
+            {
+               assertIndirect(l.head.pNext->pNext->pNext->data == int(31));
+               assertIndirect(l.head.pNext->pNext->pNext->pNext == nullptr);
+               if (hasTail)
+                  assertIndirect(l.pTail == l.head.pNext->pNext->pNext);
+            }
+         }
+      }
+   }
+};
+
+#endif // DEBUG
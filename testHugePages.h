@@ -0,0 +1,396 @@
+/***********************************************************************
+ * Header:
+ *    TEST HUGE PAGES
+ * Summary:
+ *    Unit tests for huge_pages, and for list blocks and arenas placed in them
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "hugePages.h"
+#include "list.h"
+#include "unitTest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+class TestHugePages : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Regions
+      test_allocate_small();
+      test_allocate_aligned();
+      test_allocate_advised();
+      test_fromHeap();
+      test_stats_count();
+
+      // Blocks
+      test_node_noBlockPointer();
+      test_owner_findsBlock();
+      test_compact_small_staysOnHeap();
+      test_compact_big_usesHugePages();
+      test_compact_off_staysOnHeap();
+
+      // Arena
+      test_arena_off_usesNew();
+      test_arena_carvesSideBySide();
+      test_arena_blockFreedWithLastNode();
+      test_arena_threadExitKeepsNodes();
+      test_arena_reusesFreedSlot();
+      test_arena_reusesSlotFreedElsewhere();
+      test_arena_churnStaysBounded();
+
+      report("HugePages");
+   }
+
+   typedef custom::huge_pages::region Region;
+
+   /***************************************
+    * REGIONS
+    ***************************************/
+
+   // even a little memory is writable, all of it
+   void test_allocate_small()
+   {  // setup
+      // exercise
+      Region r = custom::huge_pages::allocate(100);
+      // verify
+      assertUnit(r.p != nullptr);
+      assertUnit(r.bytes >= 100);
+      std::memset(r.p, 0x5A, r.bytes);
+      assertUnit(((unsigned char*)r.p)[r.bytes - 1] == 0x5A);
+      // teardown
+      custom::huge_pages::deallocate(r);
+   }
+
+   // a mapped region starts on a huge-page boundary and is whole pages
+   void test_allocate_aligned()
+   {  // setup
+      // exercise
+      Region r = custom::huge_pages::allocate(custom::huge_pages::pageSize + 1);
+      // verify
+      if (r.mapped)
+      {
+         assertUnit(reinterpret_cast<uintptr_t>(r.p) % custom::huge_pages::pageSize == 0);
+         assertUnit(r.bytes == 2 * custom::huge_pages::pageSize);
+      }
+      else
+         assertUnit(r.bytes == custom::huge_pages::pageSize + 1);
+      // teardown
+      custom::huge_pages::deallocate(r);
+   }
+
+   // huge pages are only promised when the system offers them
+   void test_allocate_advised()
+   {  // setup
+      // exercise
+      Region r = custom::huge_pages::allocate(custom::huge_pages::pageSize);
+      // verify
+      assertUnit(!r.advised || r.mapped);
+      assertUnit(!r.advised || custom::huge_pages::available());
+      // teardown
+      custom::huge_pages::deallocate(r);
+   }
+
+   // the fallback is plain heap memory
+   void test_fromHeap()
+   {  // setup
+      // exercise
+      Region r = custom::huge_pages::fromHeap(64);
+      // verify
+      assertUnit(r.p != nullptr);
+      assertUnit(r.bytes == 64);
+      assertUnit(!r.mapped);
+      assertUnit(!r.advised);
+      // teardown
+      custom::huge_pages::deallocate(r);
+   }
+
+   // every allocation is either mapped or a fallback
+   void test_stats_count()
+   {  // setup
+      custom::huge_pages::stats before = custom::huge_pages::get_stats();
+      // exercise
+      Region r = custom::huge_pages::allocate(4096);
+      custom::huge_pages::stats after = custom::huge_pages::get_stats();
+      // verify
+      assertUnit(after.regions == before.regions + 1);
+      assertUnit(after.mapped + after.fallbacks == before.mapped + before.fallbacks + 1);
+      assertUnit(after.advised - before.advised == (r.advised ? 1u : 0u));
+      // teardown
+      custom::huge_pages::deallocate(r);
+   }
+
+   /***************************************
+    * BLOCKS
+    ***************************************/
+
+   // is the block holding this list's nodes mapped?
+   template <typename T>
+   static bool mapped(custom::list<T>& l)
+   {
+      return custom::node_blocks::owner(l.pHead)->memory.mapped;
+   }
+
+   // a node is its item and two links, wherever it was made
+   void test_node_noBlockPointer()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(sizeof(custom::list<int>::Node) == 3 * sizeof(void*));
+   }  // teardown
+
+   // every node of a block maps to it, and nothing made with new does
+   void test_owner_findsBlock()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      custom::list<int> lHeap{ 11, 26, 31 };
+      // exercise
+      l.compact();
+      // verify
+      custom::node_blocks::block* pBlock = custom::node_blocks::owner(l.pHead);
+      assertUnit(pBlock != nullptr);
+      bool allFound = true;
+      for (custom::list<int>::Node* p = l.pHead; p != nullptr; p = p->pNext)
+         if (custom::node_blocks::owner(p) != pBlock)
+            allFound = false;
+      assertUnit(allFound);
+      for (custom::list<int>::Node* p = lHeap.pHead; p != nullptr; p = p->pNext)
+         assertUnit(custom::node_blocks::owner(p) == nullptr);
+      assertUnit(custom::node_blocks::owner(&l) == nullptr);
+   }  // teardown
+
+   // a block smaller than a huge page is not worth one
+   void test_compact_small_staysOnHeap()
+   {  // setup
+      custom::node_blocks::use_huge_pages();
+      custom::list<int> l{ 11, 26, 31 };
+      // exercise
+      l.compact();
+      // verify
+      assertUnit(!mapped(l));
+      // teardown
+      custom::node_blocks::use_huge_pages(false);
+   }
+
+   // a block of a huge page or more is mapped, where mmap exists
+   void test_compact_big_usesHugePages()
+   {  // setup
+      custom::node_blocks::use_huge_pages();
+      custom::list<int> l;
+      for (int i = 0; i < 100000; i++)
+         l.push_back(i);
+      custom::huge_pages::stats before = custom::huge_pages::get_stats();
+      // exercise
+      l.compact();
+      // verify
+      custom::huge_pages::stats after = custom::huge_pages::get_stats();
+      assertUnit(after.regions == before.regions + 1);
+      assertUnit(mapped(l) == (after.mapped == before.mapped + 1));
+      assertUnit(l.size() == 100000);
+      assertUnit(*l.rbegin() == 99999);
+      // teardown
+      custom::node_blocks::use_huge_pages(false);
+   }
+
+   // with huge pages off, even a big block comes from the heap
+   void test_compact_off_staysOnHeap()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 100000; i++)
+         l.push_back(i);
+      custom::huge_pages::stats before = custom::huge_pages::get_stats();
+      // exercise
+      l.compact();
+      // verify
+      assertUnit(!custom::node_blocks::uses_huge_pages());
+      assertUnit(custom::huge_pages::get_stats().regions == before.regions);
+      assertUnit(!mapped(l));
+   }  // teardown
+
+   /***************************************
+    * ARENA
+    ***************************************/
+
+   // start and end each test with no block half carved
+   static void flushArena()
+   {
+      custom::list<int>::localArena().flush();
+   }
+
+   // with the arena off, nodes come from new as always
+   void test_arena_off_usesNew()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      l.push_back(11);
+      l.push_front(26);
+      // verify
+      assertUnit(!custom::node_blocks::uses_arena());
+      assertUnit(custom::node_blocks::owner(l.pHead) == nullptr);
+      assertUnit(custom::node_blocks::owner(l.pTail) == nullptr);
+   }  // teardown
+
+   // nodes made one by one sit next to each other in one mapped block
+   void test_arena_carvesSideBySide()
+   {  // setup
+      flushArena();
+      custom::node_blocks::use_arena();
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         l.push_back(i);
+      l.insert(l.begin(), -1);
+      // verify
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      custom::node_blocks::block* pBlock = custom::node_blocks::owner(l.pHead);
+      assertUnit(pBlock != nullptr);
+      assertUnit(pBlock->memory.bytes >= custom::huge_pages::pageSize);
+      bool sideBySide = true;
+      for (custom::list<int>::Node* p = l.pHead->pNext; p->pNext != nullptr; p = p->pNext)
+         if (custom::node_blocks::owner(p) != pBlock || p->pNext != p + 1)
+            sideBySide = false;
+      assertUnit(sideBySide);
+      assertUnit(*l.rbegin() == 999);
+      // teardown
+      custom::node_blocks::use_arena(false);
+      l.clear();
+      flushArena();
+   }
+
+   // the block goes once the arena has moved on and its nodes are gone
+   void test_arena_blockFreedWithLastNode()
+   {  // setup
+      flushArena();
+      custom::node_blocks::use_arena();
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l{ 11, 26, 31 };
+      custom::node_blocks::use_arena(false);
+      // exercise
+      l.pop_front();
+      l.clear();
+      bool heldByArena = custom::node_blocks::size() == numBlocks + 1;
+      flushArena();
+      // verify
+      assertUnit(heldByArena);
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
+   // a thread that made nodes can end before the list it made them for
+   void test_arena_threadExitKeepsNodes()
+   {  // setup
+      custom::node_blocks::use_arena();
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l;
+      // exercise
+      std::thread t([&l]()
+      {
+         for (int i = 0; i < 100; i++)
+            l.push_back(i);
+      });
+      t.join();
+      custom::node_blocks::use_arena(false);
+      // verify
+      assertUnit(custom::node_blocks::owner(l.pHead) != nullptr);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      int sum = 0;
+      l.for_each([&sum](int& x) { sum += x; });
+      assertUnit(sum == 4950);
+      l.clear();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
+   // a node freed is the next one carved
+   void test_arena_reusesFreedSlot()
+   {  // setup
+      flushArena();
+      custom::node_blocks::use_arena();
+      custom::list<int> l{ 11, 26, 31 };
+      custom::list<int>::Node* pFreed = l.pHead->pNext;
+      // exercise
+      l.erase(++l.begin());
+      l.push_back(99);
+      // verify
+      assertUnit(l.pTail == pFreed);
+      assertUnit(l.size() == 3);
+      assertUnit(*l.rbegin() == 99);
+      // teardown
+      custom::node_blocks::use_arena(false);
+      l.clear();
+      flushArena();
+   }
+
+   // nodes freed on another thread come back to the thread that carved them
+   void test_arena_reusesSlotFreedElsewhere()
+   {  // setup
+      flushArena();
+      custom::node_blocks::use_arena();
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      custom::list<int>::Node* pFirst = l.pHead;
+      custom::list<int>::Node* pLast = l.pTail;
+      // exercise
+      std::thread t([&l]() { l.clear(); });
+      t.join();
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      // verify
+      bool reused = true;
+      for (custom::list<int>::Node* p = l.pHead; p != nullptr; p = p->pNext)
+         if ((uintptr_t)p < (uintptr_t)pFirst || (uintptr_t)p > (uintptr_t)pLast)
+            reused = false;
+      assertUnit(reused);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      // teardown
+      custom::node_blocks::use_arena(false);
+      l.clear();
+      flushArena();
+   }
+
+   // a few nodes left behind each round do not make every round take new blocks
+   void test_arena_churnStaysBounded()
+   {  // setup
+      flushArena();
+      custom::node_blocks::use_arena();
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> lKept;
+      // exercise
+      for (int round = 0; round < 5; round++)
+      {
+         custom::list<int> l;
+         for (int i = 0; i < 100000; i++)
+            l.push_back(i);
+         int i = 0;
+         for (custom::list<int>::iterator it = l.begin(); it != l.end(); i++)
+            if (i % 10000 == 0)
+               ++it;
+            else
+               it = l.erase(it);
+         lKept.splice(lKept.end(), l);
+      }
+      // verify
+      assertUnit(lKept.size() == 50);
+      assertUnit(custom::node_blocks::size() <= numBlocks + 2);
+      // teardown
+      custom::node_blocks::use_arena(false);
+      lKept.clear();
+      flushArena();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,313 @@
+/***********************************************************************
+ * Header:
+ *    TEST LAZY LIST
+ * Summary:
+ *    Unit tests for lazy_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "lazyList.h"
+#include "unitTest.h"
+
+#include <string>
+#include <vector>
+
+class TestLazyList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_fillIsOneNode();
+      test_construct_fillDefault();
+      test_construct_fillZero();
+      test_construct_copyKeepsRuns();
+
+      // Access
+      test_constIterate_readsRun();
+      test_iterate_writeOneSlot();
+      test_iterate_writeWholeRun();
+      test_iterate_backward();
+      test_frontBack_split();
+
+      // Insert
+      test_insert_splitsRun();
+      test_pushFrontBack_aroundRun();
+
+      // Remove
+      test_erase_shrinksRun();
+      test_erase_lastOfRun();
+      test_pop_shrinksRun();
+      test_clear();
+
+      report("LazyList");
+   }
+
+   typedef custom::lazy_list<int> List;
+
+   // the items, front to back, read without splitting anything
+   static std::vector<int> items(const List& l)
+   {
+      std::vector<int> v;
+      for (List::const_iterator it = l.cbegin(); it != l.cend(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   // the count of every node, front to back
+   static std::vector<size_t> runs(const List& l)
+   {
+      std::vector<size_t> v;
+      for (List::Node* p = l.pHead; p != nullptr; p = p->pNext)
+         v.push_back(p->count);
+      return v;
+   }
+
+   // the links agree, the tail is the last node, and the counts add up
+   static bool consistent(const List& l)
+   {
+      size_t num = 0;
+      List::Node* pPrev = nullptr;
+      for (List::Node* p = l.pHead; p != nullptr; p = p->pNext)
+      {
+         if (p->pPrev != pPrev || p->count == 0)
+            return false;
+         num += p->count;
+         pPrev = p;
+      }
+      return l.pTail == pPrev && num == l.size();
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // ten million slots, one node
+   void test_construct_fillIsOneNode()
+   {  // exercise
+      List l(10000000, 7);
+      // verify
+      assertUnit(l.size() == 10000000);
+      assertUnit(l.pHead != nullptr && l.pHead == l.pTail);
+      assertUnit(l.pHead->count == 10000000);
+      assertUnit(l.pHead->data == 7);
+   }  // teardown
+
+   // the same, with default items
+   void test_construct_fillDefault()
+   {  // exercise
+      custom::lazy_list<std::string> l(1000);
+      // verify
+      assertUnit(l.size() == 1000);
+      assertUnit(l.pHead == l.pTail);
+      assertUnit(l.pHead->data.empty());
+   }  // teardown
+
+   // no items, no nodes
+   void test_construct_fillZero()
+   {  // exercise
+      List l(0, 7);
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr && l.pTail == nullptr);
+   }  // teardown
+
+   // a copy is just as lazy
+   void test_construct_copyKeepsRuns()
+   {  // setup
+      List l(100, 7);
+      l.push_front(11);
+      // exercise
+      List copy(l);
+      // verify
+      assertUnit(runs(copy) == std::vector<size_t>({ 1, 100 }));
+      assertUnit(copy.size() == 101);
+      assertUnit(copy.pHead != l.pHead);
+      assertUnit(consistent(copy));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // reading a run slot by slot leaves it alone
+   void test_constIterate_readsRun()
+   {  // setup
+      List l(5, 7);
+      // exercise
+      std::vector<int> v = items(l);
+      // verify
+      assertUnit(v == std::vector<int>({ 7, 7, 7, 7, 7 }));
+      assertUnit(runs(l) == std::vector<size_t>({ 5 }));
+   }  // teardown
+
+   // writing one slot splits the run around it and no further
+   void test_iterate_writeOneSlot()
+   {  // setup
+      List l(10, 7);
+      List::iterator it = l.begin();
+      for (int i = 0; i < 3; i++)
+         ++it;
+      // exercise
+      *it = 99;
+      ++it;
+      bool next = it != l.end() && it.i == 0 && it.p->count == 6;
+      // verify
+      assertUnit(next);
+      assertUnit(runs(l) == std::vector<size_t>({ 3, 1, 6 }));
+      assertUnit(items(l) == std::vector<int>({ 7, 7, 7, 99, 7, 7, 7, 7, 7, 7 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // writing every slot makes every slot a node
+   void test_iterate_writeWholeRun()
+   {  // setup
+      List l(4, 0);
+      int value = 0;
+      // exercise
+      for (List::iterator it = l.begin(); it != l.end(); ++it)
+         *it = ++value;
+      // verify
+      assertUnit(runs(l) == std::vector<size_t>({ 1, 1, 1, 1 }));
+      assertUnit(items(l) == std::vector<int>({ 1, 2, 3, 4 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // stepping back through a run and into the node before it
+   void test_iterate_backward()
+   {  // setup
+      List l(3, 7);
+      l.push_front(11);
+      List::iterator it = l.rbegin();
+      // exercise
+      --it;
+      --it;
+      size_t inRun = it.i;
+      --it;
+      // verify
+      assertUnit(inRun == 0);
+      assertUnit(it == l.begin());
+      assertUnit(*it == 11);
+   }  // teardown
+
+   // front() and back() are writable, so they split off the ends
+   void test_frontBack_split()
+   {  // setup
+      List l(5, 7);
+      // exercise
+      l.front() = 11;
+      l.back() = 31;
+      // verify
+      assertUnit(runs(l) == std::vector<size_t>({ 1, 3, 1 }));
+      assertUnit(items(l) == std::vector<int>({ 11, 7, 7, 7, 31 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // inserting inside a run cuts it in two
+   void test_insert_splitsRun()
+   {  // setup
+      List l(6, 7);
+      List::iterator it = l.begin();
+      ++it;
+      ++it;
+      // exercise
+      List::iterator itNew = l.insert(it, 99);
+      // verify
+      assertUnit(*itNew == 99);
+      assertUnit(runs(l) == std::vector<size_t>({ 2, 1, 4 }));
+      assertUnit(items(l) == std::vector<int>({ 7, 7, 99, 7, 7, 7, 7 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // the ends are ordinary nodes
+   void test_pushFrontBack_aroundRun()
+   {  // setup
+      List l(3, 7);
+      // exercise
+      l.push_front(11);
+      l.push_back(31);
+      l.insert(l.end(), 42);
+      // verify
+      assertUnit(runs(l) == std::vector<size_t>({ 1, 3, 1, 1 }));
+      assertUnit(items(l) == std::vector<int>({ 11, 7, 7, 7, 31, 42 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erasing from a run is one less copy, and nothing is split
+   void test_erase_shrinksRun()
+   {  // setup
+      List l(5, 7);
+      List::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(it.p == l.pHead && it.i == 1);
+      assertUnit(runs(l) == std::vector<size_t>({ 4 }));
+      assertUnit(l.size() == 4);
+   }  // teardown
+
+   // erasing the last slot of a run moves on to the next node
+   void test_erase_lastOfRun()
+   {  // setup
+      List l(2, 7);
+      l.push_back(31);
+      List::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      // verify
+      assertUnit(it != l.end() && *it == 31);
+      assertUnit(runs(l) == std::vector<size_t>({ 1, 1 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // popping whittles a run away, then removes it
+   void test_pop_shrinksRun()
+   {  // setup
+      List l(3, 7);
+      l.push_back(31);
+      // exercise
+      l.pop_back();
+      l.pop_back();
+      l.pop_front();
+      bool one = runs(l) == std::vector<size_t>({ 1 });
+      l.pop_front();
+      l.pop_front();
+      // verify
+      assertUnit(one);
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr && l.pTail == nullptr);
+   }  // teardown
+
+   // clear frees runs and nodes alike
+   void test_clear()
+   {  // setup
+      List l(1000, 7);
+      l.push_front(11);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.cbegin() == l.cend());
+      l.push_back(42);
+      assertUnit(items(l) == std::vector<int>({ 42 }));
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -13,6 +13,26 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testList.h"       // for the spy unit tests
+#include "testForwardList.h"
+#include "testStaticList.h"
+#include "testCowList.h"
+#include "testPersistentList.h"
+#include "testMpscQueue.h"
+#include "testBlockingQueue.h"
+#include "testConcurrentList.h"
+#include "testConcurrentSortedList.h"
+#include "testEpoch.h"
+#include "testEpochList.h"
+#include "testShardedList.h"
+#include "testMailbox.h"
+#include "testChannel.h"
+#include "testWorkStealingPool.h"
+#include "testParallelList.h"
+#include "testHugePages.h"
+#include "testSoaList.h"
+#include "testPolicyList.h"
+#include "testAdaptiveList.h"
+#include "testLazyList.h"
 
 
 /**********************************************************************
@@ -24,6 +44,28 @@ int main()
 #ifdef DEBUG
    // unit tests
    TestList().run();
+   TestForwardList().run();
+   TestStaticList().run();
+   TestCowList().run();
+   TestPersistentList().run();
+   TestMpscQueue().run();
+   TestBlockingQueue().run();
+   TestConcurrentList().run();
+   TestConcurrentSortedList().run();
+   TestEpoch().run();
+   TestEpochList().run();
+   TestShardedList().run();
+   TestMailbox().run();
+   TestWorkStealingPool().run();
+   TestParallelList().run();
+   TestHugePages().run();
+   TestSoaList().run();
+   TestPolicyList().run();
+   TestAdaptiveList().run();
+   TestLazyList().run();
+#ifdef __cpp_impl_coroutine
+   TestChannel().run();
+#endif
 #endif // DEBUG
    
    return 0;
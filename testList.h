@@ -16,6 +16,8 @@
 #include "unitTest.h"
 
 #include <vector>
+#include <string>
+#include <typeinfo>
 #include <cassert>
 #include <memory>
 #include <iostream>
@@ -34,6 +36,8 @@ public:
       test_construct_sizeThreeFill();
       test_constructCopy_empty();
       test_constructCopy_standard();
+      test_constructCopy_bulk();
+      test_constructCopy_bulkNotTrivial();
       test_constructMove_empty();
       test_constructMove_standard();
       test_constructInit_empty();
@@ -49,6 +53,7 @@ public:
       test_assign_emptyToStandard();
       test_assign_smallToBig();
       test_assign_bigToSmall();
+      test_assign_bulk();
       test_assignInit_empty();
       test_assignInit_sameSize();
       test_assignInit_rightBigger();
@@ -103,6 +108,8 @@ public:
       // Remove
       test_clear_empty();
       test_clear_standard();
+      test_clear_trivialRuns();
+      test_clear_trivialCounts();
       test_popback_empty();
       test_popback_standard();
       test_popback_single();
@@ -114,6 +121,46 @@ public:
       test_erase_standardMiddle();
       test_erase_standardEnd();
 
+      // Splice
+      test_splice_emptyToEmpty();
+      test_splice_standardToEmpty();
+      test_splice_toEnd();
+      test_splice_toMiddle();
+      test_splitFront_none();
+      test_splitFront_some();
+      test_splitFront_all();
+      test_merge_interleave();
+      test_merge_stable();
+
+      // Traverse
+      test_forEach_empty();
+      test_forEach_standard();
+
+      // Layout
+      test_compact_empty();
+      test_compact_standard();
+      test_compact_twice();
+      test_compact_thenChange();
+      test_compact_spliceAway();
+      test_locality_empty();
+      test_locality_compacted();
+      test_locality_scattered();
+      test_memoryUsage_empty();
+      test_memoryUsage_standard();
+      test_memoryUsage_compacted();
+      test_listMemory_counts();
+      test_listMemory_off();
+      test_listMemory_bulkCopy();
+
+#if CUSTOM_LIST_HAS_CONSTEXPR
+      // Constant evaluation
+      test_constexpr_pushPop();
+      test_constexpr_insertErase();
+      test_constexpr_copyAssign();
+      test_freeze_standard();
+      test_freeze_empty();
+#endif
+
       // Status
       test_size_empty();
       test_size_three();
@@ -136,7 +183,7 @@ public:
       l.pTail = (custom::list<int>::Node*)0xBADF00D2;
       l.numElements = 99;
       // exercise
-      alloc.construct(&l); // the constructor is called explicitly
+      std::allocator_traits<std::allocator<custom::list<int>>>::construct(alloc, &l); // the constructor is called explicitly
       // verify
       assertEmptyFixture(l);
    }  // teardown
@@ -150,7 +197,7 @@ public:
       l.pTail = (custom::list<int>::Node*)0xBADF00D2;
       l.numElements = 99;
       // exercise
-      alloc.construct(&l,0); // the constructor is called explicitly
+      std::allocator_traits<std::allocator<custom::list<int>>>::construct(alloc, &l,0); // the constructor is called explicitly
       // verify
       assertEmptyFixture(l);
    }  // teardown
@@ -164,7 +211,7 @@ public:
       l.pTail = (custom::list<int>::Node*)0xBADF00D2;
       l.numElements = 99;
       // exercise
-      alloc.construct(&l, 3); // the constructor is called explicitly
+      std::allocator_traits<std::allocator<custom::list<int>>>::construct(alloc, &l, 3); // the constructor is called explicitly
       // verify
       //    +----+   +----+   +----+
       //    | 00 | - | 00 | - | 00 |
@@ -203,7 +250,7 @@ public:
       l.pTail = (custom::list<int>::Node*)0xBADF00D2;
       l.numElements = 99;
       // exercise
-      alloc.construct(&l, size_t(3), s); // the constructor is called explicitly
+      std::allocator_traits<std::allocator<custom::list<int>>>::construct(alloc, &l, size_t(3), s); // the constructor is called explicitly
       // verify
       //    +----+   +----+   +----+
       //    | 99 | - | 99 | - | 99 |
@@ -306,6 +353,46 @@ public:
       teardownStandardFixture(lDest);
    }
 
+   // a long list of ints is copied into one block
+   void test_constructCopy_bulk()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> lSrc;
+      for (int i = 0; i < 100; i++)
+         lSrc.push_back(i);
+      {
+         // exercise
+         custom::list<int> lDes(lSrc);
+         // verify
+         assertUnit(lDes.size() == 100);
+         assertUnit(lDes.pHead->pNext == lDes.pHead + 1);
+         assertUnit(lDes.pTail == lDes.pHead + 99);
+         assertUnit(lDes.pTail->pPrev == lDes.pHead + 98);
+         assertUnit(lDes.pHead->pPrev == nullptr);
+         assertUnit(lDes.pTail->pNext == nullptr);
+         assertUnit(lDes.pHead->data == 0 && lDes.pTail->data == 99);
+         assertUnit(custom::node_blocks::size() == numBlocks + 1);
+         assertUnit(lSrc.size() == 100);
+      }  // teardown
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }
+
+   // strings are copied one node at a time, however many
+   void test_constructCopy_bulkNotTrivial()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<std::string> lSrc;
+      for (int i = 0; i < 100; i++)
+         lSrc.push_back(std::to_string(i));
+      // exercise
+      custom::list<std::string> lDes(lSrc);
+      // verify
+      assertUnit(lDes.size() == 100);
+      assertUnit(lDes.pTail->data == "99");
+      assertUnit(custom::node_blocks::owner(lDes.pHead) == nullptr);
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
    /***************************************
     * MOVE CONSTRUCTOR
     ***************************************/
@@ -576,6 +663,26 @@ public:
       teardownStandardFixture(lDes);
    }  
 
+   // assigning a long list of ints copies it into one block
+   void test_assign_bulk()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> lSrc;
+      for (int i = 0; i < 64; i++)
+         lSrc.push_back(i);
+      custom::list<int> lDes;
+      setupStandardFixture(lDes);
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertUnit(lDes.size() == 64);
+      assertUnit(lDes.pTail == lDes.pHead + 63);
+      assertUnit(lDes.pTail->data == 63);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      lDes.clear();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
    // assign a small list of 3 onto a larger one of 4
    void test_assign_smallToBig()
    {  // setup
@@ -992,6 +1099,53 @@ public:
       assertEmptyFixture(l);
    }  // teardown
 
+   // a list made of a block run plus nodes from new clears cleanly
+   void test_clear_trivialRuns()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l;
+      for (int i = 0; i < 10; i++)
+         l.push_back(i);
+      l.compact();
+      l.push_back(10);
+      l.push_front(-1);
+      custom::list<int>::iterator it = l.begin();
+      for (int i = 0; i < 5; i++)
+         ++it;
+      l.insert(it, 99);
+      // exercise
+      l.clear();
+      // verify
+      assertEmptyFixture(l);
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
+   // plain bytes, counted by nobody else
+   struct Plain
+   {
+      int value;
+   };
+
+   // skipping the destructors still keeps the accounting right
+   void test_clear_trivialCounts()
+   {  // setup
+      custom::list_memory::enable();
+      long long before = custom::list_memory::of<Plain>().nodes;
+      custom::list<Plain> lSrc;
+      for (int i = 0; i < 100; i++)
+         lSrc.push_back(Plain{ i });
+      custom::list<Plain> lDes(lSrc);
+      long long full = custom::list_memory::of<Plain>().nodes;
+      // exercise
+      lSrc.clear();
+      lDes.clear();
+      // verify
+      long long after = custom::list_memory::of<Plain>().nodes;
+      custom::list_memory::enable(false);
+      assertUnit(full == before + 200);
+      assertUnit(after == before);
+   }  // teardown
+
 
    /***************************************
     * PUSH BACK
@@ -2044,6 +2198,598 @@ public:
       teardownStandardFixture(l);
    }
 
+   /***************************************
+    * SPLICE
+    ***************************************/
+
+   // splice an empty list onto an empty list
+   void test_splice_emptyToEmpty()
+   {  // setup
+      custom::list<int> l;
+      custom::list<int> lSrc;
+      // exercise
+      l.splice(l.end(), lSrc);
+      // verify
+      assertEmptyFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // splice the standard fixture onto an empty list, nodes and all
+   void test_splice_standardToEmpty()
+   {  // setup
+      custom::list<int> l;
+      custom::list<int> lSrc;
+      setupStandardFixture(lSrc);
+      custom::list<int>::Node* p1 = lSrc.pHead;
+      custom::list<int>::Node* p3 = lSrc.pTail;
+      // exercise
+      l.splice(l.begin(), lSrc);
+      // verify
+      assertStandardFixture(l);
+      assertUnit(l.pHead == p1);
+      assertUnit(l.pTail == p3);
+      assertEmptyFixture(lSrc);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // splice onto the end of a list
+   void test_splice_toEnd()
+   {  // setup
+      //        pHead             pTail
+      //       +----+   +----+   +----+
+      //       | 11 | - | 26 | - | 31 |
+      //       +----+   +----+   +----+
+      //         l          lSrc
+      custom::list<int> l{ 11 };
+      custom::list<int> lSrc{ 26, 31 };
+      // exercise
+      l.splice(l.end(), lSrc);
+      // verify
+      assertStandardFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // splice into the middle of a list
+   void test_splice_toMiddle()
+   {  // setup
+      custom::list<int> l{ 11, 31 };
+      custom::list<int> lSrc{ 26 };
+      custom::list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      l.splice(it, lSrc);
+      // verify
+      assertStandardFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // split nothing off
+   void test_splitFront_none()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      custom::list<int> lFront = l.split_front(0);
+      // verify
+      assertEmptyFixture(lFront);
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // split the first node off, leaving two behind
+   void test_splitFront_some()
+   {  // setup
+      //        pHead             pTail
+      //       +----+   +----+   +----+
+      //       | 11 | - | 26 | - | 31 |
+      //       +----+   +----+   +----+
+      custom::list<int> l;
+      setupStandardFixture(l);
+      custom::list<int>::Node* p1 = l.pHead;
+      custom::list<int>::Node* p2 = p1->pNext;
+      custom::list<int>::Node* p3 = p2->pNext;
+      // exercise
+      custom::list<int> lFront = l.split_front(1);
+      // verify
+      //       +----+     +----+   +----+
+      //       | 11 |     | 26 | - | 31 |
+      //       +----+     +----+   +----+
+      //       lFront        l
+      assertUnit(lFront.numElements == 1);
+      assertUnit(lFront.pHead == p1);
+      assertUnit(lFront.pTail == p1);
+      assertUnit(p1->pNext == nullptr);
+      assertUnit(l.numElements == 2);
+      assertUnit(l.pHead == p2);
+      assertUnit(l.pTail == p3);
+      assertUnit(p2->pPrev == nullptr);
+      // teardown
+      l.splice(l.begin(), lFront);
+      assertStandardFixture(l);
+      teardownStandardFixture(l);
+   }
+
+   // asking for more than there is takes everything
+   void test_splitFront_all()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      // exercise
+      custom::list<int> lFront = l.split_front(4);
+      // verify
+      assertStandardFixture(lFront);
+      assertEmptyFixture(l);
+      // teardown
+      teardownStandardFixture(lFront);
+   }
+
+   // merge two sorted lists into one
+   void test_merge_interleave()
+   {  // setup
+      custom::list<int> l{ 11, 31 };
+      custom::list<int> lSrc{ 26 };
+      // exercise
+      l.merge(lSrc, [](int lhs, int rhs) { return lhs < rhs; });
+      // verify
+      assertStandardFixture(l);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   // on a tie the item already in the list goes first
+   void test_merge_stable()
+   {  // setup
+      custom::list<int> l{ 11, 26 };
+      custom::list<int> lSrc{ 21, 31 };
+      // exercise: compare only the tens digit
+      l.merge(lSrc, [](int lhs, int rhs) { return lhs / 10 < rhs / 10; });
+      // verify
+      assertUnit(l.size() == 4);
+      custom::list<int>::iterator it = l.begin();
+      assertUnit(*it++ == 11);
+      assertUnit(*it++ == 26);
+      assertUnit(*it++ == 21);
+      assertUnit(*it++ == 31);
+      assertUnit(it == l.end());
+      assertUnit(l.pTail->data == 31);
+      assertUnit(l.pTail->pPrev->data == 21);
+      assertEmptyFixture(lSrc);
+   }  // teardown
+
+   /***************************************
+    * TRAVERSE
+    ***************************************/
+
+   // nothing to visit
+   void test_forEach_empty()
+   {  // setup
+      custom::list<int> l;
+      int count = 0;
+      // exercise
+      l.for_each([&count](int&) { count++; });
+      // verify
+      assertUnit(count == 0);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // every item front to back, and f may change them
+   void test_forEach_standard()
+   {  // setup
+      custom::list<int> l;
+      setupStandardFixture(l);
+      int seen[3] = { 0, 0, 0 };
+      int count = 0;
+      // exercise
+      l.for_each([&seen, &count](int& x) { seen[count++] = x; x++; });
+      // verify
+      assertUnit(count == 3);
+      assertUnit(seen[0] == 11);
+      assertUnit(seen[1] == 26);
+      assertUnit(seen[2] == 31);
+      assertUnit(l.pHead->data == 12);
+      assertUnit(l.pTail->data == 32);
+      l.for_each([](int& x) { x--; });
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // nothing to move, so no block
+   void test_compact_empty()
+   {  // setup
+      custom::list<int> l;
+      size_t numBlocks = custom::node_blocks::size();
+      // exercise
+      custom::list<int>::compact_report report = l.compact();
+      // verify
+      assertUnit(report.nodes == 0);
+      assertUnit(report.bytesReclaimed == 0);
+      assertUnit(custom::node_blocks::size() == numBlocks);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // three scattered nodes end up side by side, in order
+   void test_compact_standard()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      {
+         custom::list<int> l;
+         setupStandardFixture(l);
+         // exercise
+         custom::list<int>::compact_report report = l.compact();
+         // verify
+         assertStandardFixture(l);
+         assertUnit(l.pHead->pNext == l.pHead + 1);
+         assertUnit(l.pTail == l.pHead + 2);
+         assertUnit(report.nodes == 3);
+         assertUnit(report.bytesBefore == 3 * custom::node_blocks::footprint(sizeof(*l.pHead)));
+         assertUnit(report.bytesAfter == custom::node_blocks::footprint(custom::node_blocks::bytes(3, sizeof(*l.pHead))));
+         assertUnit(report.bytesReclaimed == (report.bytesBefore > report.bytesAfter ?
+                                              report.bytesBefore - report.bytesAfter : 0));
+         assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      }  // teardown
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }
+
+   // compacting again replaces the old block
+   void test_compact_twice()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l{ 11, 26, 31 };
+      l.compact();
+      // exercise
+      custom::list<int>::compact_report report = l.compact();
+      // verify
+      assertStandardFixture(l);
+      assertUnit(report.bytesBefore == 3 * sizeof(*l.pHead));
+      assertUnit(report.bytesReclaimed == 0);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      l.clear();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
+   // new nodes and block nodes live side by side
+   void test_compact_thenChange()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> l{ 11, 99, 26 };
+      l.compact();
+      // exercise
+      custom::list<int>::iterator it = l.begin();
+      l.erase(++it);
+      l.push_back(31);
+      l.pop_front();
+      l.push_front(11);
+      // verify
+      assertStandardFixture(l);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      l.pop_front();
+      l.pop_front();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+      l.clear();
+   }  // teardown
+
+   // block nodes spliced into another list are freed from there
+   void test_compact_spliceAway()
+   {  // setup
+      size_t numBlocks = custom::node_blocks::size();
+      custom::list<int> lDes;
+      {
+         custom::list<int> lSrc{ 11, 26, 31 };
+         lSrc.compact();
+         // exercise
+         lDes.splice(lDes.end(), lSrc);
+      }
+      // verify
+      assertStandardFixture(lDes);
+      assertUnit(custom::node_blocks::size() == numBlocks + 1);
+      lDes.clear();
+      assertUnit(custom::node_blocks::size() == numBlocks);
+   }  // teardown
+
+   // nothing to measure
+   void test_locality_empty()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      custom::list<int>::locality_report report = l.locality();
+      // verify
+      assertUnit(report.links == 0);
+      assertUnit(report.distinctLines == 0);
+      assertUnit(report.distinctPages == 0);
+      assertUnit(report.sameLine == 0.0);
+      assertUnit(report.nodeBytes == sizeof(custom::list<int>::Node));
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // a compacted list only ever steps forward to the same or next line
+   void test_locality_compacted()
+   {  // setup
+      custom::list<int> l;
+      for (int i = 0; i < 100; i++)
+         l.push_back(i);
+      l.compact();
+      // exercise
+      custom::list<int>::locality_report report = l.locality();
+      // verify
+      assertUnit(report.links == 99);
+      assertUnit(report.backward == 0);
+      assertUnit(report.sameLine + report.adjacentLine == 1.0);
+      assertUnit(report.histogram[0] == 99);
+      assertUnit(report.distinctPages <= 2);
+      assertUnit(report.bytesPerElement <= report.nodeBytes + 1.0);
+   }  // teardown
+
+   // four nodes placed by hand across two pages
+   //    a:0 -> b:64 -> c:4096 -> d:32
+   void test_locality_scattered()
+   {  // setup
+      typedef custom::list<int>::Node Node;
+      alignas(4096) static char buffer[2 * 4096];
+      Node* a = new (buffer + 0) Node(11);
+      Node* b = new (buffer + 64) Node(26);
+      Node* c = new (buffer + 4096) Node(31);
+      Node* d = new (buffer + 32) Node(49);
+      a->pNext = b; b->pNext = c; c->pNext = d;
+      d->pPrev = c; c->pPrev = b; b->pPrev = a;
+      custom::list<int> l;
+      l.pHead = a;
+      l.pTail = d;
+      l.numElements = 4;
+      // exercise
+      custom::list<int>::locality_report report = l.locality(64, 4096);
+      // verify
+      assertUnit(report.links == 3);
+      assertUnit(report.backward == 1);
+      assertUnit(report.sameLine == 0.0);
+      assertUnit(report.adjacentLine * 3 == 1.0);
+      assertUnit(report.samePage * 3 == 1.0);
+      assertUnit(report.adjacentPage * 3 == 2.0);
+      assertUnit(report.distinctLines == 3);
+      assertUnit(report.distinctPages == 2);
+      assertUnit(report.bytesPerElement == 48.0);
+      assertUnit(report.histogram[1] == 1);
+      assertUnit(report.histogram[6] == 2);
+      // teardown
+      l.pHead = l.pTail = nullptr;
+      l.numElements = 0;
+   }
+
+   // an empty list costs nothing
+   void test_memoryUsage_empty()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      custom::list<int>::memory_report report = l.memory_usage();
+      // verify
+      assertUnit(report.nodes == 0);
+      assertUnit(report.totalBytes == 0);
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // three nodes from new: items, links, padding and heap headers
+   void test_memoryUsage_standard()
+   {  // setup
+      typedef custom::list<int>::Node Node;
+      custom::list<int> l;
+      setupStandardFixture(l);
+      size_t padding = sizeof(Node) - sizeof(int) - 2 * sizeof(Node*);
+      size_t header = custom::node_blocks::footprint(sizeof(Node)) - sizeof(Node);
+      // exercise
+      custom::list<int>::memory_report report = l.memory_usage();
+      // verify
+      assertUnit(report.nodes == 3);
+      assertUnit(report.payloadBytes == 3 * sizeof(int));
+      assertUnit(report.linkBytes == 3 * 2 * sizeof(Node*));
+      assertUnit(report.overheadBytes == 3 * (padding + header));
+      assertUnit(report.slackBytes == 0);
+      assertUnit(report.totalBytes == 3 * custom::node_blocks::footprint(sizeof(Node)));
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // a compacted list has no heap headers, but erasing leaves slack
+   void test_memoryUsage_compacted()
+   {  // setup
+      typedef custom::list<int>::Node Node;
+      custom::list<int> l{ 99, 11, 26, 31 };
+      l.compact();
+      size_t padding = sizeof(Node) - sizeof(int) - 2 * sizeof(Node*);
+      // exercise
+      l.pop_front();
+      custom::list<int>::memory_report report = l.memory_usage();
+      // verify
+      assertUnit(report.nodes == 3);
+      assertUnit(report.overheadBytes == 3 * padding);
+      assertUnit(report.slackBytes == sizeof(Node));
+      assertUnit(report.totalBytes == 4 * sizeof(Node));
+      assertStandardFixture(l);
+   }  // teardown
+
+   // an element type only these tests use, so the counts are ours alone
+   struct Counted
+   {
+      int value;
+   };
+
+   // nodes count themselves while accounting is on
+   void test_listMemory_counts()
+   {  // setup
+      typedef custom::list<Counted>::Node Node;
+      custom::list_memory::enable();
+      // exercise
+      custom::list<Counted> l;
+      l.push_back(Counted{ 11 });
+      l.push_back(Counted{ 26 });
+      l.push_back(Counted{ 31 });
+      custom::list_memory::totals full = custom::list_memory::of<Counted>();
+      l.pop_front();
+      custom::list_memory::totals less = custom::list_memory::of<Counted>();
+      l.clear();
+      custom::list_memory::totals none = custom::list_memory::of<Counted>();
+      custom::list_memory::enable(false);
+      // verify
+      assertUnit(full.nodes == 3);
+      assertUnit(full.bytes == (long long)(3 * sizeof(Node)));
+      assertUnit(less.nodes == 2);
+      assertUnit(less.peakBytes == (long long)(3 * sizeof(Node)));
+      assertUnit(none.nodes == 0);
+      assertUnit(none.bytes == 0);
+      bool listed = false;
+      std::vector<custom::list_memory::totals> all = custom::list_memory::report();
+      for (size_t i = 0; i < all.size(); i++)
+         listed = listed || std::string(all[i].type) == typeid(Counted).name();
+      assertUnit(listed);
+   }  // teardown
+
+   // nothing is counted while accounting is off
+   void test_listMemory_off()
+   {  // setup
+      custom::list_memory::totals before = custom::list_memory::of<Counted>();
+      // exercise
+      custom::list<Counted> l;
+      l.push_back(Counted{ 99 });
+      // verify
+      assertUnit(!custom::list_memory::is_enabled());
+      assertUnit(custom::list_memory::of<Counted>().nodes == before.nodes);
+   }  // teardown
+
+   // a bulk copy counts all its nodes at once, and they leave one by one
+   void test_listMemory_bulkCopy()
+   {  // setup
+      typedef custom::list<Counted>::Node Node;
+      custom::list<Counted> lSrc;
+      for (int i = 0; i < 100; i++)
+         lSrc.push_back(Counted{ i });
+      custom::list_memory::enable();
+      custom::list_memory::totals before = custom::list_memory::of<Counted>();
+      // exercise
+      custom::list<Counted> lDes(lSrc);
+      custom::list_memory::totals copied = custom::list_memory::of<Counted>();
+      lDes.pop_back();
+      custom::list_memory::totals popped = custom::list_memory::of<Counted>();
+      lDes.clear();
+      custom::list_memory::totals cleared = custom::list_memory::of<Counted>();
+      custom::list_memory::enable(false);
+      // verify
+      assertUnit(lSrc.size() == 100);
+      assertUnit(copied.nodes == before.nodes + 100);
+      assertUnit(copied.bytes == before.bytes + (long long)(100 * sizeof(Node)));
+      assertUnit(popped.nodes == before.nodes + 99);
+      assertUnit(cleared.nodes == before.nodes);
+      assertUnit(cleared.bytes == before.bytes);
+   }  // teardown
+
+#if CUSTOM_LIST_HAS_CONSTEXPR
+   /***************************************
+    * CONSTANT EVALUATION
+    ***************************************/
+
+   // the items front to back as decimal digit pairs: 11, 26, 31 is 112631
+   static constexpr long long digits(custom::list<int>& l)
+   {
+      long long value = 0;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+         value = value * 100 + *it;
+      return value;
+   }
+
+   // push and pop at both ends, all at compile time
+   void test_constexpr_pushPop()
+   {  // exercise
+      constexpr long long value = []
+      {
+         custom::list<int> l;
+         l.push_back(26);
+         l.push_back(31);
+         l.push_front(11);
+         l.push_front(99);
+         l.push_back(99);
+         l.pop_front();
+         l.pop_back();
+         return digits(l) * 10 + (long long)l.size();
+      }();
+      // verify
+      static_assert(value == 1126313, "built at compile time");
+      assertUnit(value == 1126313);
+   }  // teardown
+
+   // insert and erase in the middle, then clear
+   void test_constexpr_insertErase()
+   {  // exercise
+      constexpr long long value = []
+      {
+         custom::list<int> l{ 11, 31 };
+         custom::list<int>::iterator it = l.begin();
+         ++it;
+         it = l.insert(it, 99);
+         l.insert(it, 26);
+         l.erase(it);
+         long long before = digits(l);
+         l.clear();
+         return before * 10 + (long long)l.size();
+      }();
+      // verify
+      static_assert(value == 1126310, "built at compile time");
+      assertUnit(value == 1126310);
+   }  // teardown
+
+   // copies, moves, and splices make no allocation escape
+   void test_constexpr_copyAssign()
+   {  // exercise
+      constexpr long long value = []
+      {
+         custom::list<int> l{ 11, 26 };
+         custom::list<int> copy(l);
+         custom::list<int> other;
+         other = copy;
+         other.push_back(31);
+         custom::list<int> moved(std::move(other));
+         l.splice(l.end(), moved);
+         return digits(l) * 10 + (long long)(copy.size() + moved.size());
+      }();
+      // verify
+      static_assert(value == 11261126312, "built at compile time");
+      assertUnit(value == 11261126312);
+   }  // teardown
+
+   // a list built at compile time survives in static storage
+   void test_freeze_standard()
+   {  // exercise
+      static constexpr custom::frozen_list<int, 4> frozen = custom::freeze<4>([]
+      {
+         custom::list<int> l{ 26, 31 };
+         l.push_front(11);
+         return l;
+      });
+      // verify
+      static_assert(frozen.size() == 3, "frozen at compile time");
+      assertUnit(frozen.size() == 3);
+      assertUnit(frozen[0] == 11);
+      assertUnit(frozen[1] == 26);
+      assertUnit(frozen[2] == 31);
+      int sum = 0;
+      for (int x : frozen)
+         sum += x;
+      assertUnit(sum == 68);
+   }  // teardown
+
+   // an empty list freezes to nothing
+   void test_freeze_empty()
+   {  // exercise
+      static constexpr auto frozen = custom::freeze<0>([] { return custom::list<int>(); });
+      // verify
+      assertUnit(frozen.empty());
+      assertUnit(frozen.begin() == frozen.end());
+   }  // teardown
+#endif
+
 
    /***************************************
     * ITERATOR
@@ -0,0 +1,237 @@
+/***********************************************************************
+ * Header:
+ *    TEST MAILBOX
+ * Summary:
+ *    Unit tests for mailbox
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mailbox.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <vector>
+
+#define assertStandardList(x) assertStandardListParameters(x, __LINE__, __FUNCTION__)
+
+class TestMailbox : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Single thread
+      test_post_empty();
+      test_post_takesNodes();
+      test_receive_empty();
+      test_receive_oneBatch();
+      test_receive_fifo();
+      test_receive_appends();
+      test_destructor_unread();
+
+      // Many threads
+      test_producers_batches();
+
+      report("Mailbox");
+   }
+
+   typedef custom::mailbox<int> Mailbox;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing posted
+   void test_construct_default()
+   {  // exercise
+      Mailbox m;
+      // verify
+      assertUnit(m.pTop.load() == nullptr);
+      assertUnit(m.empty());
+   }  // teardown
+
+   /***************************************
+    * SINGLE THREAD
+    ***************************************/
+
+   // posting an empty list posts nothing
+   void test_post_empty()
+   {  // setup
+      Mailbox m;
+      custom::list<int> batch;
+      // exercise
+      m.post(batch);
+      // verify
+      assertUnit(m.empty());
+   }  // teardown
+
+   // the mailbox takes the nodes and leaves the list empty
+   void test_post_takesNodes()
+   {  // setup
+      Mailbox m;
+      custom::list<int> batch{ 11, 26, 31 };
+      int* pFirst = &batch.front();
+      int* pLast = &batch.back();
+      // exercise
+      m.post(batch);
+      // verify
+      assertUnit(batch.empty());
+      assertUnit(!m.empty());
+      Mailbox::Batch* pBatch = m.pTop.load();
+      assertUnit(pBatch->num == 3);
+      assertUnit(&pBatch->pHead->data == pFirst);
+      assertUnit(&pBatch->pTail->data == pLast);
+      assertUnit(pBatch->pNext == nullptr);
+   }  // teardown
+
+   // nothing to take
+   void test_receive_empty()
+   {  // setup
+      Mailbox m;
+      custom::list<int> l;
+      // exercise
+      size_t num = m.receive(l);
+      // verify
+      assertUnit(num == 0);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // the same nodes come out the other side
+   void test_receive_oneBatch()
+   {  // setup
+      Mailbox m;
+      custom::list<int> batch{ 11, 26, 31 };
+      int* pFirst = &batch.front();
+      m.post(batch);
+      custom::list<int> l;
+      // exercise
+      size_t num = m.receive(l);
+      // verify
+      assertUnit(num == 3);
+      assertStandardList(l);
+      assertUnit(&l.front() == pFirst);
+      assertUnit(m.empty());
+   }  // teardown
+
+   // batches come out in the order they were posted
+   void test_receive_fifo()
+   {  // setup
+      Mailbox m;
+      custom::list<int> batch1{ 11 };
+      custom::list<int> batch2{ 26 };
+      custom::list<int> batch3{ 31 };
+      m.post(batch1);
+      m.post(batch2);
+      m.post(batch3);
+      custom::list<int> l;
+      // exercise
+      size_t num = m.receive(l);
+      // verify
+      assertUnit(num == 3);
+      assertStandardList(l);
+   }  // teardown
+
+   // receive adds to what is already in the list
+   void test_receive_appends()
+   {  // setup
+      Mailbox m;
+      custom::list<int> batch{ 26, 31 };
+      m.post(batch);
+      custom::list<int> l{ 11 };
+      // exercise
+      m.receive(l);
+      // verify
+      assertStandardList(l);
+   }  // teardown
+
+   // batches nobody received go with the mailbox
+   void test_destructor_unread()
+   {  // setup
+      custom::list<int> batch1{ 11, 26 };
+      custom::list<int> batch2{ 31 };
+      // exercise
+      {
+         Mailbox m;
+         m.post(batch1);
+         m.post(batch2);
+      }
+      // verify
+      assertUnit(batch1.empty());
+      assertUnit(batch2.empty());
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // each producer's items arrive in order and none are lost
+   void test_producers_batches()
+   {  // setup
+      const int numProducers = 4;
+      const int numBatches = 200;
+      const int batchSize = 100;
+      const int numEach = numBatches * batchSize;
+      Mailbox m;
+      std::vector<std::thread> producers;
+      custom::list<int> l;
+      // exercise
+      for (int t = 0; t < numProducers; t++)
+         producers.push_back(std::thread([&m, t, numBatches, batchSize, numEach]()
+         {
+            int next = 0;
+            for (int b = 0; b < numBatches; b++)
+            {
+               custom::list<int> batch;
+               for (int i = 0; i < batchSize; i++)
+                  batch.push_back(t * numEach + next++);
+               m.post(batch);
+            }
+         }));
+      while (l.size() < size_t(numProducers * numEach))
+         m.receive(l);
+      for (auto& th : producers)
+         th.join();
+      // verify
+      assertUnit(l.size() == size_t(numProducers * numEach));
+      std::vector<int> next(numProducers, 0);
+      bool inOrder = true;
+      for (custom::list<int>::iterator it = l.begin(); it != l.end(); ++it)
+      {
+         int t = *it / numEach;
+         inOrder = inOrder && (*it % numEach == next[t]);
+         next[t]++;
+      }
+      assertUnit(inOrder);
+      assertUnit(m.empty());
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard List
+    *        pHead             pTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardListParameters(custom::list<int>& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      custom::list<int>::iterator it = l.begin();
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3 && it != l.end(); i++, ++it)
+         assertIndirect(*it == expected[i]);
+      it = l.rbegin();
+      for (int i = 2; i >= 0 && it != l.end(); i--, --it)
+         assertIndirect(*it == expected[i]);
+   }
+};
+
+#endif // DEBUG
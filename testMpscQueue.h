@@ -0,0 +1,245 @@
+/***********************************************************************
+ * Header:
+ *    TEST MPSC QUEUE
+ * Summary:
+ *    Unit tests for mpsc_queue
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mpscQueue.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <vector>
+
+class TestMpscQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Single thread
+      test_push_one();
+      test_pop_empty();
+      test_pop_fifo();
+      test_pop_recycles();
+      test_drain_empty();
+      test_drain_standard();
+      test_drain_thenPush();
+
+      // Many threads
+      test_producers_tryPop();
+      test_producers_drain();
+
+      report("MpscQueue");
+   }
+
+   typedef custom::mpsc_queue<int> Queue;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new queue is just its dummy node
+   void test_construct_default()
+   {  // exercise
+      Queue q;
+      // verify
+      assertUnit(q.pHead != nullptr);
+      assertUnit(q.pTail.load() == q.pHead);
+      assertUnit(q.pHead->pNext.load() == nullptr);
+      assertUnit(q.empty());
+   }  // teardown
+
+   /***************************************
+    * SINGLE THREAD
+    ***************************************/
+
+   // push links behind the dummy
+   void test_push_one()
+   {  // setup
+      Queue q;
+      // exercise
+      q.push(99);
+      // verify
+      assertUnit(!q.empty());
+      assertUnit(q.pHead->pNext.load() == q.pTail.load());
+      assertUnit(q.pTail.load()->data == 99);
+   }  // teardown
+
+   // nothing to pop
+   void test_pop_empty()
+   {  // setup
+      Queue q;
+      int value = 99;
+      // exercise
+      bool popped = q.try_pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == 99);
+   }  // teardown
+
+   // items come out in the order they went in
+   void test_pop_fifo()
+   {  // setup
+      Queue q;
+      q.push(11);
+      q.push(26);
+      q.push(31);
+      int a = 0, b = 0, c = 0, d = 0;
+      // exercise
+      bool popped = q.try_pop(a) && q.try_pop(b) && q.try_pop(c);
+      // verify
+      assertUnit(popped);
+      assertUnit(a == 11);
+      assertUnit(b == 26);
+      assertUnit(c == 31);
+      assertUnit(q.try_pop(d) == false);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // a popped node goes on the free stack and the next push reuses it
+   void test_pop_recycles()
+   {  // setup
+      Queue::Cache& c = Queue::cache();   // start this thread with no spare nodes
+      while (c.pHead)
+      {
+         Queue::Node* p = c.pHead;
+         c.pHead = p->pNext.load();
+         delete p;
+      }
+      Queue q;
+      Queue::Node* pDummy = q.pHead;
+      q.push(11);
+      int value = 0;
+      // exercise
+      q.try_pop(value);
+      // verify
+      assertUnit(q.pFree.load() == pDummy);
+      q.push(26);
+      assertUnit(q.pTail.load() == pDummy);
+      assertUnit(q.pFree.load() == nullptr);
+   }  // teardown
+
+   // drain an empty queue
+   void test_drain_empty()
+   {  // setup
+      Queue q;
+      custom::list<int> l;
+      // exercise
+      size_t num = q.drain_into(l);
+      // verify
+      assertUnit(num == 0);
+      assertUnit(l.empty());
+      assertUnit(q.empty());
+   }  // teardown
+
+   // drain everything onto the end of a list
+   void test_drain_standard()
+   {  // setup
+      Queue q;
+      q.push(26);
+      q.push(31);
+      custom::list<int> l{ 11 };
+      // exercise
+      size_t num = q.drain_into(l);
+      // verify
+      assertUnit(num == 2);
+      assertUnit(l.size() == 3);
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 31);
+      assertUnit(q.empty());
+      assertUnit(q.pTail.load() == q.pHead);
+   }  // teardown
+
+   // the queue keeps working after a drain
+   void test_drain_thenPush()
+   {  // setup
+      Queue q;
+      q.push(11);
+      custom::list<int> l;
+      q.drain_into(l);
+      // exercise
+      q.push(26);
+      int value = 0;
+      bool popped = q.try_pop(value);
+      // verify
+      assertUnit(popped);
+      assertUnit(value == 26);
+      assertUnit(q.empty());
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // each producer's items arrive in order and none are lost
+   void test_producers_tryPop()
+   {  // setup
+      const int numProducers = 4;
+      const int numEach = 20000;
+      Queue q;
+      std::vector<std::thread> producers;
+      std::vector<int> next(numProducers, 0);
+      bool inOrder = true;
+      // exercise
+      for (int t = 0; t < numProducers; t++)
+         producers.push_back(std::thread([&q, t, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               q.push(t * numEach + i);
+         }));
+      int received = 0;
+      while (received < numProducers * numEach)
+      {
+         int value;
+         if (q.try_pop(value))
+         {
+            int t = value / numEach;
+            inOrder = inOrder && (value % numEach == next[t]);
+            next[t]++;
+            received++;
+         }
+      }
+      for (auto& th : producers)
+         th.join();
+      // verify
+      assertUnit(inOrder);
+      assertUnit(q.empty());
+   }  // teardown
+
+   // draining while producers are still pushing loses nothing
+   void test_producers_drain()
+   {  // setup
+      const int numProducers = 4;
+      const int numEach = 20000;
+      Queue q;
+      std::vector<std::thread> producers;
+      custom::list<int> l;
+      // exercise
+      for (int t = 0; t < numProducers; t++)
+         producers.push_back(std::thread([&q, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               q.push(1);
+         }));
+      while (l.size() < size_t(numProducers * numEach))
+         q.drain_into(l);
+      for (auto& th : producers)
+         th.join();
+      // verify
+      assertUnit(l.size() == size_t(numProducers * numEach));
+      assertUnit(q.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
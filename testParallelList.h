@@ -0,0 +1,323 @@
+/***********************************************************************
+ * Header:
+ *    TEST PARALLEL LIST
+ * Summary:
+ *    Unit tests for the parallel list algorithms and list_checkpoints
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "parallelList.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+class TestParallelList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Split points
+      test_splitPoints_empty();
+      test_splitPoints_even();
+      test_splitPoints_moreChunksThanItems();
+      test_checkpoints_construct();
+      test_checkpoints_splitPoints();
+      test_checkpoints_stale();
+      test_checkpoints_forEachPrefetch();
+      test_checkpoints_forEachPrefetchShort();
+
+      // Algorithms
+      test_forEach_visitsAll();
+      test_forEach_checkpoints();
+      test_transformInplace();
+      test_transformReduce_sum();
+      test_transformReduce_order();
+      test_transformReduce_empty();
+      test_parallelCopy();
+      test_parallelCopy_checkpoints();
+
+      report("ParallelList");
+   }
+
+   typedef custom::list<int>::iterator iterator;
+
+   // 1, 2, ..., num
+   static custom::list<int> counting(int num)
+   {
+      custom::list<int> l;
+      for (int i = 1; i <= num; i++)
+         l.push_back(i);
+      return l;
+   }
+
+   // how many nodes lie between two iterators
+   static size_t distance(iterator first, iterator last)
+   {
+      size_t num = 0;
+      for (; first != last; ++first)
+         num++;
+      return num;
+   }
+
+   /***************************************
+    * SPLIT POINTS
+    ***************************************/
+
+   // an empty list has no chunks at all
+   void test_splitPoints_empty()
+   {  // setup
+      custom::list<int> l;
+      // exercise
+      std::vector<iterator> bounds = custom::split_points(l, 4);
+      // verify
+      assertUnit(bounds.empty());
+   }  // teardown
+
+   // ten items in four chunks gives 3, 3, 2, 2
+   void test_splitPoints_even()
+   {  // setup
+      custom::list<int> l = counting(10);
+      // exercise
+      std::vector<iterator> bounds = custom::split_points(l, 4);
+      // verify
+      assertUnit(bounds.size() == 5);
+      assertUnit(bounds.front() == l.begin());
+      assertUnit(bounds.back() == l.end());
+      assertUnit(distance(bounds[0], bounds[1]) == 3);
+      assertUnit(distance(bounds[1], bounds[2]) == 3);
+      assertUnit(distance(bounds[2], bounds[3]) == 2);
+      assertUnit(distance(bounds[3], bounds[4]) == 2);
+      assertUnit(*bounds[2] == 7);
+   }  // teardown
+
+   // never an empty chunk
+   void test_splitPoints_moreChunksThanItems()
+   {  // setup
+      custom::list<int> l = counting(3);
+      // exercise
+      std::vector<iterator> bounds = custom::split_points(l, 16);
+      // verify
+      assertUnit(bounds.size() == 4);
+      assertUnit(*bounds[0] == 1);
+      assertUnit(*bounds[1] == 2);
+      assertUnit(*bounds[2] == 3);
+      assertUnit(bounds[3] == l.end());
+   }  // teardown
+
+   // one checkpoint at every stride-th node
+   void test_checkpoints_construct()
+   {  // setup
+      custom::list<int> l = counting(10);
+      // exercise
+      custom::list_checkpoints<int> cp(l, 4);
+      // verify
+      assertUnit(cp.size() == 3);
+      assertUnit(cp.get_stride() == 4);
+      assertUnit(*cp.checkpoints[0] == 1);
+      assertUnit(*cp.checkpoints[1] == 5);
+      assertUnit(*cp.checkpoints[2] == 9);
+      assertUnit(!cp.stale());
+   }  // teardown
+
+   // chunks are made of whole strides
+   void test_checkpoints_splitPoints()
+   {  // setup
+      custom::list<int> l = counting(10);
+      custom::list_checkpoints<int> cp(l, 2);
+      // exercise
+      std::vector<iterator> bounds = cp.split_points(2);
+      // verify
+      assertUnit(bounds.size() == 3);
+      assertUnit(*bounds[0] == 1);
+      assertUnit(*bounds[1] == 7);
+      assertUnit(bounds[2] == l.end());
+   }  // teardown
+
+   // changing the list makes the checkpoints stale until refreshed
+   void test_checkpoints_stale()
+   {  // setup
+      custom::list<int> l = counting(10);
+      custom::list_checkpoints<int> cp(l, 4);
+      // exercise
+      l.push_front(0);
+      bool stale = cp.stale();
+      cp.refresh();
+      // verify
+      assertUnit(stale);
+      assertUnit(!cp.stale());
+      assertUnit(*cp.checkpoints[1] == 4);
+   }  // teardown
+
+   // the prefetching walk visits every item once, in order, over
+   // whole groups, a partial group, and a partial last segment
+   void test_checkpoints_forEachPrefetch()
+   {  // setup
+      custom::list<int> l = counting(1003);
+      custom::list_checkpoints<int> cp(l, 10);
+      std::vector<int> seen;
+      // exercise
+      cp.for_each_prefetch([&seen](int& x) { seen.push_back(x); x = -x; }, 3);
+      // verify
+      assertUnit(seen.size() == 1003);
+      bool inOrder = true;
+      for (size_t i = 0; i < seen.size(); i++)
+         inOrder = inOrder && seen[i] == int(i + 1);
+      assertUnit(inOrder);
+      assertUnit(l.front() == -1);
+      assertUnit(l.back() == -1003);
+   }  // teardown
+
+   // no scouts, one segment, or nothing at all is a plain walk
+   void test_checkpoints_forEachPrefetchShort()
+   {  // setup
+      custom::list<int> l = counting(5);
+      custom::list<int> lEmpty;
+      custom::list_checkpoints<int> cpOne(l, 100);
+      custom::list_checkpoints<int> cpMany(l, 1);
+      custom::list_checkpoints<int> cpEmpty(lEmpty, 4);
+      int sumOne = 0;
+      int sumNone = 0;
+      int numEmpty = 0;
+      // exercise
+      cpOne.for_each_prefetch([&sumOne](int& x) { sumOne += x; });
+      cpMany.for_each_prefetch([&sumNone](int& x) { sumNone += x; }, 0);
+      cpEmpty.for_each_prefetch([&numEmpty](int&) { numEmpty++; });
+      // verify
+      assertUnit(sumOne == 15);
+      assertUnit(sumNone == 15);
+      assertUnit(numEmpty == 0);
+   }  // teardown
+
+   /***************************************
+    * ALGORITHMS
+    ***************************************/
+
+   // every item is visited exactly once
+   void test_forEach_visitsAll()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(10000);
+      std::atomic<long long> sum(0);
+      std::atomic<int> count(0);
+      // exercise
+      custom::for_each(pool, l, [&sum, &count](int& x) { sum += x; count++; });
+      // verify
+      assertUnit(count == 10000);
+      assertUnit(sum == 10000LL * 10001 / 2);
+   }  // teardown
+
+   // same again, split from checkpoints
+   void test_forEach_checkpoints()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(10000);
+      custom::list_checkpoints<int> cp(l, 100);
+      std::atomic<long long> sum(0);
+      // exercise
+      custom::for_each(pool, cp, [&sum](int& x) { sum += x; });
+      custom::for_each(pool, cp, [&sum](int& x) { sum += x; });
+      // verify
+      assertUnit(sum == 2 * (10000LL * 10001 / 2));
+   }  // teardown
+
+   // every item is replaced, in place
+   void test_transformInplace()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(1000);
+      // exercise
+      custom::transform_inplace(pool, l, [](int x) { return x * 2; });
+      // verify
+      bool doubled = l.size() == 1000;
+      int expect = 2;
+      for (iterator it = l.begin(); it != l.end(); ++it, expect += 2)
+         doubled = doubled && *it == expect;
+      assertUnit(doubled);
+   }  // teardown
+
+   // add up the squares
+   void test_transformReduce_sum()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(1000);
+      // exercise
+      long long sum = custom::transform_reduce(pool, l, 7LL,
+         [](long long a, long long b) { return a + b; },
+         [](int x) { return (long long)x * x; });
+      // verify
+      assertUnit(sum == 7 + 1000LL * 1001 * 2001 / 6);
+   }  // teardown
+
+   // the chunks are combined in list order
+   void test_transformReduce_order()
+   {  // setup
+      custom::work_stealing_pool pool(3);
+      custom::list<int> l = counting(26);
+      custom::list_checkpoints<int> cp(l, 3);
+      // exercise
+      std::string s = custom::transform_reduce(pool, cp, std::string(">"),
+         [](const std::string& a, const std::string& b) { return a + b; },
+         [](int x) { return std::string(1, char('a' + x - 1)); });
+      // verify
+      assertUnit(s == ">abcdefghijklmnopqrstuvwxyz");
+   }  // teardown
+
+   // nothing to reduce gives back the starting value
+   void test_transformReduce_empty()
+   {  // setup
+      custom::work_stealing_pool pool(2);
+      custom::list<int> l;
+      // exercise
+      int result = custom::transform_reduce(pool, l, 99,
+         [](int a, int b) { return a + b; },
+         [](int x) { return x; });
+      // verify
+      assertUnit(result == 99);
+   }  // teardown
+
+   // a deep copy in the same order, leaving the source alone
+   void test_parallelCopy()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(5000);
+      // exercise
+      custom::list<int> copy = custom::parallel_copy(pool, l);
+      // verify
+      assertUnit(copy.size() == 5000);
+      assertUnit(l.size() == 5000);
+      bool same = true;
+      iterator itCopy = copy.begin();
+      for (iterator it = l.begin(); it != l.end(); ++it, ++itCopy)
+         same = same && *it == *itCopy && &*it != &*itCopy;
+      assertUnit(same);
+      assertUnit(*copy.rbegin() == 5000);
+   }  // teardown
+
+   // the copy from checkpoints is just as good
+   void test_parallelCopy_checkpoints()
+   {  // setup
+      custom::work_stealing_pool pool(4);
+      custom::list<int> l = counting(1000);
+      custom::list_checkpoints<int> cp(l, 64);
+      // exercise
+      custom::list<int> copy = custom::parallel_copy(pool, cp);
+      // verify
+      assertUnit(copy.size() == 1000);
+      int expect = 1;
+      bool inOrder = true;
+      for (iterator it = copy.begin(); it != copy.end(); ++it, ++expect)
+         inOrder = inOrder && *it == expect;
+      assertUnit(inOrder);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,392 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT LIST
+ * Summary:
+ *    Unit tests for persistent_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "persistentList.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestPersistentList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructInit_standard();
+      test_constructCopy_snapshot();
+
+      // New versions
+      test_pushfront_sharesTail();
+      test_popfront_sharesTail();
+      test_popfront_empty();
+      test_insert_middle();
+      test_insert_end();
+      test_erase_front();
+      test_erase_middle();
+      test_insert_throwReleasesPrefix();
+
+      // Lifetime
+      test_release_lastVersion();
+      test_release_longChain();
+      test_snapshot_concurrentReaders();
+
+      // Atomic version
+      test_atomic_loadStore();
+      test_atomic_compareExchange();
+
+      // Access
+      test_front_empty();
+
+      report("PersistentList");
+   }
+
+   typedef custom::persistent_list<int> List;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // exercise
+      List l;
+      // verify
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.numElements == 0);
+   }  // teardown
+
+   // use the initialization list to create the standard fixture
+   void test_constructInit_standard()
+   {  // exercise
+      List l{ 11, 26, 31 };
+      // verify
+      assertStandardFixture(l);
+      assertUnit(l.pHead->refs == 1);
+   }  // teardown
+
+   // a snapshot is the same chain with one more reference
+   void test_constructCopy_snapshot()
+   {  // setup
+      List lSrc{ 11, 26, 31 };
+      // exercise
+      List lSnap(lSrc);
+      // verify
+      assertUnit(lSnap.pHead == lSrc.pHead);
+      assertUnit(lSrc.pHead->refs == 2);
+      assertUnit(lSrc.pHead->pNext->refs == 1);
+      assertStandardFixture(lSnap);
+   }  // teardown
+
+   /***************************************
+    * NEW VERSIONS
+    ***************************************/
+
+   // push_front shares every old node
+   void test_pushfront_sharesTail()
+   {  // setup
+      List lOld{ 26, 31 };
+      // exercise
+      List lNew = lOld.push_front(11);
+      // verify
+      assertUnit(lNew.pHead->pNext == lOld.pHead);
+      assertUnit(lOld.pHead->refs == 2);
+      assertStandardFixture(lNew);
+      assertUnit(lOld.size() == 2);
+      assertUnit(lOld.front() == 26);
+   }  // teardown
+
+   // pop_front shares every remaining node
+   void test_popfront_sharesTail()
+   {  // setup
+      List lOld{ 99, 11, 26, 31 };
+      // exercise
+      List lNew = lOld.pop_front();
+      // verify
+      assertUnit(lNew.pHead == lOld.pHead->pNext);
+      assertStandardFixture(lNew);
+      assertUnit(lOld.size() == 4);
+   }  // teardown
+
+   // pop_front of nothing is nothing
+   void test_popfront_empty()
+   {  // setup
+      List lOld;
+      // exercise
+      List lNew = lOld.pop_front();
+      // verify
+      assertUnit(lNew.empty());
+      assertUnit(lNew.pHead == nullptr);
+   }  // teardown
+
+   // insert copies the prefix and shares the rest
+   void test_insert_middle()
+   {  // setup
+      List lOld{ 11, 31 };
+      List::const_iterator it = lOld.begin();
+      ++it;
+      // exercise
+      List lNew = lOld.insert(it, 26);
+      // verify
+      assertStandardFixture(lNew);
+      assertUnit(lNew.pHead != lOld.pHead);
+      assertUnit(lNew.pHead->pNext->pNext == lOld.pHead->pNext);
+      assertUnit(lOld.size() == 2);
+   }  // teardown
+
+   // insert at end() copies everything
+   void test_insert_end()
+   {  // setup
+      List lOld{ 11, 26 };
+      // exercise
+      List lNew = lOld.insert(lOld.end(), 31);
+      // verify
+      assertStandardFixture(lNew);
+      assertUnit(lOld.size() == 2);
+   }  // teardown
+
+   // erase the front is a pop_front
+   void test_erase_front()
+   {  // setup
+      List lOld{ 99, 11, 26, 31 };
+      // exercise
+      List lNew = lOld.erase(lOld.begin());
+      // verify
+      assertUnit(lNew.pHead == lOld.pHead->pNext);
+      assertStandardFixture(lNew);
+   }  // teardown
+
+   // erase in the middle copies the prefix and shares the rest
+   void test_erase_middle()
+   {  // setup
+      List lOld{ 11, 99, 26, 31 };
+      List::const_iterator it = lOld.begin();
+      ++it;
+      // exercise
+      List lNew = lOld.erase(it);
+      // verify
+      assertStandardFixture(lNew);
+      assertUnit(lNew.pHead->pNext == lOld.pHead->pNext->pNext);
+      assertUnit(lOld.size() == 4);
+   }  // teardown
+
+   // an item whose copies throw on cue, counting how many are alive
+   struct Fragile
+   {
+      Fragile(int value) : value(value) { live()++; }
+      Fragile(const Fragile& rhs) : value(rhs.value)
+      {
+         if (copiesLeft()-- == 0)
+            throw "ERROR: copy failed";
+         live()++;
+      }
+      ~Fragile() { live()--; }
+      static int& live() { static int num = 0; return num; }
+      static int& copiesLeft() { static int num = -1; return num; }
+      int value;
+   };
+
+   // when copying the prefix throws, what was built is freed
+   void test_insert_throwReleasesPrefix()
+   {  // setup
+      int liveBefore = Fragile::live();
+      {
+         custom::persistent_list<Fragile> lOld{ Fragile(11), Fragile(26), Fragile(31) };
+         custom::persistent_list<Fragile>::const_iterator it = lOld.begin();
+         ++it;
+         ++it;
+         int liveOld = Fragile::live();
+         Fragile::copiesLeft() = 2;  // the new item and one of the prefix
+         // exercise
+         bool thrown = false;
+         try
+         {
+            lOld.insert(it, Fragile(99));
+         }
+         catch (const char*)
+         {
+            thrown = true;
+         }
+         Fragile::copiesLeft() = -1;
+         // verify
+         assertUnit(thrown);
+         assertUnit(Fragile::live() == liveOld);
+         assertUnit(lOld.pHead->refs == 1);
+         assertUnit(lOld.pHead->pNext->pNext->refs == 1);
+         assertUnit(lOld.size() == 3);
+      }  // teardown
+      assertUnit(Fragile::live() == liveBefore);
+   }
+
+   /***************************************
+    * LIFETIME
+    ***************************************/
+
+   // dropping the newest version only frees the unshared node
+   void test_release_lastVersion()
+   {  // setup
+      List lOld{ 26, 31 };
+      {
+         List lNew = lOld.push_front(11);
+         assertUnit(lOld.pHead->refs == 2);
+      } // exercise
+      // verify
+      assertUnit(lOld.pHead->refs == 1);
+      assertUnit(lOld.front() == 26);
+   }  // teardown
+
+   // freeing a long chain does not recurse
+   void test_release_longChain()
+   {  // setup
+      List l;
+      for (int i = 0; i < 200000; i++)
+         l = l.push_front(i);
+      // exercise
+      l = List();
+      // verify
+      assertUnit(l.empty());
+   }  // teardown
+
+   // readers take snapshots on their own threads while a writer keeps
+   // publishing versions.  Every snapshot is whole: 11, 26, 31 with
+   // maybe a 0 in front
+   void test_snapshot_concurrentReaders()
+   {  // setup
+      const List base{ 11, 26, 31 };
+      custom::atomic_persistent_list<int> current(base);
+      std::atomic<bool> done(false);
+      std::vector<std::thread> readers;
+      std::vector<int> numBad(4, 0);
+      std::vector<int> numRead(4, 0);
+      // exercise
+      for (int r = 0; r < 4; r++)
+         readers.push_back(std::thread([&current, &done, &numBad, &numRead, r]()
+         {
+            while (!done.load() || numRead[r] < 100)
+            {
+               List snap = current.load();
+               int sum = 0;
+               size_t num = 0;
+               for (List::const_iterator it = snap.begin(); it != snap.end(); ++it, num++)
+                  sum += *it;
+               if (sum != 11 + 26 + 31 || num != snap.size() || num < 3 || num > 4)
+                  numBad[r]++;
+               numRead[r]++;
+            }
+         }));
+      for (int i = 0; i < 10000; i++)
+         current.store(i % 2 ? base : base.push_front(0));
+      done = true;
+      for (auto& t : readers)
+         t.join();
+      // verify
+      for (int r = 0; r < 4; r++)
+         assertUnit(numBad[r] == 0);
+      assertUnit(current.load().pHead == base.pHead);
+   }  // teardown
+
+   /***************************************
+    * ATOMIC VERSION
+    ***************************************/
+
+   // a stored version is what the next load sees, sharing its nodes
+   void test_atomic_loadStore()
+   {  // setup
+      List l{ 11, 26, 31 };
+      custom::atomic_persistent_list<int> current;
+      bool emptyFirst = current.load().empty();
+      // exercise
+      current.store(l);
+      List snap = current.load();
+      List old = current.exchange(List());
+      // verify
+      assertUnit(emptyFirst);
+      assertUnit(snap.pHead == l.pHead);
+      assertStandardFixture(snap);
+      assertUnit(old.pHead == l.pHead);
+      assertUnit(current.load().empty());
+   }  // teardown
+
+   // only the version we expected is replaced; otherwise we learn the real one
+   void test_atomic_compareExchange()
+   {  // setup
+      List l{ 11, 26, 31 };
+      custom::atomic_persistent_list<int> current(l.pop_front());
+      List expected = l;
+      // exercise
+      bool first = current.compare_exchange_strong(expected, List());
+      bool second = current.compare_exchange_strong(expected, l);
+      // verify
+      assertUnit(!first);
+      assertUnit(expected.pHead == l.pHead->pNext);
+      assertUnit(second);
+      assertUnit(current.load().pHead == l.pHead);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // attempt to access the front of an empty list
+   void test_front_empty()
+   {  // setup
+      List l;
+      // exercise
+      try
+      {
+         l.front();
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: unable to access data from an empty list") ==
+                    std::string(sError));
+      }
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *        pHead
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.numElements == 3);
+      assertIndirect(l.pHead != nullptr);
+      if (l.pHead)
+      {
+         assertIndirect(l.pHead->data == 11);
+         assertIndirect(l.pHead->pNext != nullptr);
+         if (l.pHead->pNext)
+         {
+            assertIndirect(l.pHead->pNext->data == 26);
+            assertIndirect(l.pHead->pNext->pNext != nullptr);
+            if (l.pHead->pNext->pNext)
+            {
+               assertIndirect(l.pHead->pNext->pNext->data == 31);
+               assertIndirect(l.pHead->pNext->pNext->pNext == nullptr);
+            }
+         }
+      }
+   }
+};
+
+#endif // DEBUG
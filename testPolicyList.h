@@ -0,0 +1,502 @@
+/***********************************************************************
+ * Header:
+ *    TEST POLICY LIST
+ * Summary:
+ *    Unit tests for policy_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "policyList.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class TestPolicyList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Policies
+      test_select_defaults();
+      test_select_anyOrder();
+      test_sizeof_lean();
+      test_sizeof_default();
+      test_sizeof_node();
+
+      // Construct
+      test_construct_default();
+      test_construct_copy();
+      test_assign_copy();
+      test_assign_countAndTail();
+      test_assign_throwLeavesTarget();
+      test_construct_move();
+      test_assign_move();
+
+      // Insert and remove
+      test_pushBack_noTail();
+      test_popBack_singleLinks();
+      test_popBack_doubleLinks();
+      test_size_uncounted();
+      test_removeIf_tail();
+      test_insert_middleAndEnd();
+      test_insert_singleLinks();
+      test_erase_middleAndLast();
+      test_erase_singleLinks();
+
+      // Access
+      test_front_checkedEmpty();
+
+      // Lock
+      test_mutexLock_threads();
+      test_spinLock_threads();
+
+      report("PolicyList");
+   }
+
+   typedef custom::policy_list<int, custom::policy::uncounted_size, custom::policy::no_tail,
+                               custom::policy::single_links, custom::policy::unchecked> Lean;
+
+   // the items, front to back
+   template <class List>
+   static std::vector<int> items(List& l)
+   {
+      std::vector<int> v;
+      for (typename List::iterator it = l.begin(); it != l.end(); ++it)
+         v.push_back(*it);
+      return v;
+   }
+
+   /***************************************
+    * POLICIES
+    ***************************************/
+
+   // with nothing said, behave like custom::list
+   void test_select_defaults()
+   {  // exercise
+      typedef custom::policy_traits<int> traits;
+      // verify
+      assertUnit((std::is_same<traits::size_policy, custom::policy::counted_size>::value));
+      assertUnit((std::is_same<traits::tail_policy, custom::policy::with_tail>::value));
+      assertUnit((std::is_same<traits::link_policy, custom::policy::double_links>::value));
+      assertUnit((std::is_same<traits::lock_policy, custom::policy::no_lock>::value));
+      assertUnit((std::is_same<traits::access_policy, custom::policy::checked>::value));
+   }  // teardown
+
+   // the order the policies are listed in does not matter
+   void test_select_anyOrder()
+   {  // exercise
+      typedef custom::policy_traits<int, custom::policy::spin_lock, custom::policy::no_tail> a;
+      typedef custom::policy_traits<int, custom::policy::no_tail, custom::policy::spin_lock> b;
+      // verify
+      assertUnit((std::is_same<a::lock_policy, b::lock_policy>::value));
+      assertUnit((std::is_same<a::tail_policy, b::tail_policy>::value));
+      assertUnit((std::is_same<a::lock_policy, custom::policy::spin_lock>::value));
+      assertUnit((std::is_same<a::size_policy, custom::policy::counted_size>::value));
+   }  // teardown
+
+   // policies that keep nothing take no room
+   void test_sizeof_lean()
+   {  // verify
+      assertUnit(sizeof(Lean) == sizeof(void*));
+   }  // teardown
+
+   // the head, the tail pointer, and the count
+   void test_sizeof_default()
+   {  // verify
+      assertUnit(sizeof(custom::policy_list<int>) == 2 * sizeof(void*) + sizeof(size_t));
+   }  // teardown
+
+   // single links drop pPrev from every node
+   void test_sizeof_node()
+   {  // exercise
+      size_t single = sizeof(Lean::Node);
+      size_t doubly = sizeof(custom::policy_list<int>::Node);
+      // verify
+      assertUnit(single + sizeof(void*) == doubly);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing there
+   void test_construct_default()
+   {  // exercise
+      custom::policy_list<int> l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   // a deep copy, with a lock of its own
+   void test_construct_copy()
+   {  // setup
+      custom::policy_list<int, custom::policy::mutex_lock> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // exercise
+      custom::policy_list<int, custom::policy::mutex_lock> copy(l);
+      // verify
+      assertUnit(items(copy) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(copy.size() == 3);
+      assertUnit(copy.pHead != l.pHead);
+      assertUnit(copy.back() == 31);
+   }  // teardown
+
+   // assignment replaces what was there
+   void test_assign_copy()
+   {  // setup
+      Lean l;
+      l.push_back(11);
+      l.push_back(26);
+      Lean lhs;
+      lhs.push_back(99);
+      // exercise
+      lhs = l;
+      // verify
+      assertUnit(items(lhs) == std::vector<int>({ 11, 26 }));
+      assertUnit(items(l) == std::vector<int>({ 11, 26 }));
+   }  // teardown
+
+   // the count and the tail come over with the nodes
+   void test_assign_countAndTail()
+   {  // setup
+      custom::policy_list<int, custom::policy::mutex_lock> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      custom::policy_list<int, custom::policy::mutex_lock> lhs;
+      lhs.push_back(99);
+      // exercise
+      lhs = l;
+      lhs.push_back(42);
+      // verify
+      assertUnit(items(lhs) == std::vector<int>({ 11, 26, 31, 42 }));
+      assertUnit(lhs.size() == 4);
+      assertUnit(lhs.back() == 42);
+      assertUnit(l.size() == 3);
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // throws once copiesLeft() runs out
+   struct Fragile
+   {
+      Fragile(int value) : value(value) {}
+      Fragile(const Fragile& rhs) : value(rhs.value)
+      {
+         if (copiesLeft()-- == 0)
+            throw "ERROR: copy failed";
+      }
+      static int& copiesLeft() { static int num = -1; return num; }
+      int value;
+   };
+
+   // a copy that fails part way leaves the target as it was
+   void test_assign_throwLeavesTarget()
+   {  // setup
+      custom::policy_list<Fragile> l;
+      l.push_back(Fragile(11));
+      l.push_back(Fragile(26));
+      custom::policy_list<Fragile> lhs;
+      lhs.push_back(Fragile(99));
+      Fragile::copiesLeft() = 1;
+      const char* error = nullptr;
+      // exercise
+      try
+      {
+         lhs = l;
+      }
+      catch (const char* e)
+      {
+         error = e;
+      }
+      // verify
+      assertUnit(error != nullptr);
+      assertUnit(lhs.size() == 1);
+      assertUnit(lhs.front().value == 99);
+      assertUnit(lhs.back().value == 99);
+      Fragile::copiesLeft() = -1;
+   }  // teardown
+
+   // a move takes the nodes, the count and the tail
+   void test_construct_move()
+   {  // setup
+      custom::policy_list<int, custom::policy::mutex_lock> l;
+      l.push_back(11);
+      l.push_back(26);
+      custom::policy_list<int, custom::policy::mutex_lock>::Node* pHead = l.pHead;
+      // exercise
+      custom::policy_list<int, custom::policy::mutex_lock> moved(std::move(l));
+      // verify
+      assertUnit(moved.pHead == pHead);
+      assertUnit(moved.size() == 2);
+      assertUnit(moved.back() == 26);
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      l.push_back(31);
+      assertUnit(items(l) == std::vector<int>({ 31 }));
+   }  // teardown
+
+   // move assignment replaces what was there
+   void test_assign_move()
+   {  // setup
+      custom::policy_list<int> l;
+      l.push_back(11);
+      l.push_back(26);
+      custom::policy_list<int> lhs;
+      lhs.push_back(99);
+      // exercise
+      lhs = std::move(l);
+      lhs.push_back(31);
+      // verify
+      assertUnit(items(lhs) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(lhs.size() == 3);
+      assertUnit(l.empty());
+   }  // teardown
+
+   /***************************************
+    * INSERT AND REMOVE
+    ***************************************/
+
+   // with no tail pointer, push_back walks to the end
+   void test_pushBack_noTail()
+   {  // setup
+      Lean l;
+      // exercise
+      l.push_back(26);
+      l.push_front(11);
+      l.push_back(31);
+      // verify
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.front() == 11);
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // with single links, pop_back finds the node before the tail
+   void test_popBack_singleLinks()
+   {  // setup
+      custom::policy_list<int, custom::policy::single_links> l;
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // exercise
+      l.pop_back();
+      l.pop_back();
+      l.push_back(42);
+      // verify
+      assertUnit(items(l) == std::vector<int>({ 11, 42 }));
+      assertUnit(l.back() == 42);
+      assertUnit(l.size() == 2);
+   }  // teardown
+
+   // with double links, the back pointers are kept up
+   void test_popBack_doubleLinks()
+   {  // setup
+      custom::policy_list<int> l;
+      l.push_back(26);
+      l.push_front(11);
+      l.push_back(31);
+      // exercise
+      l.pop_back();
+      l.pop_front();
+      // verify
+      assertUnit(items(l) == std::vector<int>({ 26 }));
+      assertUnit(l.pHead->pPrev == nullptr);
+      l.pop_back();
+      assertUnit(l.empty());
+      l.pop_back();
+      assertUnit(l.size() == 0);
+   }  // teardown
+
+   // an uncounted list still knows how big it is
+   void test_size_uncounted()
+   {  // setup
+      Lean l;
+      for (int i = 0; i < 10; i++)
+         l.push_front(i);
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      // verify
+      assertUnit(l.size() == 8);
+      l.clear();
+      assertUnit(l.size() == 0);
+   }  // teardown
+
+   // removing the last item moves the tail back
+   void test_removeIf_tail()
+   {  // setup
+      custom::policy_list<int> l;
+      for (int i = 1; i <= 6; i++)
+         l.push_back(i);
+      // exercise
+      size_t num = l.remove_if([](int x) { return x % 2 == 0; });
+      // verify
+      assertUnit(num == 3);
+      assertUnit(items(l) == std::vector<int>({ 1, 3, 5 }));
+      assertUnit(l.size() == 3);
+      assertUnit(l.back() == 5);
+      assertUnit(l.pHead->pNext->pPrev == l.pHead);
+      l.push_back(7);
+      assertUnit(items(l) == std::vector<int>({ 1, 3, 5, 7 }));
+   }  // teardown
+
+   // insert in the middle keeps the back links; at end() it moves the tail
+   void test_insert_middleAndEnd()
+   {  // setup
+      custom::policy_list<int> l;
+      l.push_back(11);
+      l.push_back(31);
+      custom::policy_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.insert(it, 26);
+      custom::policy_list<int>::iterator itEnd = l.insert(l.end(), 42);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(*itEnd == 42);
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31, 42 }));
+      assertUnit(l.size() == 4);
+      assertUnit(l.back() == 42);
+      assertUnit(l.pHead->pNext->pPrev == l.pHead);
+      assertUnit(l.pHead->pNext->pNext->pPrev == l.pHead->pNext);
+   }  // teardown
+
+   // with no back links or tail, insert walks to find its place
+   void test_insert_singleLinks()
+   {  // setup
+      Lean l;
+      // exercise
+      l.insert(l.end(), 31);
+      l.insert(l.begin(), 11);
+      Lean::iterator it = l.begin();
+      ++it;
+      l.insert(it, 26);
+      // verify
+      assertUnit(items(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.back() == 31);
+   }  // teardown
+
+   // erase hands back the next item, and the last moves the tail back
+   void test_erase_middleAndLast()
+   {  // setup
+      custom::policy_list<int> l;
+      for (int i = 1; i <= 4; i++)
+         l.push_back(i);
+      custom::policy_list<int>::iterator it = l.begin();
+      ++it;
+      // exercise
+      it = l.erase(it);
+      bool three = *it == 3;
+      ++it;
+      it = l.erase(it);
+      // verify
+      assertUnit(three);
+      assertUnit(it == l.end());
+      assertUnit(items(l) == std::vector<int>({ 1, 3 }));
+      assertUnit(l.size() == 2);
+      assertUnit(l.back() == 3);
+      assertUnit(l.pHead->pNext->pPrev == l.pHead);
+      l.push_back(5);
+      assertUnit(items(l) == std::vector<int>({ 1, 3, 5 }));
+   }  // teardown
+
+   // erasing the front of a lean list, and then everything
+   void test_erase_singleLinks()
+   {  // setup
+      Lean l;
+      l.push_back(11);
+      l.push_back(26);
+      // exercise
+      Lean::iterator it = l.erase(l.begin());
+      bool next = *it == 26;
+      it = l.erase(it);
+      // verify
+      assertUnit(next);
+      assertUnit(it == l.end());
+      assertUnit(l.empty());
+      assertUnit(l.erase(l.end()) == l.end());
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // checked access throws, just like list
+   void test_front_checkedEmpty()
+   {  // setup
+      custom::policy_list<int> l;
+      const char* error = nullptr;
+      // exercise
+      try
+      {
+         l.front();
+      }
+      catch (const char* e)
+      {
+         error = e;
+      }
+      // verify
+      assertUnit(error != nullptr);
+   }  // teardown
+
+   /***************************************
+    * LOCK
+    ***************************************/
+
+   template <class List>
+   static void pushFromThreads(List& l)
+   {
+      std::vector<std::thread> threads;
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&l, t]()
+         {
+            for (int i = 0; i < 1000; i++)
+               if (i % 2)
+                  l.push_back(t);
+               else
+                  l.push_front(t);
+         }));
+      for (size_t t = 0; t < threads.size(); t++)
+         threads[t].join();
+   }
+
+   // a mutex keeps four writers from losing anything
+   void test_mutexLock_threads()
+   {  // setup
+      custom::policy_list<int, custom::policy::mutex_lock> l;
+      // exercise
+      pushFromThreads(l);
+      // verify
+      assertUnit(l.size() == 4000);
+      size_t walked = 0;
+      l.for_each([&walked](int&) { walked++; });
+      assertUnit(walked == 4000);
+   }  // teardown
+
+   // so does a spin lock
+   void test_spinLock_threads()
+   {  // setup
+      custom::policy_list<int, custom::policy::spin_lock, custom::policy::single_links> l;
+      // exercise
+      pushFromThreads(l);
+      // verify
+      assertUnit(l.size() == 4000);
+      assertUnit(items(l).size() == 4000);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,285 @@
+/***********************************************************************
+ * Header:
+ *    TEST SHARDED LIST
+ * Summary:
+ *    Unit tests for sharded_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "shardedList.h"
+#include "unitTest.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#define assertStandardList(x) assertStandardListParameters(x, __LINE__, __FUNCTION__)
+
+class TestShardedList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_zeroShards();
+      test_shard_layout();
+
+      // Single thread
+      test_pushBack_sameShard();
+      test_pushBackTo_keyPicksShard();
+      test_collect_empty();
+      test_collect_standard();
+      test_collect_spliceNodes();
+      test_collect_shardOrder();
+      test_collectCompare_merge();
+      test_collectCompare_ties();
+
+      // Many threads
+      test_pushBack_manyThreads();
+      test_collectCompare_manyThreads();
+
+      report("ShardedList");
+   }
+
+   typedef custom::sharded_list<int> List;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // at least one shard, and nothing in any
+   void test_construct_default()
+   {  // exercise
+      List l;
+      // verify
+      assertUnit(l.shards() >= 1);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // there is always somewhere to push
+   void test_construct_zeroShards()
+   {  // exercise
+      List l(0);
+      // verify
+      assertUnit(l.shards() == 1);
+   }  // teardown
+
+   // a cache line of padding separates one shard's list from the next lock
+   void test_shard_layout()
+   {  // setup
+      List l(2);
+      // exercise
+      const char* pEnd0 = reinterpret_cast<const char*>(&l.vShards[0].data + 1);
+      const char* pLock1 = reinterpret_cast<const char*>(&l.vShards[1].lock);
+      // verify
+      assertUnit(pLock1 - pEnd0 >= 64);
+   }  // teardown
+
+   /***************************************
+    * SINGLE THREAD
+    ***************************************/
+
+   // a key always lands in the same shard, whoever pushes it
+   void test_pushBackTo_keyPicksShard()
+   {  // setup
+      List l(3);
+      // exercise
+      l.push_back_to(1, 11);
+      l.push_back_to(4, 26);
+      l.push_back_to(2, 31);
+      // verify
+      assertUnit(l.vShards[0].data.empty());
+      assertUnit(l.vShards[1].data.size() == 2);
+      assertUnit(l.vShards[1].data.back() == 26);
+      assertUnit(l.vShards[2].data.front() == 31);
+   }  // teardown
+
+   // one thread always lands in the same shard
+   void test_pushBack_sameShard()
+   {  // setup
+      List l(4);
+      // exercise
+      l.push_back(11);
+      l.push_back(26);
+      // verify
+      assertUnit(l.vShards[l.shard()].data.size() == 2);
+      assertUnit(l.size() == 2);
+   }  // teardown
+
+   // nothing to collect
+   void test_collect_empty()
+   {  // setup
+      List l(4);
+      // exercise
+      custom::list<int> lCollected = l.collect();
+      // verify
+      assertUnit(lCollected.empty());
+   }  // teardown
+
+   // collect what one thread pushed, in order
+   void test_collect_standard()
+   {  // setup
+      List l(4);
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      // exercise
+      custom::list<int> lCollected = l.collect();
+      // verify
+      assertStandardList(lCollected);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // collecting moves the shard's nodes rather than copying them
+   void test_collect_spliceNodes()
+   {  // setup
+      List l(1);
+      l.push_back(11);
+      l.push_back(26);
+      l.push_back(31);
+      int* pFirst = &l.vShards[0].data.front();
+      // exercise
+      custom::list<int> lCollected = l.collect();
+      // verify
+      assertUnit(&lCollected.front() == pFirst);
+   }  // teardown
+
+   // shards come back lowest first
+   void test_collect_shardOrder()
+   {  // setup
+      List l(3);
+      l.vShards[2].data.push_back(31);
+      l.vShards[0].data.push_back(11);
+      l.vShards[1].data.push_back(26);
+      // exercise
+      custom::list<int> lCollected = l.collect();
+      // verify
+      assertStandardList(lCollected);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // sorted shards merge into one sorted list
+   void test_collectCompare_merge()
+   {  // setup
+      List l(3);
+      l.vShards[0].data.push_back(26);
+      l.vShards[1].data.push_back(11);
+      l.vShards[1].data.push_back(31);
+      // exercise
+      custom::list<int> lCollected = l.collect([](int lhs, int rhs) { return lhs < rhs; });
+      // verify
+      assertStandardList(lCollected);
+      assertUnit(l.empty());
+   }  // teardown
+
+   // equal keys come out in shard order
+   void test_collectCompare_ties()
+   {  // setup
+      typedef std::pair<int, int> Item;   // (key, shard)
+      custom::sharded_list<Item> l(5);
+      for (int s = 4; s >= 0; s--)
+         l.vShards[s].data.push_back(Item(7, s));
+      // exercise
+      custom::list<Item> lCollected = l.collect([](const Item& lhs, const Item& rhs)
+      {
+         return lhs.first < rhs.first;
+      });
+      // verify
+      int expected = 0;
+      bool inOrder = true;
+      for (custom::list<Item>::iterator it = lCollected.begin(); it != lCollected.end(); ++it)
+         inOrder = inOrder && (*it).second == expected++;
+      assertUnit(inOrder);
+      assertUnit(expected == 5);
+   }  // teardown
+
+   /***************************************
+    * MANY THREADS
+    ***************************************/
+
+   // nothing pushed is lost, and each thread's items keep their order
+   void test_pushBack_manyThreads()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 10000;
+      List l(numThreads);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back(t * numEach + i);
+         }));
+      for (auto& th : threads)
+         th.join();
+      custom::list<int> lCollected = l.collect();
+      // verify
+      assertUnit(lCollected.size() == size_t(numThreads * numEach));
+      std::vector<int> next(numThreads, 0);
+      bool inOrder = true;
+      for (custom::list<int>::iterator it = lCollected.begin(); it != lCollected.end(); ++it)
+      {
+         int t = *it / numEach;
+         inOrder = inOrder && (*it % numEach == next[t]);
+         next[t]++;
+      }
+      assertUnit(inOrder);
+   }  // teardown
+
+   // threads pushing rising keys merge into one sorted list.  Each
+   // thread keys its pushes by its own number, so each has a shard
+   void test_collectCompare_manyThreads()
+   {  // setup
+      const int numThreads = 4;
+      const int numEach = 5000;
+      List l(numThreads);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&l, t, numThreads, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               l.push_back_to(t, i * numThreads + t);
+         }));
+      for (auto& th : threads)
+         th.join();
+      custom::list<int> lCollected = l.collect([](int lhs, int rhs) { return lhs < rhs; });
+      // verify
+      int expected = 0;
+      bool sorted = true;
+      for (custom::list<int>::iterator it = lCollected.begin(); it != lCollected.end(); ++it)
+         sorted = sorted && *it == expected++;
+      assertUnit(sorted);
+      assertUnit(expected == numThreads * numEach);
+   }  // teardown
+
+   /****************************************************************
+    * Verify Standard List
+    *        pHead             pTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardListParameters(custom::list<int>& l, int line, const char* function)
+   {
+      assertIndirect(l.size() == 3);
+      custom::list<int>::iterator it = l.begin();
+      int expected[] = { 11, 26, 31 };
+      for (int i = 0; i < 3 && it != l.end(); i++, ++it)
+         assertIndirect(*it == expected[i]);
+      it = l.rbegin();
+      for (int i = 2; i >= 0 && it != l.end(); i--, --it)
+         assertIndirect(*it == expected[i]);
+   }
+};
+
+#endif // DEBUG
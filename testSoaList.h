@@ -0,0 +1,322 @@
+/***********************************************************************
+ * Header:
+ *    TEST SOA LIST
+ * Summary:
+ *    Unit tests for soa_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "soaList.h"
+#include "unitTest.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+class TestSoaList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_pushBack_one();
+      test_pushFront_order();
+      test_insert_middle();
+
+      // Access
+      test_iterate_listOrder();
+      test_iterate_backward();
+      test_reference_get();
+      test_reference_tuple();
+      test_column_scan();
+
+      // Remove
+      test_erase_middle();
+      test_erase_nextWasLast();
+      test_erase_lastSlot();
+      test_pop_toEmpty();
+      test_clear();
+
+      report("SoaList");
+   }
+
+   // an id, a weight, and a name
+   typedef custom::soa_list<int, double, std::string> Records;
+
+   // the ids, walking in list order
+   static std::vector<int> ids(Records& l)
+   {
+      std::vector<int> v;
+      for (Records::iterator it = l.begin(); it != l.end(); ++it)
+         v.push_back((*it).get<0>());
+      return v;
+   }
+
+   // the links agree with each other, and every column is the same length
+   static bool consistent(Records& l)
+   {
+      size_t n = l.size();
+      if (std::get<1>(l.columns).size() != n || std::get<2>(l.columns).size() != n ||
+          l.vPrev.size() != n)
+         return false;
+      size_t count = 0;
+      size_t prev = Records::npos;
+      for (size_t slot = l.head; slot != Records::npos; slot = l.vNext[slot])
+      {
+         if (l.vPrev[slot] != prev || ++count > n)
+            return false;
+         prev = slot;
+      }
+      return count == n && l.tail == prev;
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing in any column
+   void test_construct_default()
+   {  // exercise
+      Records l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.head == Records::npos);
+      assertUnit(l.tail == Records::npos);
+      assertUnit(l.begin() == l.end());
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // one record, one slot in every column
+   void test_pushBack_one()
+   {  // setup
+      Records l;
+      // exercise
+      l.push_back(11, 1.5, "eleven");
+      // verify
+      assertUnit(l.size() == 1);
+      assertUnit(l.column<0>()[0] == 11);
+      assertUnit(l.column<1>()[0] == 1.5);
+      assertUnit(l.column<2>()[0] == "eleven");
+      assertUnit(l.head == 0 && l.tail == 0);
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // storage order is append order, list order is what the links say
+   void test_pushFront_order()
+   {  // setup
+      Records l;
+      // exercise
+      l.push_front(31, 3.0, "c");
+      l.push_front(26, 2.0, "b");
+      l.push_front(11, 1.0, "a");
+      // verify
+      assertUnit(l.column<0>()[0] == 31);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(l.front().get<2>() == "a");
+      assertUnit(l.back().get<2>() == "c");
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // insert before an iterator
+   void test_insert_middle()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(31, 3.0, "c");
+      Records::iterator it = l.begin();
+      ++it;
+      // exercise
+      Records::iterator itNew = l.insert(it, 26, 2.0, "b");
+      // verify
+      assertUnit((*itNew).get<0>() == 26);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // the iterators follow the links, not the slots
+   void test_iterate_listOrder()
+   {  // setup
+      Records l;
+      l.push_back(26, 2.0, "b");
+      l.push_front(11, 1.0, "a");
+      l.push_back(31, 3.0, "c");
+      // exercise
+      std::vector<int> v = ids(l);
+      // verify
+      assertUnit(v == std::vector<int>({ 11, 26, 31 }));
+   }  // teardown
+
+   // backing up from end() lands on the last record
+   void test_iterate_backward()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(26, 2.0, "b");
+      l.push_back(31, 3.0, "c");
+      Records::iterator it = l.end();
+      // exercise
+      --it;
+      int last = (*it).get<0>();
+      --it;
+      int middle = (*it).get<0>();
+      // verify
+      assertUnit(last == 31);
+      assertUnit(middle == 26);
+   }  // teardown
+
+   // a field reached through the proxy can be changed in place
+   void test_reference_get()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      // exercise
+      (*l.begin()).get<1>() *= 4.0;
+      l.front().get<2>() += "!";
+      // verify
+      assertUnit(l.column<1>()[0] == 4.0);
+      assertUnit(l.column<2>()[0] == "a!");
+   }  // teardown
+
+   // a whole record in and out as a tuple
+   void test_reference_tuple()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      // exercise
+      l.front() = std::make_tuple(99, 9.5, std::string("z"));
+      Records::value_type t = l.front();
+      // verify
+      assertUnit(std::get<0>(t) == 99);
+      assertUnit(std::get<1>(t) == 9.5);
+      assertUnit(std::get<2>(t) == "z");
+   }  // teardown
+
+   // one column is a plain array of size() items
+   void test_column_scan()
+   {  // setup
+      Records l;
+      for (int i = 1; i <= 100; i++)
+         l.push_front(i, i * 0.5, "");
+      // exercise
+      const double* weights = l.column<1>();
+      double sum = 0.0;
+      for (size_t i = 0; i < l.size(); i++)
+         sum += weights[i];
+      // verify
+      assertUnit(sum == 0.5 * 5050);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // the last slot moves into the hole and the order survives
+   void test_erase_middle()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(99, 9.0, "x");
+      l.push_back(26, 2.0, "b");
+      l.push_back(31, 3.0, "c");
+      Records::iterator it = l.begin();
+      ++it;
+      // exercise
+      Records::iterator itNext = l.erase(it);
+      // verify
+      assertUnit((*itNext).get<0>() == 26);
+      assertUnit(l.size() == 3);
+      assertUnit(l.column<0>()[1] == 31);
+      assertUnit(l.column<2>()[1] == "c");
+      assertUnit(ids(l) == std::vector<int>({ 11, 26, 31 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // the record after the erased one was the one moved
+   void test_erase_nextWasLast()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(99, 9.0, "x");
+      l.push_back(26, 2.0, "b");
+      Records::iterator it = l.begin();
+      ++it;
+      // exercise
+      Records::iterator itNext = l.erase(it);
+      // verify
+      assertUnit(itNext != l.end());
+      assertUnit((*itNext).get<0>() == 26);
+      assertUnit(ids(l) == std::vector<int>({ 11, 26 }));
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // erasing what is already in the last slot moves nothing
+   void test_erase_lastSlot()
+   {  // setup
+      Records l;
+      l.push_back(26, 2.0, "b");
+      l.push_front(11, 1.0, "a");
+      // exercise
+      Records::iterator itNext = l.erase(l.begin());
+      // verify
+      assertUnit((*itNext).get<0>() == 26);
+      assertUnit(l.size() == 1);
+      assertUnit(l.head == 0 && l.tail == 0);
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // popping both ends down to nothing
+   void test_pop_toEmpty()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(26, 2.0, "b");
+      l.push_back(31, 3.0, "c");
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      bool one = ids(l) == std::vector<int>({ 26 });
+      l.pop_back();
+      l.pop_front();
+      // verify
+      assertUnit(one);
+      assertUnit(l.empty());
+      assertUnit(l.head == Records::npos && l.tail == Records::npos);
+      assertUnit(consistent(l));
+   }  // teardown
+
+   // clear empties every column
+   void test_clear()
+   {  // setup
+      Records l;
+      l.push_back(11, 1.0, "a");
+      l.push_back(26, 2.0, "b");
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(std::get<2>(l.columns).empty());
+      assertUnit(l.begin() == l.end());
+      l.push_back(31, 3.0, "c");
+      assertUnit(ids(l) == std::vector<int>({ 31 }));
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,651 @@
+/***********************************************************************
+ * Header:
+ *    TEST STATIC LIST
+ * Summary:
+ *    Unit tests for static_list
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "staticList.h"
+#include "unitTest.h"
+
+#include <string>
+
+class TestStaticList : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeThreeFill();
+      test_construct_tooBig();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructInit_standard();
+      test_constructRange_standard();
+
+      // Assign
+      test_assign_standardToEmpty();
+      test_assignInit_tooBig();
+      test_swap_standardToEmpty();
+
+      // Iterator
+      test_iterator_walk();
+      test_iterator_decrement_end();
+      test_iterator_dereference_update();
+
+      // Access
+      test_front_empty();
+      test_front_standardRead();
+      test_back_standardWrite();
+
+      // Insert
+      test_pushback_empty();
+      test_pushback_standard();
+      test_pushback_full();
+      test_pushfront_standard();
+      test_insert_standardMiddle();
+      test_insert_full();
+      test_insert_throwKeepsSlot();
+
+      // Remove
+      test_clear_standard();
+      test_popback_standard();
+      test_popfront_single();
+      test_erase_empty();
+      test_erase_standardMiddle();
+      test_erase_reuseSlot();
+
+      // Status
+      test_size_three();
+      test_full_full();
+
+      report("StaticList");
+   }
+
+   typedef custom::static_list<int, 4> List;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // exercise
+      List l;
+      // verify
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // construct with a size of three and fill
+   void test_construct_sizeThreeFill()
+   {  // exercise
+      List l(size_t(3), int(99));
+      // verify
+      //    +----+   +----+   +----+
+      //    | 99 | - | 99 | - | 99 |
+      //    +----+   +----+   +----+
+      assertUnit(l.numElements == 3);
+      assertUnit(l.iHead == 0);
+      assertUnit(l.iTail == 2);
+      if (l.iHead == 0 && l.iTail == 2)
+      {
+         assertUnit(l.nodes[0].data == 99);
+         assertUnit(l.nodes[1].data == 99);
+         assertUnit(l.nodes[2].data == 99);
+         assertUnit(l.nodes[2].iNext == List::npos);
+      }
+   }  // teardown
+
+   // asking for more than the capacity throws
+   void test_construct_tooBig()
+   {  // exercise
+      try
+      {
+         List l(size_t(5));
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: static_list capacity exceeded") ==
+                    std::string(sError));
+      }
+   }  // teardown
+
+   // copy constructor of a 3-element collection
+   void test_constructCopy_standard()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      // exercise
+      List lDest(lSrc);
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // move constructor of a 3-element collection
+   void test_constructMove_standard()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      // exercise
+      List lDest(std::move(lSrc));
+      // verify
+      assertEmptyFixture(lSrc);
+      assertStandardFixture(lDest);
+   }  // teardown
+
+   // use the initialization list to create the standard fixture
+   void test_constructInit_standard()
+   {  // exercise
+      List l{ int(11), int(26), int(31) };
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   // use a range to create the standard fixture
+   void test_constructRange_standard()
+   {  // setup
+      std::initializer_list<int> il{ int(11), int(26), int(31) };
+      // exercise
+      List l(il.begin(), il.end());
+      // verify
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // From the standard to fixture to an empty list
+   void test_assign_standardToEmpty()
+   {  // setup
+      List lSrc;
+      setupStandardFixture(lSrc);
+      List lDes;
+      // exercise
+      lDes = lSrc;
+      // verify
+      assertStandardFixture(lSrc);
+      assertStandardFixture(lDes);
+   }  // teardown
+
+   // assigning too many values throws and leaves the list alone
+   void test_assignInit_tooBig()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      try
+      {
+         l = { 1, 2, 3, 4, 5 };
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: static_list capacity exceeded") ==
+                    std::string(sError));
+      }
+      assertStandardFixture(l);
+   }  // teardown
+
+   // swap the standard fixture with an empty list
+   void test_swap_standardToEmpty()
+   {  // setup
+      List lLeft;
+      setupStandardFixture(lLeft);
+      List lRight;
+      // exercise
+      lLeft.swap(lRight);
+      // verify
+      assertEmptyFixture(lLeft);
+      assertStandardFixture(lRight);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // walk from begin() to end()
+   void test_iterator_walk()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      int sum = 0;
+      int count = 0;
+      // exercise
+      for (List::iterator it = l.begin(); it != l.end(); it++)
+      {
+         sum += *it;
+         count++;
+      }
+      // verify
+      assertUnit(count == 3);
+      assertUnit(sum == 11 + 26 + 31);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // decrementing end() lands on the tail
+   void test_iterator_decrement_end()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it = l.end();
+      // exercise
+      --it;
+      // verify
+      assertUnit(it.i == l.iTail);
+      assertUnit(*it == 31);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // update the value through the iterator
+   void test_iterator_dereference_update()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it = l.begin();
+      ++it;
+      // exercise
+      *it = 99;
+      // verify
+      assertUnit(l.nodes[1].data == 99);
+      l.nodes[1].data = 26;
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * FRONT and BACK
+    ***************************************/
+
+   // attempt to access the front of an empty list
+   void test_front_empty()
+   {  // setup
+      List l;
+      // exercise
+      try
+      {
+         l.front();
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: unable to access data from an empty list") ==
+                    std::string(sError));
+      }
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // read the element off the front of the standard list
+   void test_front_standardRead()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      int value = l.front();
+      // verify
+      assertUnit(value == 11);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // write the element on the back of the standard list
+   void test_back_standardWrite()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.back() = 99;
+      // verify
+      assertUnit(l.nodes[2].data == 99);
+      l.nodes[2].data = 31;
+      assertStandardFixture(l);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push onto an empty list
+   void test_pushback_empty()
+   {  // setup
+      List l;
+      // exercise
+      l.push_back(99);
+      // verify
+      assertUnit(l.numElements == 1);
+      assertUnit(l.iHead == 0);
+      assertUnit(l.iTail == 0);
+      assertUnit(l.nodes[0].data == 99);
+      assertUnit(l.nodes[0].iNext == List::npos);
+      assertUnit(l.nodes[0].iPrev == List::npos);
+   }  // teardown
+
+   // push onto the standard fixture
+   void test_pushback_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.push_back(99);
+      // verify
+      assertUnit(l.numElements == 4);
+      assertUnit(l.iTail == 3);
+      assertUnit(l.nodes[3].data == 99);
+      assertUnit(l.nodes[3].iPrev == 2);
+      assertUnit(l.nodes[2].iNext == 3);
+   }  // teardown
+
+   // push onto a full list throws and leaves the list alone
+   void test_pushback_full()
+   {  // setup
+      List l{ 1, 2, 3, 4 };
+      // exercise
+      try
+      {
+         l.push_back(5);
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: static_list capacity exceeded") ==
+                    std::string(sError));
+      }
+      assertUnit(l.numElements == 4);
+      assertUnit(l.back() == 4);
+   }  // teardown
+
+   // push onto the front of the standard fixture
+   void test_pushfront_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.push_front(99);
+      // verify
+      assertUnit(l.numElements == 4);
+      assertUnit(l.iHead == 3);
+      assertUnit(l.nodes[3].data == 99);
+      assertUnit(l.nodes[3].iNext == 0);
+      assertUnit(l.nodes[0].iPrev == 3);
+   }  // teardown
+
+   // insert into the middle of the standard fixture
+   void test_insert_standardMiddle()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it = l.begin();
+      ++it;
+      // exercise
+      List::iterator itNew = l.insert(it, 99);
+      // verify
+      assertUnit(itNew.i == 3);
+      assertUnit(l.nodes[0].iNext == 3);
+      assertUnit(l.nodes[3].iPrev == 0);
+      assertUnit(l.nodes[3].iNext == 1);
+      assertUnit(l.nodes[1].iPrev == 3);
+      assertUnit(l.numElements == 4);
+   }  // teardown
+
+   // insert into a full list throws and leaves the list alone
+   void test_insert_full()
+   {  // setup
+      List l{ 1, 2, 3, 4 };
+      // exercise
+      try
+      {
+         l.insert(l.begin(), 5);
+         assertUnit(false);
+      }
+      catch (const char* sError)
+      {
+         // verify
+         assertUnit(std::string("ERROR: static_list capacity exceeded") ==
+                    std::string(sError));
+      }
+      assertUnit(l.numElements == 4);
+      assertUnit(l.front() == 1);
+   }  // teardown
+
+   // throws while copyOK is false
+   struct Fragile
+   {
+      Fragile(int value) : value(value) {}
+      Fragile(const Fragile& rhs) : value(rhs.value)
+      {
+         if (!copyOK())
+            throw "ERROR: copy failed";
+      }
+      static bool& copyOK() { static bool ok = true; return ok; }
+      int value;
+   };
+
+   // an item that throws while being copied does not cost a slot
+   void test_insert_throwKeepsSlot()
+   {  // setup
+      custom::static_list<Fragile, 2> l;
+      l.push_back(Fragile(11));
+      Fragile item(26);
+      const char* error = nullptr;
+      // exercise
+      Fragile::copyOK() = false;
+      try
+      {
+         l.push_back(item);
+      }
+      catch (const char* e)
+      {
+         error = e;
+      }
+      Fragile::copyOK() = true;
+      l.push_back(item);
+      // verify
+      assertUnit(error != nullptr);
+      assertUnit(l.size() == 2);
+      assertUnit(l.full());
+      assertUnit(l.back().value == 26);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // clear the standard fixture
+   void test_clear_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.clear();
+      // verify
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // remove the last element
+   void test_popback_standard()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      l.pop_back();
+      // verify
+      assertUnit(l.numElements == 2);
+      assertUnit(l.iTail == 1);
+      assertUnit(l.nodes[1].iNext == List::npos);
+      assertUnit(l.iFree == 2);
+   }  // teardown
+
+   // remove the only element
+   void test_popfront_single()
+   {  // setup
+      List l{ 99 };
+      // exercise
+      l.pop_front();
+      // verify
+      assertUnit(l.numElements == 0);
+      assertUnit(l.iHead == List::npos);
+      assertUnit(l.iTail == List::npos);
+   }  // teardown
+
+   // erase from an empty list
+   void test_erase_empty()
+   {  // setup
+      List l;
+      // exercise
+      List::iterator it = l.erase(l.end());
+      // verify
+      assertUnit(it == l.end());
+      assertEmptyFixture(l);
+   }  // teardown
+
+   // erase from the middle of the standard fixture
+   void test_erase_standardMiddle()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it = l.begin();
+      ++it;
+      // exercise
+      List::iterator itReturn = l.erase(it);
+      // verify
+      assertUnit(itReturn.i == 2);
+      assertUnit(l.nodes[0].iNext == 2);
+      assertUnit(l.nodes[2].iPrev == 0);
+      assertUnit(l.numElements == 2);
+   }  // teardown
+
+   // an erased slot is the next one handed out
+   void test_erase_reuseSlot()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      List::iterator it = l.begin();
+      ++it;
+      l.erase(it);
+      // exercise
+      List::iterator itNew = l.insert(l.end(), 26);
+      // verify
+      assertUnit(itNew.i == 1);
+      assertUnit(l.iFree == List::npos);
+      assertUnit(l.iUnused == 3);
+   }  // teardown
+
+   /***************************************
+    * STATUS
+    ***************************************/
+
+   // size of the standard fixture
+   void test_size_three()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      size_t size = l.size();
+      // verify
+      assertUnit(size == 3);
+      assertUnit(List::capacity() == 4);
+      assertStandardFixture(l);
+   }  // teardown
+
+   // full only when every slot is in use
+   void test_full_full()
+   {  // setup
+      List l;
+      setupStandardFixture(l);
+      // exercise
+      bool before = l.full();
+      l.push_back(99);
+      bool after = l.full();
+      // verify
+      assertUnit(before == false);
+      assertUnit(after == true);
+   }  // teardown
+
+   /****************************************************************
+    * Setup Standard Fixture
+    *        iHead             iTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    *        [0]      [1]      [2]
+    ****************************************************************/
+   void setupStandardFixture(List& l)
+   {
+      l.clear();
+      l.nodes[0].data = 11;
+      l.nodes[1].data = 26;
+      l.nodes[2].data = 31;
+
+      // hook up indices
+      l.nodes[0].iPrev = List::npos;
+      l.nodes[0].iNext = 1;
+      l.nodes[1].iPrev = 0;
+      l.nodes[1].iNext = 2;
+      l.nodes[2].iPrev = 1;
+      l.nodes[2].iNext = List::npos;
+
+      // set up the list
+      l.iHead = 0;
+      l.iTail = 2;
+      l.iUnused = 3;
+      l.numElements = 3;
+   }
+
+   /****************************************************************
+    * Verify Empty Fixture
+    ****************************************************************/
+   void assertEmptyFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.numElements == 0);
+      assertIndirect(l.iHead == List::npos);
+      assertIndirect(l.iTail == List::npos);
+   }
+
+   /****************************************************************
+    * Verify Standard Fixture
+    *        iHead             iTail
+    *       +----+   +----+   +----+
+    *       | 11 | - | 26 | - | 31 |
+    *       +----+   +----+   +----+
+    ****************************************************************/
+   void assertStandardFixtureParameters(const List& l, int line, const char* function)
+   {
+      assertIndirect(l.numElements == 3);
+      assertIndirect(l.iHead != List::npos);
+      assertIndirect(l.iTail != List::npos);
+      if (l.iHead == List::npos || l.iTail == List::npos)
+         return;
+
+      size_t i1 = l.iHead;
+      assertIndirect(l.nodes[i1].data == 11);
+      assertIndirect(l.nodes[i1].iPrev == List::npos);
+      size_t i2 = l.nodes[i1].iNext;
+      assertIndirect(i2 != List::npos);
+      if (i2 == List::npos)
+         return;
+      assertIndirect(l.nodes[i2].data == 26);
+      assertIndirect(l.nodes[i2].iPrev == i1);
+      size_t i3 = l.nodes[i2].iNext;
+      assertIndirect(i3 == l.iTail);
+      if (i3 == List::npos)
+         return;
+      assertIndirect(l.nodes[i3].data == 31);
+      assertIndirect(l.nodes[i3].iPrev == i2);
+      assertIndirect(l.nodes[i3].iNext == List::npos);
+   }
+};
+
+#endif // DEBUG
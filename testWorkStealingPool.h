@@ -0,0 +1,296 @@
+/***********************************************************************
+ * Header:
+ *    TEST WORK STEALING POOL
+ * Summary:
+ *    Unit tests for work_stealing_pool
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "workStealingPool.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TestWorkStealingPool : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_zeroThreads();
+
+      // Queues
+      test_owner_lifo();
+      test_steal_half();
+      test_steal_outsider();
+
+      // Run
+      test_submit_waitAll();
+      test_submit_fromTask();
+      test_steal_balances();
+      test_parallelFor_sum();
+      test_parallelFor_nested();
+      test_parallelFor_throws();
+      test_stats_executed();
+
+      report("WorkStealingPool");
+   }
+
+   typedef custom::work_stealing_pool Pool;
+
+   // keep every worker busy until released, so the queues hold still
+   static void occupy(Pool& pool, std::atomic<int>& numBusy, std::atomic<bool>& release)
+   {
+      for (size_t i = 0; i < pool.size(); i++)
+         pool.submit([&numBusy, &release]()
+         {
+            numBusy++;
+            while (!release)
+               std::this_thread::yield();
+         });
+      while (numBusy < (int)pool.size())
+         std::this_thread::yield();
+   }
+
+   // put a task straight on one worker's queue, recording its number
+   static void queue(Pool& pool, size_t i, std::vector<int>& order, int id)
+   {
+      pool.numPending++;
+      pool.numQueued++;
+      pool.vWorkers[i].tasks.push_back([&order, id]() { order.push_back(id); });
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // one worker per core, nothing to do
+   void test_construct_default()
+   {  // exercise
+      Pool pool;
+      // verify
+      assertUnit(pool.size() >= 1);
+      assertUnit(pool.pending() == 0);
+   }  // teardown
+
+   // there is always somebody to do the work
+   void test_construct_zeroThreads()
+   {  // exercise
+      Pool pool(0);
+      // verify
+      assertUnit(pool.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * QUEUES
+    ***************************************/
+
+   // the owner takes its newest task first
+   void test_owner_lifo()
+   {  // setup
+      Pool pool(2);
+      std::atomic<int> numBusy(0);
+      std::atomic<bool> release(false);
+      occupy(pool, numBusy, release);
+      std::vector<int> order;
+      queue(pool, 0, order, 11);
+      queue(pool, 0, order, 26);
+      queue(pool, 0, order, 31);
+      Pool::Task task;
+      // exercise
+      while (pool.takeTask(0, task))
+         pool.execute(0, task);
+      // verify
+      assertUnit(order.size() == 3);
+      assertUnit(order.size() == 3 && order[0] == 31 && order[1] == 26 && order[2] == 11);
+      release = true;
+   }  // teardown
+
+   // a thief takes the oldest half and keeps the rest for itself
+   void test_steal_half()
+   {  // setup
+      Pool pool(2);
+      std::atomic<int> numBusy(0);
+      std::atomic<bool> release(false);
+      occupy(pool, numBusy, release);
+      std::vector<int> order;
+      for (int id = 1; id <= 5; id++)
+         queue(pool, 0, order, id);
+      Pool::Task task;
+      // exercise
+      bool stole = pool.steal(1, task);
+      // verify
+      assertUnit(stole);
+      assertUnit(pool.vWorkers[0].tasks.size() == 2);
+      assertUnit(pool.vWorkers[1].tasks.size() == 2);
+      assertUnit(pool.vWorkers[1].steals == 1);
+      assertUnit(pool.vWorkers[1].stolen == 3);
+      pool.execute(1, task);
+      while (pool.takeTask(1, task))
+         pool.execute(1, task);
+      assertUnit(order.size() == 5);
+      assertUnit(order.size() == 5 && order[0] == 1 && order[1] == 3 && order[2] == 2);
+      while (pool.takeTask(0, task))
+         pool.execute(0, task);
+      release = true;
+   }  // teardown
+
+   // a thread outside the pool takes one task at a time
+   void test_steal_outsider()
+   {  // setup
+      Pool pool(2);
+      std::atomic<int> numBusy(0);
+      std::atomic<bool> release(false);
+      occupy(pool, numBusy, release);
+      std::vector<int> order;
+      queue(pool, 1, order, 11);
+      queue(pool, 1, order, 26);
+      Pool::Task task;
+      // exercise
+      bool stole = pool.takeTask(Pool::npos, task);
+      // verify
+      assertUnit(stole);
+      assertUnit(pool.vWorkers[1].tasks.size() == 1);
+      pool.execute(Pool::npos, task);
+      assertUnit(order.size() == 1 && order[0] == 11);
+      while (pool.takeTask(Pool::npos, task))
+         pool.execute(Pool::npos, task);
+      release = true;
+   }  // teardown
+
+   /***************************************
+    * RUN
+    ***************************************/
+
+   // everything submitted runs before wait_all returns
+   void test_submit_waitAll()
+   {  // setup
+      Pool pool(4);
+      std::atomic<int> count(0);
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         pool.submit([&count]() { count++; });
+      pool.wait_all();
+      // verify
+      assertUnit(count == 1000);
+      assertUnit(pool.pending() == 0);
+   }  // teardown
+
+   // tasks can submit more tasks, and wait_all waits for those too
+   void test_submit_fromTask()
+   {  // setup
+      Pool pool(4);
+      std::atomic<int> count(0);
+      // exercise
+      pool.submit([&pool, &count]()
+      {
+         for (int i = 0; i < 100; i++)
+            pool.submit([&count]() { count++; });
+      });
+      pool.wait_all();
+      // verify
+      assertUnit(count == 100);
+   }  // teardown
+
+   // work made by one worker gets spread to the idle ones
+   void test_steal_balances()
+   {  // setup
+      Pool pool(4);
+      // exercise
+      pool.submit([&pool]()
+      {
+         for (int i = 0; i < 64; i++)
+            pool.submit([]() { std::this_thread::sleep_for(std::chrono::microseconds(500)); });
+      });
+      pool.wait_all();
+      // verify
+      Pool::stats s = pool.total_stats();
+      assertUnit(s.executed == 65);
+      assertUnit(s.steals > 0);
+      assertUnit(s.stolen >= s.steals);
+   }  // teardown
+
+   // every index is visited exactly once
+   void test_parallelFor_sum()
+   {  // setup
+      Pool pool(4);
+      std::vector<int> visits(10000, 0);
+      // exercise
+      pool.parallel_for(0, visits.size(), [&visits](size_t i) { visits[i]++; });
+      // verify
+      bool once = true;
+      for (int v : visits)
+         once = once && v == 1;
+      assertUnit(once);
+      assertUnit(pool.pending() == 0);
+   }  // teardown
+
+   // a parallel_for inside a task helps instead of waiting on itself
+   void test_parallelFor_nested()
+   {  // setup
+      Pool pool(2);
+      std::atomic<long long> sum(0);
+      // exercise
+      pool.parallel_for(0, 4, [&pool, &sum](size_t)
+      {
+         pool.parallel_for(1, 101, [&sum](size_t j) { sum += j; }, 10);
+      }, 1);
+      // verify
+      assertUnit(sum == 4 * 5050);
+   }  // teardown
+
+   // an exception comes back to the caller
+   void test_parallelFor_throws()
+   {  // setup
+      Pool pool(2);
+      std::string message;
+      // exercise
+      try
+      {
+         pool.parallel_for(0, 100, [](size_t i)
+         {
+            if (i == 50)
+               throw "ERROR: fifty";
+         });
+      }
+      catch (const char* error)
+      {
+         message = error;
+      }
+      // verify
+      assertUnit(message == "ERROR: fifty");
+      assertUnit(pool.pending() == 0);
+   }  // teardown
+
+   // the counters add up
+   void test_stats_executed()
+   {  // setup
+      Pool pool(3);
+      // exercise
+      for (int i = 0; i < 30; i++)
+         pool.submit([]() {});
+      pool.wait_all();
+      // verify
+      Pool::stats s = pool.total_stats();
+      assertUnit(s.executed == 30);
+      assertUnit(s.utilization >= 0.0 && s.utilization <= 1.0);
+      size_t sum = 0;
+      for (size_t i = 0; i < pool.size(); i++)
+         sum += pool.worker_stats(i).executed;
+      assertUnit(sum == 30);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,438 @@
+/***********************************************************************
+ * Header:
+ *    WORK STEALING POOL
+ * Summary:
+ *    A small in-process task executor.  Every worker owns a queue that
+ *    is simply a custom::list of tasks.  The owner pushes and pops at
+ *    the back (last in, first out), so the tasks it just made, and the
+ *    data they touch, are still warm in its cache.  A worker with
+ *    nothing to do steals from the front of somebody else's queue, and
+ *    takes half of it at once: split_front() cuts the chain and
+ *    splice() hooks it onto the thief's list, with no copying.
+ *
+ *    Each queue has its own lock.  The owner is normally the only one
+ *    taking it, so it is rarely contended.
+ *
+ *    This will contain the class definition of:
+ *        work_stealing_pool : Workers, their queues, and their counters
+ * Author
+ *    Michael Johnson, Brayden Jones, James Gassaway
+ ************************************************************************/
+
+#pragma once
+#include "list.h"
+#include <algorithm>           // for std::min
+#include <atomic>              // for std::atomic
+#include <chrono>              // for std::chrono::steady_clock
+#include <condition_variable>  // for std::condition_variable
+#include <exception>           // for std::exception_ptr
+#include <functional>          // for std::function
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include <utility>
+#include <vector>              // for std::vector
+
+class TestWorkStealingPool;    // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * WORK STEALING POOL
+     * submit() from anywhere, wait_all() from outside the pool
+     **************************************************/
+    class work_stealing_pool
+    {
+        friend class ::TestWorkStealingPool; // give unit tests access to the privates
+    public:
+        typedef std::function<void()> Task;
+
+        // what one worker has been up to
+        struct stats
+        {
+            size_t executed;     // tasks run
+            size_t steals;       // successful raids on other queues
+            size_t stolen;       // tasks taken in those raids
+            double utilization;  // fraction of its life spent running tasks
+        };
+
+        //
+        // Construct
+        //
+
+        work_stealing_pool(size_t numThreads = std::thread::hardware_concurrency());
+        work_stealing_pool(const work_stealing_pool& rhs) = delete;
+        work_stealing_pool& operator = (const work_stealing_pool& rhs) = delete;
+        ~work_stealing_pool();
+
+        //
+        // Run
+        //
+
+        void submit(Task task);
+        void wait_all();
+        template <class Function>
+        void parallel_for(size_t first, size_t last, Function f, size_t grain = 0);
+
+        //
+        // Status
+        //
+
+        size_t size() const { return vWorkers.size(); }
+        size_t pending() const { return numPending.load(); }
+        stats worker_stats(size_t i) const;
+        stats total_stats() const;
+
+    private:
+        // one worker's queue and counters, padded off its neighbors' lines
+        struct Worker
+        {
+            std::mutex lock;                         // guards tasks
+            list <Task> tasks;                       // owner at the back, thieves at the front
+            std::atomic<size_t> executed{ 0 };
+            std::atomic<size_t> steals{ 0 };
+            std::atomic<size_t> stolen{ 0 };
+            std::atomic<long long> busyNanos{ 0 };   // time spent inside tasks
+            char padding[64];
+        };
+
+        // not a worker: the thread is outside the pool
+        static const size_t npos = (size_t)-1;
+
+        size_t currentWorker() const;
+        bool takeTask(size_t self, Task& task);
+        bool steal(size_t self, Task& task);
+        void execute(size_t self, Task& task);
+        void work(size_t self);
+
+        // member variables
+        std::vector<Worker> vWorkers;
+        std::vector<std::thread> threads;
+        std::atomic<size_t> numQueued;         // sitting in some queue
+        std::atomic<size_t> numPending;        // queued or running
+        std::atomic<size_t> nextWorker;        // round robin for outside submits
+        std::mutex lockSleep;                  // guards the two condition variables
+        std::condition_variable wakeup;        // a task was queued, or stop
+        std::condition_variable allDone;       // numPending reached zero
+        bool stopping;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    /*****************************************
+     * WORK STEALING POOL :: CURRENT WORKER
+     * Which of our workers is this thread, if any
+     ****************************************/
+    namespace detail
+    {
+        struct current_worker
+        {
+            const work_stealing_pool* pPool;
+            size_t index;
+        };
+        inline current_worker& currentWorker()
+        {
+            static thread_local current_worker w{ nullptr, 0 };
+            return w;
+        }
+    }
+
+    inline size_t work_stealing_pool::currentWorker() const
+    {
+        const detail::current_worker& w = detail::currentWorker();
+        return w.pPool == this ? w.index : npos;
+    }
+
+    /*****************************************
+     * WORK STEALING POOL :: CONSTRUCTOR
+     * Start the workers
+     ****************************************/
+    inline work_stealing_pool::work_stealing_pool(size_t numThreads) :
+        vWorkers(numThreads ? numThreads : 1), numQueued(0), numPending(0),
+        nextWorker(0), stopping(false), started(std::chrono::steady_clock::now())
+    {
+        for (size_t i = 0; i < vWorkers.size(); i++)
+            threads.emplace_back([this, i]() { work(i); });
+    }
+
+    /*****************************************
+     * WORK STEALING POOL :: DESTRUCTOR
+     * Everything submitted runs before the workers stop
+     ****************************************/
+    inline work_stealing_pool::~work_stealing_pool()
+    {
+        wait_all();
+        {
+            std::lock_guard<std::mutex> lock(lockSleep);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto& th : threads)
+            th.join();
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: SUBMIT
+     * queue a task.  A worker puts it on the back of its
+     * own queue; anybody else spreads them round robin
+     *    INPUT  : the task
+     *    OUTPUT :
+     *    COST   : O(1)
+     *********************************************/
+    inline void work_stealing_pool::submit(Task task)
+    {
+        size_t i = currentWorker();
+        if (i == npos)
+            i = nextWorker.fetch_add(1, std::memory_order_relaxed) % vWorkers.size();
+
+        numPending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(vWorkers[i].lock);
+            vWorkers[i].tasks.push_back(std::move(task));
+        }
+        numQueued.fetch_add(1);
+
+        // taking the lock means a worker about to sleep has either seen
+        // numQueued go up or is already waiting for this notify
+        {
+            std::lock_guard<std::mutex> lock(lockSleep);
+        }
+        wakeup.notify_one();
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: WAIT ALL
+     * block until every task submitted so far, and every
+     * task those submitted, has finished.  Not for use on
+     * a worker thread, which would be waiting on itself
+     *    INPUT  :
+     *    OUTPUT :
+     *    COST   : however long the tasks take
+     *********************************************/
+    inline void work_stealing_pool::wait_all()
+    {
+        assert(currentWorker() == npos);
+        std::unique_lock<std::mutex> lock(lockSleep);
+        allDone.wait(lock, [this]() { return numPending.load() == 0; });
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: TAKE TASK
+     * the owner's newest task, or failing that a stolen one
+     *    INPUT  : which worker is asking, npos if outside
+     *    OUTPUT : the task, false if there was nothing to run
+     *    COST   : O(1) for the owner, O(n) to steal
+     *********************************************/
+    inline bool work_stealing_pool::takeTask(size_t self, Task& task)
+    {
+        if (self != npos)
+        {
+            Worker& w = vWorkers[self];
+            std::lock_guard<std::mutex> lock(w.lock);
+            if (!w.tasks.empty())
+            {
+                task = std::move(w.tasks.back());
+                w.tasks.pop_back();
+                numQueued.fetch_sub(1);
+                return true;
+            }
+        }
+        return steal(self, task);
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: STEAL
+     * raid the other queues, oldest tasks first.  A worker
+     * takes half the victim's queue: one to run now and the
+     * rest spliced onto its own.  A thread from outside the
+     * pool has no queue, so it only takes one
+     *    INPUT  : which worker is stealing, npos if outside
+     *    OUTPUT : the task, false if every queue was empty
+     *    COST   : O(number of workers + half the victim's queue)
+     *********************************************/
+    inline bool work_stealing_pool::steal(size_t self, Task& task)
+    {
+        size_t numWorkers = vWorkers.size();
+        size_t start = (self == npos) ? 0 : self + 1;
+        for (size_t k = 0; k < numWorkers; k++)
+        {
+            size_t victim = (start + k) % numWorkers;
+            if (victim == self)
+                continue;
+
+            list <Task> loot;
+            {
+                Worker& v = vWorkers[victim];
+                std::lock_guard<std::mutex> lock(v.lock);
+                if (v.tasks.empty())
+                    continue;
+                size_t num = (self == npos) ? 1 : (v.tasks.size() + 1) / 2;
+                loot = v.tasks.split_front(num);
+            }
+
+            numQueued.fetch_sub(1);
+            if (self != npos)
+            {
+                vWorkers[self].steals.fetch_add(1, std::memory_order_relaxed);
+                vWorkers[self].stolen.fetch_add(loot.size(), std::memory_order_relaxed);
+            }
+
+            task = std::move(loot.front());
+            loot.pop_front();
+            if (!loot.empty())
+            {
+                std::lock_guard<std::mutex> lock(vWorkers[self].lock);
+                vWorkers[self].tasks.splice(vWorkers[self].tasks.end(), loot);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: EXECUTE
+     * run one task, keep the books, and wake wait_all()
+     * if that was the last one
+     *    INPUT  : which worker is running it, the task
+     *    OUTPUT :
+     *    COST   : the task
+     *********************************************/
+    inline void work_stealing_pool::execute(size_t self, Task& task)
+    {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        task();
+        task = nullptr;
+        if (self != npos)
+        {
+            Worker& w = vWorkers[self];
+            w.busyNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count(), std::memory_order_relaxed);
+            w.executed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (numPending.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(lockSleep);
+            allDone.notify_all();
+        }
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: WORK
+     * a worker's life: run what we can find, sleep when
+     * there is nothing anywhere
+     *    INPUT  : which worker this is
+     *    OUTPUT :
+     *    COST   :
+     *********************************************/
+    inline void work_stealing_pool::work(size_t self)
+    {
+        detail::currentWorker() = detail::current_worker{ this, self };
+        for (;;)
+        {
+            Task task;
+            if (takeTask(self, task))
+            {
+                execute(self, task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(lockSleep);
+            wakeup.wait(lock, [this]() { return stopping || numQueued.load() != 0; });
+            if (stopping && numQueued.load() == 0)
+                return;
+        }
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: PARALLEL FOR
+     * call f(i) for every i in [first, last), in chunks of
+     * grain spread across the pool.  The calling thread
+     * runs tasks too while it waits, so this can be called
+     * from inside a task.  The first exception thrown by f
+     * is thrown again here once every chunk is done
+     *    INPUT  : the range, what to do with each index, the chunk size
+     *    OUTPUT :
+     *    COST   : O(last - first) spread over the workers
+     *********************************************/
+    template <class Function>
+    void work_stealing_pool::parallel_for(size_t first, size_t last, Function f, size_t grain)
+    {
+        if (first >= last)
+            return;
+        if (grain == 0)
+            grain = std::max<size_t>(1, (last - first) / (4 * vWorkers.size()));
+
+        std::atomic<size_t> numLeft((last - first + grain - 1) / grain);
+        std::exception_ptr error;
+        std::mutex lockError;
+
+        for (size_t begin = first; begin < last; begin += grain)
+        {
+            size_t end = std::min(last, begin + grain);
+            submit([&f, &numLeft, &error, &lockError, begin, end]()
+            {
+                try
+                {
+                    for (size_t i = begin; i < end; i++)
+                        f(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(lockError);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                numLeft.fetch_sub(1);
+            });
+        }
+
+        // help rather than block, so a worker never waits on itself
+        size_t self = currentWorker();
+        while (numLeft.load() != 0)
+        {
+            Task task;
+            if (takeTask(self, task))
+                execute(self, task);
+            else
+                std::this_thread::yield();
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    /*********************************************
+     * WORK STEALING POOL :: STATS
+     * the counters for one worker, or all added up
+     *    INPUT  : which worker
+     *    OUTPUT : its counters and utilization
+     *    COST   : O(1), O(number of workers) for the total
+     *********************************************/
+    inline work_stealing_pool::stats work_stealing_pool::worker_stats(size_t i) const
+    {
+        const Worker& w = vWorkers[i];
+        long long alive = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started).count();
+        stats s;
+        s.executed = w.executed.load(std::memory_order_relaxed);
+        s.steals = w.steals.load(std::memory_order_relaxed);
+        s.stolen = w.stolen.load(std::memory_order_relaxed);
+        s.utilization = alive > 0 ? double(w.busyNanos.load(std::memory_order_relaxed)) / alive : 0.0;
+        return s;
+    }
+
+    inline work_stealing_pool::stats work_stealing_pool::total_stats() const
+    {
+        stats sTotal{ 0, 0, 0, 0.0 };
+        for (size_t i = 0; i < vWorkers.size(); i++)
+        {
+            stats s = worker_stats(i);
+            sTotal.executed += s.executed;
+            sTotal.steals += s.steals;
+            sTotal.stolen += s.stolen;
+            sTotal.utilization += s.utilization / vWorkers.size();
+        }
+        return sTotal;
+    }
+
+}; // namespace custom